@@ -0,0 +1,48 @@
+#ifndef COMPRESS_H_
+#define COMPRESS_H_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+Byte-oriented LZ77 block format (Same idea with LZ4 block).
+Every sequence: TOKEN (LLLL|MMMM) | EXT_LITERALS | LITERALS | OFFSET (2 bytes) | EXT_MATCH.
+Match with offset 1 works like RLE, that's why space padding compressed to few bytes.
+Note: Offset stored in 2 bytes, that's why max block size is 64 KB.
+*/
+#define COMPRESS_MIN_MATCH  4
+#define COMPRESS_MAX_OFFSET 0xFFFF
+#define COMPRESS_HASH_BITS  10
+
+/*
+Compress memory block.
+
+Params:
+- src - Source data.
+- l - Source size.
+- dst - Destination for compressed data.
+- capacity - Size of destination.
+
+Return -1 if compressed data don't fit to capacity.
+Return size of compressed data.
+*/
+int compress_memory(const unsigned char* src, int l, unsigned char* dst, int capacity);
+
+/*
+Decompress memory block.
+
+Params:
+- src - Source compressed data.
+- l - Compressed data size.
+- dst - Destination for data.
+- capacity - Size of destination.
+
+Return -1 if compressed data broken or don't fit to capacity.
+Return size of decompressed data.
+*/
+int decompress_memory(const unsigned char* src, int l, unsigned char* dst, int capacity);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -26,6 +26,7 @@
 
 #include <common.h>
 #include <tabman.h>
+#include <indman.h>
 #include <tcache.h>
 #include <nifat32/nifat32.h>
 
@@ -76,6 +77,7 @@ we use cache in pages (lowest level) and table cache at the highest level.
     Get row function return pointer to allocated data. This data don't contain RD symbols.
     Note: This is allocated data, that's why you should free row after use.
     Note 2: Pointers shouldn't overlap each other!
+    Note 3: Row returned in text form (Binary int columns decoded, check TBM_decode_row).
 
     Params:
     - database - Pointer to database. (If NULL, we don`t use database table cache).
@@ -98,11 +100,32 @@ we use cache in pages (lowest level) and table cache at the highest level.
         unsigned char* buffer, size_t buffer_size
     );
 
+    /*
+    Read stored row without decode and modules invoke (Check TBM_encode_row).
+    Binary int columns can be compared without parsing.
+
+    Params:
+    - database - Pointer to database.
+    - table_name - Current table name.
+    - row - Index of row.
+    - buffer - Destination place for stored row.
+    - buffer_size - Size of buffer (table->row_size).
+
+    Return 0 if row not readed.
+    Return 1 if read success.
+    */
+    int DB_read_row(
+        database_t* __restrict database, char* __restrict table_name, int row,
+        unsigned char* buffer, size_t buffer_size
+    );
+
     /*
     Append row function append data to provided table. If table not provided, it will return fail status.
     Note: This function will create new directories and pages, if current pages and directories don't have enoght space.
     Note 2: This function will fail if signature of input data different with provided table.
     Note 3: Pointers shouldn't overlap each other!
+    Note 4: Primary value checked by hash index of primary column. Tables without this index (Old tables) use DB_find_data_row.
+    Note 5: Auto increment columns get next value of table header counter. Values don't repeat after row delete.
 
     Data should have next format:
     DATA_DATA_DATA -> CD -> DATA_DATA_DATA -> ... -> DATA_DATA_DATA.
@@ -116,6 +139,7 @@ we use cache in pages (lowest level) and table cache at the highest level.
     - access - User access level.
 
     Return -20 if primary row check failed.
+    Return -6 if table reach size limit (Check TABLE_MAX_SIZE).
     Return -5 if data size != row size.
     Return -4 if table not found in database.
     Return -3 if access denied.
@@ -132,6 +156,29 @@ we use cache in pages (lowest level) and table cache at the highest level.
     */
     int DB_append_row(database_t* __restrict database, char* __restrict table_name, unsigned char* __restrict data, size_t data_size);
 
+    /*
+    Append rows to table. Batch version of DB_append_row. Table, touched directories and pages
+    loaded and saved once per batch.
+    Note: Batch validated before write. If one row has wrong signature, no rows will be appended.
+    Note 2: Rows with not uniqe primary value (In table or in batch) skipped.
+    Note 3: Data modified in place (Auto increment values, modules, skipped rows).
+    Note 4: Modules invoked once per batch (Check TBM_invoke_modules_rows).
+
+    Params:
+    - database - Pointer to database. (If NULL, we don`t use database table cache).
+    - table_name - Current table name.
+    - data - Text rows for append (Rows placed one by one without separators).
+    - data_size - Size of data. Should be multiple of text row size.
+
+    Return -6 if table reach size limit (Check TABLE_MAX_SIZE).
+    Return -5 if data size not multiple of text row size.
+    Return -4 if table not found in database.
+    Return -1x if signature is wrong (Check DB_append_row).
+    Return -1 if something goes wrong.
+    Return count of appended rows.
+    */
+    int DB_append_rows(database_t* __restrict database, char* __restrict table_name, unsigned char* __restrict data, size_t data_size);
+
     /*
     Insert row function works different with row_append function. Main difference in disabling auto-creation of pages and directories.
     Like in append_row, this function will check data signature, end return error code if it wrong.
@@ -151,7 +198,7 @@ we use cache in pages (lowest level) and table cache at the highest level.
     - data_size - Size of row (No limits).
     - access - User access level.
 
-    Return -3 if access denied
+    Return -3 if row outside of table pages
     Return -2 if signature is wrong: {
         Return -14 if column type unknown. Check table, that you provide into function.
         Return -13 if signature is wrong. You provide value for FLOAT column, but value is not float.
@@ -183,9 +230,40 @@ we use cache in pages (lowest level) and table cache at the highest level.
     */
     int DB_delete_row(database_t* __restrict database, char* __restrict table_name, int row);
 
+    /*
+    Create B+tree index for table column (Check indman.h). Index filled with existed rows
+    and updated by append, insert and delete functions.
+    Note: Module columns can't be indexed.
+    Note 2: Column with index (Primary hash index, B+tree or Bloom filter) keeps it.
+
+    Params:
+    - database - Pointer to database.
+    - table_name - Table name.
+    - column_name - Column name.
+
+    Return -4 if table not found in database.
+    Return -3 if column already has index.
+    Return -2 if column not found.
+    Return -1 if index can't be created.
+    Return 1 if index created.
+    */
+    int DB_create_index(database_t* __restrict database, char* __restrict table_name, char* __restrict column_name);
+
+    /*
+    Rebuild all indexes of table (B+tree and hash). Should be used after operations, that move rows (Cleanup, compaction, migration).
+    Note: Also creates empty indexes of new table.
+
+    Params:
+    - table - Pointer to table.
+
+    Return count of rebuilt indexes.
+    */
+    int DB_rebuild_indexes(table_t* table);
+
     /*
     Init cascade cleanup of empty directories and empty pages in all table in database.
     Note: This function, also, call sync fuinction like init_transaction method.
+    Note 2: Indexes of changed tables will be rebuilt.
 
     Params:
     - database - pointer to database.
@@ -210,14 +288,17 @@ we use cache in pages (lowest level) and table cache at the highest level.
             that't why result of this function can't be used as offset. For working with
             rows, use rows functions.
     Note 4: Pointers shouldn't overlap each other!
+    Note 5: Function search in stored rows. Binary int values should be encoded (Check TBM_encode_row).
+    Note 6: If data has column size and column has Bloom filter, function compare whole column value
+            and skip pages without value (Check TBM_make_bloom_filter).
 
     Params:
     - database - Pointer to database. (If NULL, we don`t use database table cache).
     - table_name - Table name.
     - column - Column name. Provide NULL, if you don't need specified column.
     - offset - Global offset. For simple use, try:
-                DIRECTORY_OFFSET for directory offset,
-                PAGE_CONTENT_SIZE for page offset.
+                DIRECTORY_OFFSET(table->header->page_size) for directory offset,
+                table->header->page_size for page offset.
     - data - Data for search.
     - data_size - Data for search size.
     - access - User access level.
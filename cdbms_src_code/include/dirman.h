@@ -42,17 +42,57 @@
 #define DIRECTORY_BASE_PATH ENV_GET("DIRECTORY_BASE_PATH", ".")
 
 // 62^5 * PAGES_PER_DIRECTORY = 233.613.872.160 maximum pages in database.
-// 62^5 * 4096 = 233.6 * 10^9 KB = MIN(255TB, 211TB) - Maximum size of database.
+// 62^5 * 4096 = 233.6 * 10^9 KB = MIN(255TB, 211TB) - Maximum size of database (With default page size).
 #define DIRECTORY_NAME_SIZE 6
-#define DIRECTORY_MAGIC     0xCC
+#define DIRECTORY_MAGIC     0xCD
+// Directories with first header layout (Default page size, without free space summary, zones and Bloom filters) migrated at load.
+#define DIRECTORY_BASE_MAGIC 0xCC
 
 #define PAGES_PER_DIRECTORY 100
-#define DIRECTORY_OFFSET    PAGES_PER_DIRECTORY * PAGE_CONTENT_SIZE
+// Directory offset depends from page size of directory (Check directory_header_t).
+#define DIRECTORY_OFFSET(page_size) (PAGES_PER_DIRECTORY * (page_size))
+
+// Zone maps. Directory keeps min and max keys of zone columns for every page, that's why
+// scan can skip pages (And whole directory), where rows can't match condition.
+// Zone columns selected by table during directory creation (Check TBM_set_zones).
+#define DIRECTORY_ZONE_COUNT    2
+// Zone column types. Text ints parsed without leading spaces, strings compared
+// by first ZONE_STRING_SIZE bytes without leading spaces (Check DRM_make_zone_key).
+#define ZONE_TYPE_NUMBER        0x00
+#define ZONE_TYPE_INT32         0x01
+#define ZONE_TYPE_INT64         0x02
+#define ZONE_TYPE_STRING        0x03
+#define ZONE_STRING_SIZE        7
+// Keys range of unknown zone
+#define ZONE_KEY_MAX            0x7FFFFFFFFFFFFFFFLL
+#define ZONE_KEY_MIN            (-ZONE_KEY_MAX - 1)
+
+// Bloom filters. Directory keeps Bloom filter of chosen columns for every page, that's why
+// eq / == lookup skips pages, that can't contain value. Filter has 8 bits per page row
+// (DIRECTORY_BLOOM_MIN - DIRECTORY_BLOOM_MAX bytes). Bloom columns use zone types.
+#define DIRECTORY_BLOOM_COUNT   2
+#define DIRECTORY_BLOOM_MIN     8
+#define DIRECTORY_BLOOM_MAX     64
+#define BLOOM_HASH_COUNT        3
 
 // We have *.dr bin file, where at start placed header
-//====================================================================================================================
-// HEADER (MAGIC | NAME | PAGE_COUNT | COLUMN_COUNT) -> | COLUMNS (TYPE | NAME, ... ) | PAGE_NAMES -> 8 * 256 -> end |
-//====================================================================================================================
+//==================================================================================================================================
+// HEADER (MAGIC | NAME | PAGE_COUNT | ... | ZONE_COLUMNS | BLOOM_COLUMNS) -> | PAGE_NAMES -> | PAGE_FREE -> | PAGE_ZONES (MIN | MAX, ... ) ->
+// | PAGE_STALE -> | PAGE_BLOOMS -> end |
+//==================================================================================================================================
+
+    typedef struct {
+        // Column place in stored row and zone type
+        unsigned short offset;
+        unsigned short size;
+        unsigned char type;
+    } __attribute__((packed)) directory_zone_column_t;
+
+    typedef struct {
+        // Keys range of page. Empty page has min larger than max.
+        long long min;
+        long long max;
+    } __attribute__((packed)) directory_zone_t;
 
     typedef struct {
         // Magic namber for check
@@ -65,7 +105,24 @@
         // Page count in directory
         unsigned char page_count;
 
-        // Directory checksum
+        // Layout of new pages in directory (Check PAGE_FLAG_* flags)
+        unsigned char page_flags;
+        unsigned short slot_size;
+
+        // Content size of pages in directory
+        unsigned int page_size;
+
+        // Zone columns of directory. Zones disabled, if zone_count is 0.
+        unsigned char zone_count;
+        directory_zone_column_t zone_columns[DIRECTORY_ZONE_COUNT];
+
+        // Bloom columns of directory and size of one filter in bytes. Filters disabled, if bloom_count is 0.
+        unsigned char bloom_count;
+        unsigned short bloom_size;
+        directory_zone_column_t bloom_columns[DIRECTORY_BLOOM_COUNT];
+
+        // Directory checksum and checksum algorithm (Check checksum.h)
+        unsigned char checksum_type;
         checksum_t checksum;
     } __attribute__((packed)) directory_header_t;
 
@@ -79,8 +136,23 @@
         unsigned char append_offset;
         ci_t dci; // Directory content index for indexing
 
+        // Offset in directory of last appended content (Check DRM_append_content)
+        int last_append;
+
         // Page file names
         char page_names[PAGES_PER_DIRECTORY][PAGE_NAME_SIZE];
+
+        // Largest free block of every page (Check PGM_get_max_free_space).
+        // Updated with page changes, that's why append don't load full pages.
+        unsigned int page_free[PAGES_PER_DIRECTORY];
+
+        // Zone keys of every page. Updated with page_free.
+        directory_zone_t page_zones[PAGES_PER_DIRECTORY][DIRECTORY_ZONE_COUNT];
+
+        // Bloom filters of pages (bloom_count filters for every page, Check DRM_set_blooms).
+        // Delete don't rebuild filter. Page marked as stale and rebuilt at next page change.
+        unsigned char page_stale[PAGES_PER_DIRECTORY];
+        unsigned char* page_blooms;
     } __attribute__((packed)) directory_t;
 
 #pragma region [Pages]
@@ -115,20 +187,43 @@
 
     /*
     Cleanup empty pages in directory.
+    Note: Removed pages and compacted slotted pages change row indexes.
 
     Params:
     - directory - pointer to directory.
 
-    Return 1 if cleanup success.
+    Return count of removed and compacted pages.
     Return -1 if something goes wrong.
     */
     int DRM_cleanup_pages(directory_t* directory);
 
+    /*
+    Merge sparse pages. Rows from last source pages moved to free rows of first destination pages,
+    and emptied source pages deleted (Page names shifted, page files removed).
+    If dst and src is same directory, rows moved inside directory. Otherwise new pages will be created
+    in dst directory, until it full.
+    Note: Row positions will be changed (Same with cleanup). Use it during sync.
+    Note 2: Full destination pages skipped by directory page summary without load.
+
+    Params:
+    - dst - Destination directory.
+    - src - Source directory. Can be same with dst.
+    - row_size - Row size. Rows placed in pages with row size step.
+    - max_pages - Max count of source pages, that will be processed during this call.
+
+    Return -2 if delete command disabled.
+    Return -1 if something goes wrong.
+    Return count of processed source pages.
+    */
+    int DRM_compact_pages(directory_t* dst, directory_t* src, int row_size, int max_pages);
+
     /*
     Append content to directory. This function move page_end symbol to new location.
     Note: If it can't append to existed pages, it creates new one.
     Note 2: This function not guarantees that content will be append to last page.
             Content will be placed at first empty space with fit size.
+    Note 3: Pages without fit free block (Check page_free) skipped without load.
+    Note 4: Offset of appended content saved in directory->last_append.
 
     Params:
     - directory - Pointer to directory.
@@ -144,6 +239,22 @@
     */
     int DRM_append_content(directory_t* __restrict directory, unsigned char* __restrict data, size_t data_lenght);
 
+    /*
+    Append rows to directory. Every touched page loaded and saved once, new pages filled sequentially.
+    Note: Offset of last appended row saved in directory->last_append.
+
+    Params:
+    - directory - Pointer to directory.
+    - data - Rows for append (count * row_size bytes).
+    - row_size - Size of one row.
+    - count - Count of rows.
+    - offsets - Pointer to array for offsets of appended rows in directory (Or NULL).
+
+    Return -2 if we can't create uniqe name for page.
+    Return count of appended rows. Less than count, if we reach page limit in directory.
+    */
+    int DRM_append_rows(directory_t* __restrict directory, unsigned char* __restrict data, int row_size, int count, int* offsets);
+
     /*
     Insert content to directory. This function don't move page_end in first empty page symbol to new location.
     Note: This function don't give ability for creation new pages. If content too large - it will trunc.
@@ -175,12 +286,14 @@
 
     Note 2: For avoiding situations, where function return part of word, add space to target data (Don't forget to encrease size).
     Note 3: Don't use CD and RD symbols in data. (Optionaly). If you want find row, use find row function. <DEPRECATED>
-    Note 4: This function is sungle thread, because we should be sure, that data sequence is correct.
+    Note 4: Pages split between workers (Build with OMP=1). Every worker decode and search own pages,
+            and lowest index returned. Entry, that starts in page tail, checked with next pages.
+    Note 5: Entry should fully fit directory. Entries, that cross directory boundary, checked by TBM_find_content.
 
     Params:
     - directory - pointer to directory.
     - offset - global offset. For simple use, try:
-                PAGE_CONTENT_SIZE for page offset.
+                directory->header->page_size for page offset.
     - data - data for seacrh.
     - data_size - data for search size .
 
@@ -192,6 +305,83 @@
 
 #pragma endregion
 
+#pragma region [Zones]
+
+    /*
+    Make zone key from column data. Number keys parsed from text, binary keys copied,
+    string keys packed from first ZONE_STRING_SIZE bytes (Order of keys same with order of strings).
+
+    Params:
+    - type - Zone type (ZONE_TYPE_*).
+    - data - Column data (Or value from expression).
+    - size - Size of data.
+
+    Return zone key.
+    */
+    long long DRM_make_zone_key(unsigned char type, unsigned char* data, int size);
+
+    /*
+    Get zone of page or whole directory.
+
+    Params:
+    - directory - Pointer to directory.
+    - page - Page index in directory, or -1 for union of all pages.
+    - zone - Zone index (Check directory_header_t zone_columns).
+    - result - Pointer to zone.
+
+    Return -1 if directory don't have this zone.
+    Return 1 if zone returned.
+    */
+    int DRM_get_zone(directory_t* __restrict directory, int page, int zone, directory_zone_t* __restrict result);
+
+#pragma endregion
+
+#pragma region [Bloom]
+
+    /*
+    Make Bloom key from column data. Number keys hashed by value (Text and binary ints with
+    same value have same key), string keys hashed without leading spaces.
+
+    Params:
+    - type - Column zone type (ZONE_TYPE_*).
+    - data - Column data (Or value from expression).
+    - size - Size of data.
+
+    Return Bloom key.
+    */
+    long long DRM_make_bloom_key(unsigned char type, unsigned char* data, int size);
+
+    /*
+    Set Bloom columns of new directory and allocate filters.
+    Note: Call it before first page of directory.
+
+    Params:
+    - directory - Pointer to directory.
+    - columns - Bloom columns.
+    - count - Count of columns (Not more than DIRECTORY_BLOOM_COUNT).
+    - size - Size of one filter in bytes.
+
+    Return -1 if filters can't be allocated.
+    Return count of Bloom columns.
+    */
+    int DRM_set_blooms(directory_t* __restrict directory, directory_zone_column_t* __restrict columns, int count, int size);
+
+    /*
+    Check if page can contain key.
+
+    Params:
+    - directory - Pointer to directory.
+    - page - Page index in directory.
+    - bloom - Bloom column index (Check directory_header_t bloom_columns).
+    - key - Bloom key (Check DRM_make_bloom_key).
+
+    Return 0 if page don't contain key.
+    Return 1 if page can contain key (Or directory don't have this filter).
+    */
+    int DRM_check_bloom(directory_t* directory, int page, int bloom, long long key);
+
+#pragma endregion
+
 #pragma region [Directory]
 
     /*
@@ -288,8 +478,10 @@
     int DRM_free_directory(directory_t* directory);
 
     /*
-    Generate directory checksum. Checksum is sum of all bytes of directory name,
-    all bytes of page names.
+    Generate directory checksum. Checksum is sum of all bytes of directory header,
+    and page names, page summaries, zones and Bloom filters of directory pages.
+    Note: Checksum used by save for skipping of unchanged directories. Load don't verify it,
+          because directory file protected by Hamming encoding.
 
     Params:
     - directory - directory pointer.
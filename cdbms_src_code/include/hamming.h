@@ -12,6 +12,13 @@ typedef unsigned char byte_t;
 typedef unsigned short encoded_t;
 typedef unsigned short decoded_t;
 
+// Bulk codec paths for pack_memory / unpack_memory.
+// Note: SIMD paths available only on x86 (Disable them with NO_HAMMING_SIMD flag).
+#define HAMMING_PATH_AUTO   -1
+#define HAMMING_PATH_SCALAR 0
+#define HAMMING_PATH_SSE2   1
+#define HAMMING_PATH_AVX2   2
+
 encoded_t encode_hamming_15_11(decoded_t data);
 decoded_t decode_hamming_15_11(encoded_t encoded);
 
@@ -41,6 +48,34 @@ Return pointer to dst.
 */
 void* pack_memory(const byte_t* src, decoded_t* dst, int l);
 
+/*
+Find data in encoded memory without unpacking. First byte of data encoded once and compared with
+source words directly. Words, that are not valid codewords, compared after decoding (With correction).
+That's why result always same with search in unpacked memory.
+
+Params:
+- src - Source encoded data.
+- l - Element count.
+- data - Plain data for search.
+- n - Data size.
+
+Return -1 if data not found.
+Return index (first entry) of data.
+*/
+int find_packed_memory(const encoded_t* src, int l, const byte_t* data, int n);
+
+/*
+Select codec path for pack_memory, unpack_memory and find_packed_memory. By default path selected
+with runtime CPU check at first pack / unpack call. All paths have same output.
+
+Params:
+- path - HAMMING_PATH_AUTO for CPU check, or one of HAMMING_PATH_* paths.
+         If CPU don't support provided path, function will choose best supported.
+
+Return selected path.
+*/
+int hamming_select_path(int path);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,325 @@
+/*
+ *  License:
+ *  Copyright (C) 2024 Nikolaj Fot
+ *
+ *  This program is free software: you can redistribute it and/or modify it under the terms of
+ *  the GNU General Public License as published by the Free Software Foundation, version 3.
+ *  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *  You should have received a copy of the GNU General Public License along with this program.
+ *  If not, see https://www.gnu.org/licenses/.
+ *
+ *  Description:
+ *  Index is the side abstraction level, that work with table columns.
+ *  Indman - list of functions for working with B+tree and hash column indexes:
+ *  We can:
+ *      - Create / load / delete index file
+ *      - Insert and delete (key, row) entries
+ *      - Find rows by key with ==, < and > operations
+ *
+ *  Index file placed near table directories (<table_name>/<column_name>.ix) and contains fixed size
+ *  nodes. Node 0 is index header. Leaf nodes linked by next field, that's why range search
+ *  don't return to tree root. Entries sorted by (key, row), that's why duplicated keys work like uniqe keys.
+ *  Hash index (Primary columns) use linear hashing. Bucket nodes placed at odd nodes, overflow nodes at even nodes,
+ *  that's why bucket count grows by one split without moving other buckets. Hash index supports only == search.
+ *  Note: Deleted entries removed from leafs without rebalance. Sync rebuild indexes, if table rows were moved.
+ *
+ *  CordellDBMS source code: https://github.com/j1sk1ss/CordellDBMS.EXMPL
+ *  Credits: j1sk1ss
+*/
+
+#ifndef INDMAN_H_
+#define INDMAN_H_
+
+#include <nifat32/nifat32.h>
+#include <common.h>
+#include <tabman.h>
+
+#define INDEX_EXTENSION ENV_GET("INDEX_EXTENSION", "ix")
+
+// Index magic for file load_index function check
+#define INDEX_MAGIC     0xBB
+// Count of indexes, that stay opened after use (Check IND_load_index).
+#define INDEX_OPENED_COUNT  4
+// Minimal node size in bytes. Node will be larger, if INDEX_MIN_KEYS keys don't fit it.
+#define INDEX_NODE_SIZE 1024
+#define INDEX_MIN_KEYS  4
+// Node 0 is header, that's why 0 used as "no node" value.
+#define INDEX_NO_NODE   0
+
+// Initial count of hash buckets, and max load factor (percents) before bucket split.
+#define INDEX_HASH_BUCKETS  16
+#define INDEX_HASH_LOAD     75
+
+// Index types
+#define INDEX_TYPE_BTREE    0x00
+#define INDEX_TYPE_HASH     0x01
+
+// Key types. Int keys compared as numbers (COLUMN_TYPE_INT columns),
+// other keys compared as strings without leading spaces (Same with eq).
+// Raw keys contain column data as is (Same with DB_find_data_row).
+#define INDEX_KEY_BYTES 0x00
+#define INDEX_KEY_INT   0x01
+#define INDEX_KEY_RAW   0x02
+// Long keys used for binary int64 columns.
+#define INDEX_KEY_LONG  0x03
+
+// Search operations
+#define INDEX_EQUALS    0x00
+#define INDEX_LESS      0x01
+#define INDEX_MORE      0x02
+
+// We have *.ix bin file, where every node encoded and has same size
+//==============================================================================
+// HEADER NODE (MAGIC | TYPE | KEY TYPE | KEY SIZE | NODE SIZE | ROOT | BUCKETS) -> | NODES -> end |
+//==============================================================================
+
+    typedef struct {
+        // Index magic
+        unsigned char magic;
+
+        // Index type (B+tree or hash)
+        unsigned char type;
+
+        // Key type and size (Column size for string keys)
+        unsigned char key_type;
+        unsigned short key_size;
+
+        // Size of one node in decoded form
+        unsigned int node_size;
+
+        // Root node and count of nodes in file (With header node).
+        // Hash index: count of allocated overflow nodes.
+        unsigned int root;
+        unsigned int node_count;
+
+        // Hash index: count of buckets, count of entries and first free overflow node.
+        unsigned int bucket_count;
+        unsigned int entry_count;
+        unsigned int free_node;
+
+        // Index checksum and checksum algorithm (Check checksum.h)
+        unsigned char checksum_type;
+        checksum_t checksum;
+    } __attribute__((packed)) index_header_t;
+
+    typedef struct {
+        unsigned char is_leaf;
+        unsigned short count;
+
+        // Leaf - next leaf. Node - first child (Keys smaller than first entry).
+        unsigned int link;
+    } __attribute__((packed)) index_node_t;
+
+    typedef struct {
+        // Opened index flag and index owner (Check IND_load_index)
+        unsigned char is_cached;
+        char table_name[TABLE_NAME_SIZE];
+        int column;
+
+        // Index header
+        index_header_t* header;
+        unsigned char is_dirty;
+
+        // Opened index file
+        ci_t ci;
+
+        // Column place in stored row. Binary column data used as key without parsing.
+        int column_offset;
+        int column_size;
+        unsigned char is_binary;
+
+        // Node buffers. Encoded buffer used for node IO.
+        unsigned char* node;
+        encoded_t* encoded;
+    } index_t;
+
+#pragma region [Keys]
+
+    /*
+    Make index key from column data. String keys saved without leading spaces, int keys saved as int,
+    raw keys saved as is.
+
+    Params:
+    - index - Pointer to index.
+    - data - Column data (Or value from expression).
+    - data_size - Size of data.
+    - key - Pointer to key buffer (index->header->key_size bytes).
+
+    Return -1 if key can't equals any column value (Value larger than column).
+    Return 1 if key created.
+    */
+    int IND_make_key(index_t* __restrict index, unsigned char* __restrict data, int data_size, unsigned char* __restrict key);
+
+    /*
+    Make index key from stored table row (Check TBM_encode_row).
+
+    Params:
+    - index - Pointer to index.
+    - row - Stored row.
+    - key - Pointer to key buffer (index->header->key_size bytes).
+
+    Return -1 if key can't be created.
+    Return 1 if key created.
+    */
+    int IND_make_row_key(index_t* __restrict index, unsigned char* __restrict row, unsigned char* __restrict key);
+
+    /*
+    Insert (key, row) entry to index.
+
+    Params:
+    - index - Pointer to index.
+    - key - Entry key (Check IND_make_key).
+    - row - Row index in table.
+
+    Return -1 if something goes wrong.
+    Return 1 if entry inserted.
+    */
+    int IND_insert_key(index_t* __restrict index, unsigned char* __restrict key, int row);
+
+    /*
+    Delete (key, row) entry from index.
+    Note: Leafs don't merge after delete.
+
+    Params:
+    - index - Pointer to index.
+    - key - Entry key (Check IND_make_key).
+    - row - Row index in table.
+
+    Return -1 if something goes wrong.
+    Return 0 if entry not found.
+    Return 1 if entry deleted.
+    */
+    int IND_delete_key(index_t* __restrict index, unsigned char* __restrict key, int row);
+
+    /*
+    Find rows by key.
+    Note: Rows returned sorted by row index. Free rows array after use.
+
+    Params:
+    - index - Pointer to index.
+    - operation - INDEX_EQUALS, INDEX_LESS or INDEX_MORE (Hash index supports only INDEX_EQUALS).
+    - key - Key for compare (Check IND_make_key).
+    - rows - Pointer to rows array. Will be allocated.
+
+    Return -1 if something goes wrong.
+    Return count of rows.
+    */
+    int IND_find_rows(index_t* __restrict index, int operation, unsigned char* __restrict key, int** rows);
+
+    /*
+    Update indexes of table for row. Old row entries will be deleted, new row entries will be inserted.
+
+    Params:
+    - table - Pointer to table.
+    - old_data - Old stored row (Or NULL for new row).
+    - new_data - New stored row (Or NULL for deleted row).
+    - row - Row index in table.
+
+    Return count of updated indexes.
+    */
+    int IND_update_row(table_t* __restrict table, unsigned char* old_data, unsigned char* new_data, int row);
+
+    /*
+    Insert entries of appended rows to table indexes. Every index loaded and saved once.
+
+    Params:
+    - table - Pointer to table.
+    - data - Stored rows data (count * row_size bytes).
+    - count - Count of rows.
+    - rows - Row indexes in table.
+
+    Return count of updated indexes.
+    */
+    int IND_append_rows(table_t* __restrict table, unsigned char* __restrict data, int count, int* rows);
+
+#pragma endregion
+
+#pragma region [Index]
+
+    /*
+    Create new empty index for table column. Existed index file will be rewritten.
+    Index type depends on column index bits (COLUMN_INDEX_BTREE or COLUMN_INDEX_HASH).
+
+    Params:
+    - table - Pointer to table.
+    - column - Column index in table.
+
+    Return NULL if index can't be created.
+    Return pointer to index.
+    */
+    index_t* IND_create_index(table_t* table, int column);
+
+    /*
+    Open index file of table column. Last INDEX_OPENED_COUNT indexes stay opened, that's why
+    row updates don't reopen index file. Release index with IND_flush_index.
+
+    Params:
+    - table - Pointer to table.
+    - column - Column index in table.
+
+    Return NULL if index not found or broken.
+    Return pointer to index.
+    */
+    index_t* IND_load_index(table_t* table, int column);
+
+    /*
+    In difference with IND_free_index, IND_flush_index will free index in case, when
+    index not opened by IND_load_index. Header of opened index saved, if index changed.
+
+    Params:
+    - index - Pointer to index.
+
+    Return -1 - if index stay opened.
+    Return 1 - if Release was success.
+    */
+    int IND_flush_index(index_t* index);
+
+    /*
+    Save index header, close index file and free index.
+
+    Params:
+    - index - Pointer to index.
+
+    Return -1 if something goes wrong.
+    Return 1 if index released.
+    */
+    int IND_free_index(index_t* index);
+
+    /*
+    Delete index file of table column.
+
+    Params:
+    - table - Pointer to table.
+    - column - Column index in table.
+
+    Return -1 if index file can't be deleted.
+    Return 0 if index file not found.
+    Return 1 if index deleted.
+    */
+    int IND_delete_index(table_t* table, int column);
+
+    /*
+    Delete index files of all indexed table columns.
+
+    Params:
+    - table - Pointer to table.
+
+    Return count of deleted indexes.
+    */
+    int IND_delete_indexes(table_t* table);
+
+    /*
+    Get index checksum.
+
+    Params:
+    - index - Pointer to index.
+
+    Return checksum of index header.
+    */
+    unsigned int IND_get_checksum(index_t* index);
+
+#pragma endregion
+
+#endif
@@ -45,12 +45,16 @@
 
 #define MAX_COMMANDS    100
 #define MAX_STATEMENTS  20
+#define MAX_PROJECTION  MAX_STATEMENTS
+// Column count stored in one byte (Check table_header_t)
+#define MAX_COLUMNS     256
 #define MAX_CONNECTIONS 5
 
 #pragma region [Commands]
 
     #define ROLLBACK        "rollback"
     #define SYNC            "sync"
+    #define COMPACT         "compact"
 
     #define CREATE          "create"
     #define MIGRATE         "migrate"
@@ -61,17 +65,21 @@
 
     #define TABLE           "table"
     #define DATABASE        "database"
+    #define INDEX           "index"
     #define VERSION         "version"
 
     #define NAV             "nav"
     #define COLUMNS         "columns"
     #define COLUMN          "column"
     #define VALUES          "values"
+    #define HEX             "hex"
     #define VALUE           "value"
     #define EXPRESSION      "exp"
     #define ROW             "row"
+    #define ROWS            "rows"
     #define OFFSET          "offset"
     #define LIMIT           "limit"
+    #define OPTIONS         "options"
 
     #define BY_INDEX        "by_index"
     #define BY_EXPRESSION   "by_exp"
@@ -83,10 +91,11 @@
 
         #define ACCESS_SAME "same"
 
-        #define TYPE_INT    "int"
-        #define TYPE_MODULE "mod"
-        #define TYPE_STRING "str"
-        #define TYPE_ANY    "any"
+        #define TYPE_INT     "int"
+        #define TYPE_BIN_INT "bint"
+        #define TYPE_MODULE  "mod"
+        #define TYPE_STRING  "str"
+        #define TYPE_ANY     "any"
 
         #define MODULE_PRELOAD   "mpre"
         #define MODULE_POSTLOAD  "mpost"
@@ -94,6 +103,15 @@
 
     #pragma endregion
 
+    #pragma region [Options]
+
+        #define OPTION_SLOTTED      "slotted"
+        #define OPTION_COMPRESS     "compress"
+        #define OPTION_PAGE_SIZE    "page_size"
+        #define OPTION_BLOOM        "bloom"
+
+    #pragma endregion
+
     #pragma region [Expressions]
 
         #define OR  "or"
@@ -127,8 +145,36 @@ typedef struct {
     table_columns_info_t col_info;
     char*                expression;
     char*                value;
+
+    // Binary int columns compared with parsed value
+    unsigned char        is_binary;
+    long long            number;
 } condition_t;
 
+/*
+Matched rows, that wait POSTLOAD modules. Modules invoked once per batch (Check TBM_invoke_modules_rows).
+*/
+typedef struct {
+    int            count;
+    int            indexes[MODULE_BATCH_SIZE];
+    unsigned char* rows;
+} row_batch_t;
+
+/*
+Projection map of get command (columns ( a b ) clause). Map built once per command,
+and scan copies only projected byte ranges of text row to answer.
+*/
+typedef struct {
+    int count;
+    int size;
+    int offsets[MAX_PROJECTION];
+    int sizes[MAX_PROJECTION];
+
+    // POSTLOAD modules invoked only for flagged columns (Projected module columns and module columns, used by them)
+    unsigned char modules[MAX_COLUMNS];
+    unsigned char has_modules;
+} projection_t;
+
 typedef struct {
     condition_t conditions[MAX_STATEMENTS];
     int         condition_count;
@@ -136,6 +182,12 @@ typedef struct {
     int         operator_count;
     int         offset;
     int         limit;
+
+    // Module columns compared in text row (After POSTLOAD modules)
+    unsigned char needs_text;
+
+    // Projected columns of answer. NULL if whole row returned (Check projection_t).
+    projection_t* projection;
 } expression_t;
 
 /*
@@ -14,6 +14,13 @@
 #ifndef MODULE_H_
 #define MODULE_H_
 
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/wait.h>
 #include "logging.h"
 #include "common.h"
 
@@ -21,9 +28,76 @@
 #define MODULE_EXTENSION    ENV_GET("MODULE_EXTENSION", "mdl")
 #define MODULE_BASE_PATH    ENV_GET("MODULE_BASE_PATH", "")
 
+// Module answer is accepted only with this code (Exit code or mdl_invoke return value)
+#define MODULE_SUCCESS      100
+// Entry point of shared object module
+#define MODULE_ENTRY        "mdl_invoke"
+// Count of cached modules. Other modules launched without cache.
+#define MODULE_CACHE_SIZE   16
+
+// Executable module started with this argument works as worker (Check modules/worker.h).
+// Worker answers MODULE_WORKER_MAGIC at start, and after that reads batches from stdin:
+// | COUNT (uint) | -> ( ARGS SIZE (uint) | SIZE (uint) | ARGS | IN (SIZE bytes) ) x COUNT
+// and writes answers to stdout:
+// ( CODE (int) | ANSWER SIZE (uint) | ANSWER ) x COUNT
+// Note: Worker reads whole batch before answer, that's why pipes don't block each other.
+#define MODULE_WORKER_ARG       "--worker"
+#define MODULE_WORKER_MAGIC     0x574C444D
+// Max count of worker processes of one module (Concurrent batches).
+#define MODULE_WORKER_LIMIT     2
+// Max rows in one worker batch. Large batches splitted.
+#define MODULE_BATCH_SIZE       256
+// Wait time (ns) for free worker, when all workers of module busy.
+#define MODULE_WORKER_WAIT      100000
+// Worker answer timeout (ms). Worker restarted after timeout or crash.
+#define MODULE_WORKER_TIMEOUT   5000
+// After this count of failed restarts in a row module launched per row with popen.
+#define MODULE_WORKER_RETRIES   3
 
 /*
-Launch module by provided name.
+Shared object module entry point.
+Module writes answer string to out (Up to size bytes, zero terminated if shorter).
+Answer placed at right side of column, same with executable module output.
+Note: Module invoked in dbms process, that's why it shouldn't call exit.
+
+Params:
+- args - Module querry with column values.
+- in - Current column data (size bytes).
+- out - Place for module answer (size + 1 bytes, zero filled).
+- size - Column size.
+
+Return MODULE_SUCCESS if answer should be saved.
+*/
+typedef int (*mdl_invoke_t)(char* args, unsigned char* in, unsigned char* out, size_t size);
+
+typedef struct {
+    // Worker process and pipes. Zero pid - worker not started.
+    int pid;
+    int input;
+    int output;
+    unsigned char is_busy;
+} module_worker_t;
+
+typedef struct {
+    char name[MODULE_NAME_SIZE + 1];
+    unsigned char is_found;
+
+    // Shared object handle and entry point. NULL for executable modules.
+    void* handle;
+    mdl_invoke_t invoke;
+
+    // Workers of executable module. Module without worker mode launched per row.
+    unsigned char is_worker;
+    unsigned char no_worker;
+    int failures;
+    module_worker_t workers[MODULE_WORKER_LIMIT];
+} module_t;
+
+
+/*
+Launch module by provided name. Module loaded once and cached by name.
+Shared object module (.mdl with mdl_invoke entry) invoked in process,
+other modules launched as executables with popen.
 Note: Module should return 100 exit code. If it don't,
 dbms will ignore result.
 
@@ -41,4 +115,29 @@ Return 1 if launch and answer was success.
 */
 int MDL_launch_module(char* module_name, char* args, unsigned char* buffer, size_t buffer_size);
 
+/*
+Launch module for several rows. Executable module with worker mode get whole batch
+in one round trip, shared object module invoked for every row, other modules launched per row.
+
+Params:
+- module_name - Module name.
+- args - Arguments for module (One string per row).
+- buffers - Places, where will stored module answers (One place per row).
+- count - Count of rows.
+- buffer_size - Size of module answer (Same for all rows).
+
+Return -2 if module has error.
+Return -1 if module not found.
+Return 1 if launch and answer was success.
+*/
+int MDL_launch_batch(char* module_name, char** args, unsigned char** buffers, int count, size_t buffer_size);
+
+/*
+Close loaded shared object modules, stop workers and clear module cache.
+Note: Don't call it while modules invoked in other threads.
+
+Return count of closed modules.
+*/
+int MDL_unload_modules();
+
 #endif
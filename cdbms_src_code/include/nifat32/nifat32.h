@@ -51,6 +51,10 @@ typedef struct fat_BS {
     unsigned int   total_sectors_32;
     nifat32_ext32_bootsector_t extended_section;
     checksum_t     checksum;
+    // Checksum algorithm for entries and name hashes (Check checksum.h).
+    // Note: Bootsector always protected by murmur3. Old images without this field
+    //       have zero here, that's why they stay murmur3 images.
+    unsigned char  checksum_type;
 } __attribute__((packed)) nifat32_bootsector_t;
 
 #define NO_CACHE   0b00000000
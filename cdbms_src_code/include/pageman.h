@@ -34,6 +34,7 @@
 #include <common.h>
 #include <tcache.h>
 #include <hamming.h>
+#include <compress.h>
 #include <checksum.h>
 #include <nifat32/nifat32.h>
 
@@ -46,20 +47,58 @@
 
     #define PAGE_EMPTY          0xFF
     // 4096 is default. Lower - less RAM. Higher - faster.
+    // Page size can be changed per table at creation (Check TBM_create_table).
     #define PAGE_CONTENT_SIZE   4096
+    #define PAGE_MIN_SIZE       1024
+    #define PAGE_MAX_SIZE       65536
     #define PAGE_START          0x00
 
+    // Content size of loaded page.
+    #define PAGE_SIZE_OF(page)  ((int)(page)->header->page_size)
+
 #pragma endregion
 
-#define PAGE_MAGIC 0xCA
+#define PAGE_MAGIC 0xC8
+// Pages with first header layout (Default page size, without free-extent map) migrated at load.
+#define PAGE_BASE_MAGIC 0xCA
+// Checksum algorithm for new tables, directories and pages (Check checksum.h).
+// Algorithm recorded in headers, that's why files with other algorithm still can be verified.
+#ifndef DBMS_CHECKSUM
+    #define DBMS_CHECKSUM CHECKSUM_CRC32C
+#endif
 // 64^6 = 56.800.235.584 - unique page names.
-// 64^6 * PAGE_CONTENT_SIZE = 211 TB
+// 64^6 * PAGE_CONTENT_SIZE = 211 TB (With default page size)
 #define PAGE_NAME_SIZE 4
 
+// Free-extent map size. If page has more runs of empty bytes, map will be rebuilt
+// with page scan at next free space request.
+#define PAGE_EXTENTS_COUNT      8
+#define PAGE_EXTENTS_INVALID    0xFF
+
+// Dirty ranges count. If page has more modified ranges, they will be merged
+// to one range, that covers all of them.
+#define PAGE_DIRTY_RANGES_COUNT 4
+
+// Page layout flags. Flags set at table creation and propagated to directories and pages.
+// Slotted page - content splitted to slots with row size, and slot map (one bit per slot)
+// placed after header. Deleted rows marked by tombstones (Cleared bits) in slot map.
+#define PAGE_FLAG_SLOTTED       0x01
+// Compressed page - plain page image compressed before Hamming encoding (Check compress.h).
+#define PAGE_FLAG_COMPRESSED    0x02
+#define PAGE_SLOTS_MAP_SIZE(page_size) (((page_size) + 7) / 8)
+// Size of slot map on disk.
+#define PAGE_SLOTS_MAP_BYTES(header) \
+    (((header)->flags & PAGE_FLAG_SLOTTED) ? ((header)->page_size / (header)->slot_size + 7) / 8 : 0)
+
 // We have *.pg bin file, where at start placed header
-//================================================
-// INDEX | CONTENT_SIZE | CONTENT -> size -> end |
-//================================================
+//=====================================================================================
+// HEADER | SLOTS_MAP (Only slotted) | CONTENT (Or compressed content) -> size -> end |
+//=====================================================================================
+
+    typedef struct {
+        unsigned int offset;
+        unsigned int length;
+    } __attribute__((packed)) page_extent_t;
 
     typedef struct {
         // Magic namber for check
@@ -70,8 +109,25 @@
         // With this name we can save pages / compare pages
         char name[PAGE_NAME_SIZE];
 
-        // Table checksum
+        // Page checksum and checksum algorithm (Check checksum.h)
+        unsigned char checksum_type;
         checksum_t checksum;
+
+        // Free-extent map. Count of empty bytes and sorted runs of empty bytes.
+        // Updated by insert / delete, that's why we don't need page scan for append.
+        unsigned int free_space;
+        unsigned char extent_count;
+        page_extent_t extents[PAGE_EXTENTS_COUNT];
+
+        // Page layout flags and slot size (Row size) for slotted pages
+        unsigned char flags;
+        unsigned short slot_size;
+
+        // Size of compressed content on disk. 0 - content stored without compression.
+        unsigned int compressed_size;
+
+        // Page content size (PAGE_MIN_SIZE - PAGE_MAX_SIZE).
+        unsigned int page_size;
     } __attribute__((packed)) page_header_t;
 
     typedef struct {
@@ -81,11 +137,29 @@
 
         // Page header with all special information
         page_header_t* header;
-        short append_offset;
+        // Offset for next append. Int, because page content can be larger than short (PAGE_MAX_SIZE).
+        // -1 - offset unknown, it will be found with PGM_get_fit_free_space.
+        int append_offset;
 
-        // Page content
-        unsigned short content[PAGE_CONTENT_SIZE];
+        // Page content. All page buffers allocated with page size from header.
+        unsigned short* content;
         char* base_path;
+
+        // Decoded page content. It lazy decoded at first access, and
+        // all reads / writes work with plain bytes. Encoding moved to save.
+        // Note: If page is dirty, encoded content is outdated.
+        unsigned char is_decoded;
+        unsigned char is_dirty;
+        unsigned char* plain;
+
+        // Slot map for slotted pages. One bit per slot, where 1 - used slot, 0 - free slot or tombstone.
+        unsigned char* slots;
+
+        // Modified ranges of plain content since last save. Save encode and write only
+        // sectors, that cover these ranges. Page without file (Not stored) written fully.
+        unsigned char is_stored;
+        unsigned char dirty_count;
+        page_extent_t dirty_ranges[PAGE_DIRTY_RANGES_COUNT];
     } __attribute__((packed)) page_t;
 
 
@@ -120,6 +194,7 @@
 
     /*
     Rewrite all line by EMPTY symbols
+    Note: In slotted page, all slots, that fully covered by line, will be marked as tombstones.
 
     Params:
     - page - pointer to page
@@ -143,6 +218,7 @@
 
     Note 2: For avoiding situations, where function return part of word, add space to target data (Don't forget to encrease size).
     Note 3: Don't use CD and RD symbols in data. (Optionaly). If you want find row, use find row function.
+    Note 4: If page not decoded yet, search works with encoded content (Check find_packed_memory).
 
     Params:
     - page - pointer to page.
@@ -158,6 +234,7 @@
 
     /*
     Return value in bytes of free page space
+    Note: Function works with page free-extent map and don't scan page content.
     Note: Will return only block of free space. For examle if in page we have situation like below:
     NFREE -> SMALL FREE -> NFREE -> LARGE FREE -> ...
     function will return SMALL FREE size. That's why try to use offset (or provide -1 for getting all free space)
@@ -172,6 +249,7 @@
 
     /*
     Return index in page of empty space, that more or equals provided size
+    Note: Function works with page free-extent map and don't scan page content.
 
     Params:
     - page - pointer to page
@@ -185,6 +263,41 @@
     */
     int PGM_get_fit_free_space(page_t* page, int offset, int size);
 
+    /*
+    Return largest size of data, that fits page (Check PGM_get_fit_free_space). Directories keep
+    this value for every page, that's why append can skip full pages without page load.
+    Note: Function works with page free-extent map (Or slot map) and don't scan page content.
+
+    Params:
+    - page - pointer to page
+
+    Return size in bytes.
+    */
+    int PGM_get_max_free_space(page_t* page);
+
+    /*
+    Get decoded page content. If page not decoded yet, decode content to plain image.
+
+    Params:
+    - page - pointer to page.
+
+    Return pointer to plain page content.
+    */
+    unsigned char* PGM_get_plain(page_t* page);
+
+    /*
+    Compact slotted page. All used slots moved to page start in same order, that's why
+    free slots (Tombstones) will be placed at page end.
+    Note: This function change row positions in page. Use it only during cleanup.
+
+    Params:
+    - page - pointer to page.
+
+    Return -1 if page isn't slotted.
+    Return count of moved slots.
+    */
+    int PGM_compact_page(page_t* page);
+
 #pragma endregion
 
 #pragma region [Page]
@@ -196,11 +309,14 @@
     - name - page name
     - buffer - page content
     - data_size - data size
+    - page_size - page content size (PAGE_MIN_SIZE - PAGE_MAX_SIZE).
 
-    P.S. Function always pad content to fit default page size
-         If buffer_size higher then default page-size, it will trunc
+    P.S. Function always pad content to fit page size
+         If buffer_size higher then page-size, it will trunc
+    
+    Return NULL if page size is wrong.
     */
-    page_t* PGM_create_page(char* __restrict name, unsigned char* __restrict buffer, size_t data_size);
+    page_t* PGM_create_page(char* __restrict name, unsigned char* __restrict buffer, size_t data_size, unsigned int page_size);
 
     /*
     Same function with create page, but here you can avoid name and buffer input.
@@ -212,14 +328,22 @@
 
     Params:
     - base_path - Base path of pages. 
+    - page_size - page content size (PAGE_MIN_SIZE - PAGE_MAX_SIZE).
+    - flags - Page layout flags (PAGE_FLAG_*).
+    - slot_size - Slot size for slotted page. Ignored without PAGE_FLAG_SLOTTED flag.
 
     Return pointer to allocated page.
     Return NULL if we can`t create random name.
     */
-    page_t* PGM_create_empty_page(char* base_path);
+    page_t* PGM_create_empty_page(char* base_path, unsigned int page_size, unsigned char flags, unsigned short slot_size);
 
     /*
     Save page on disk.
+    Note: Plain content encoded here (Only if page is dirty).
+    Note 2: Page with PAGE_FLAG_COMPRESSED flag compressed before encoding.
+    Note 3: Clean page skipped. Stored page write only header, slot map and sectors with dirty ranges.
+            Whole page written for new and compressed pages.
+    Note 4: Page checksum updated at every save (Without NO_PAGE_SAVE_OPTIMIZATION flag).
 
     Params:
     - page - pointer to page.
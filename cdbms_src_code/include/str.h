@@ -12,6 +12,7 @@ Memory special functions.
 void* str_memcpy(void* destination, const void* source, unsigned int num);
 void* str_memset(void* pointer, unsigned char value, unsigned int num);
 int str_memcmp(const void* firstPointer, const void* secondPointer, unsigned int num);
+int str_memfind(const void* source, unsigned int source_size, const void* data, unsigned int data_size);
 
 /*
 String special functions.
@@ -23,6 +24,11 @@ unsigned int str_strlen(const char* str);
 char* str_strcpy(char* dst, const char* src);
 char* str_strcat(char* dest, const char* src);
 
+/*
+Parse number from string. Leading spaces skipped, parse stops at first non digit symbol or after length symbols.
+*/
+long long str_atoll(const char* str, int length);
+
 /*
 ctype special functions.
 */
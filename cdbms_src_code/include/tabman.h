@@ -38,9 +38,19 @@
 #include <tcache.h>
 #include <nifat32/nifat32.h>
 
-#define TABLE_MAGIC             0xAA
+#define TABLE_MAGIC             0xAB
+// Tables with first header layout (Default page size, murmur3 checksum, one byte directory count) migrated at load.
+#define TABLE_BASE_MAGIC        0xAA
 #define TABLE_NAME_SIZE         8
-#define DIRECTORIES_PER_TABLE   0xFF
+// Directory map grows by this step.
+// Note: Directories are leafs with fixed page count, that's why page lookup by offset is O(1).
+#define TABLE_DIRECTORIES_STEP  16
+// Global table offsets, row indexes and index row ids are int, that's why table content can't be larger than 2 GB.
+// Max directory count depends on table page size (Check TBM_reserve_dirs).
+#define TABLE_MAX_SIZE          0x7FFFFFFF
+#define TABLE_MAX_DIRECTORIES(page_size) (TABLE_MAX_SIZE / DIRECTORY_OFFSET(page_size))
+// Max count of pages, that compaction process during one step (Check TBM_compact_table).
+#define TABLE_COMPACTION_STEP   16
 
 #define TABLE_EXTENSION         ENV_GET("TABLE_EXTENSION", "tb")
 // Set here default path for save.
@@ -66,7 +76,7 @@
     // Column auto increment bits.
     // That means, that every primary columns (one at table), will have 
     // value equals of value of rows in table.
-    // Note: Work only with TYPE_INT columns.
+    // Note: Work only with TYPE_INT columns. Value taken from table header counter (Check table_header_t).
     #define COLUMN_NO_AUTO_INC       0x00
     #define COLUMN_AUTO_INCREMENT    0x01
 
@@ -75,6 +85,12 @@
     #define COLUMN_NOT_PRIMARY       0x00
     #define COLUMN_PRIMARY           0x01
 
+    // Column encoding bit. Binary int column stored as little-endian int32 (Text size < 10)
+    // or int64 (Other sizes). Text converted to binary at append and back to text at get.
+    // Note: Column size is text size. Work only with TYPE_INT columns of slotted tables (Not first column).
+    #define COLUMN_TEXT_INT          0x00
+    #define COLUMN_BINARY_INT        0x01
+
     // Any type say that user can insert any value that he want
     #define COLUMN_TYPE_ANY          0x00
     // Int type throw error, if user insert something, that not int
@@ -84,8 +100,30 @@
     // String type throw error, if user insert something, that not char*
     #define COLUMN_TYPE_STRING       0x03
 
+    // Column index bits. Indexed column has B+tree or hash index file (Check indman.h).
+    // Primary columns get hash index at table creation.
+    // Bloom column hasn't index file. Directories keep Bloom filter of column for every page (Check dirman.h).
+    #define COLUMN_NO_INDEX          0x00
+    #define COLUMN_INDEX_BTREE       0x01
+    #define COLUMN_INDEX_HASH        0x02
+    #define COLUMN_INDEX_BLOOM       0x03
+
+    // Macros for getting column index status.
+    #define GET_COLUMN_INDEX(type)          ((type >> 6) & 0b11)
+    // Macros for setting column index status.
+    #define SET_COLUMN_INDEX(type, index)   (((type) & 0b00111111) | (((index) & 0b11) << 6))
+    // Macros for checking, if column has index file.
+    #define IS_COLUMN_INDEXED(type)         (GET_COLUMN_INDEX(type) == COLUMN_INDEX_BTREE || GET_COLUMN_INDEX(type) == COLUMN_INDEX_HASH)
+
     // Macros for getting column primary status. (Unique value at every row).
-    #define GET_COLUMN_PRIMARY(type)        ((type >> 4) & 0b11)
+    #define GET_COLUMN_PRIMARY(type)        ((type >> 4) & 0b1)
+    // Macros for getting column encoding. Binary encoding used only for int columns.
+    #define GET_COLUMN_BINARY(type)         (((type >> 5) & 0b1) && GET_COLUMN_DATA_TYPE(type) == COLUMN_TYPE_INT)
+    // Macros for setting column encoding.
+    #define SET_COLUMN_BINARY(type, binary) (((type) & 0b11011111) | (((binary) & 0b1) << 5))
+    // Size of column in stored row.
+    #define GET_COLUMN_STORED_SIZE(column) \
+        (GET_COLUMN_BINARY((column)->type) ? ((column)->size < 10 ? sizeof(int) : sizeof(long long)) : (column)->size)
     // Macros for getting column data type. What data type is set in this column.
     #define GET_COLUMN_DATA_TYPE(type)      ((type >> 2) & 0b11)
     // Macros for getting column type. Can it autoincrement or something like that.
@@ -93,7 +131,7 @@
 
     // Generate column type byte
     #define CREATE_COLUMN_TYPE_BYTE(is_primary, column_data_type, column_type) \
-        (((is_primary & 0b11) << 4) | ((column_data_type & 0b11) << 2) | (column_type & 0b11))
+        (((is_primary & 0b1) << 4) | ((column_data_type & 0b11) << 2) | (column_type & 0b11))
 
 #pragma endregion
 
@@ -103,11 +141,15 @@
 //========================================================================================================================================
 
     /*
-    Column info struct for getting size and offset in table
+    Column info struct for getting size and offset in table.
+    Size and offset point to stored row, text size and offset point to text row (Check TBM_encode_row).
     */
     typedef struct {
         int size;
         int offset;
+        int index;
+        int text_size;
+        int text_offset;
     } __attribute__((packed)) table_columns_info_t;
 
     typedef struct {
@@ -116,12 +158,14 @@
 
         /*
         Column type indicates what type should user insert to this column.
-        Main idea, that we save type, data type and primary status in one byte.
+        Main idea, that we save type, data type, primary and index status in one byte.
         In summary we have next byte:
-        0x00|PP|DD|TT|
+        0x|II|BP|DD|TT|
 
         Where:
-        PP - Primary bits.
+        II - Index bits.
+        B  - Encoding bit (Binary int).
+        P  - Primary bit.
         DD - Data type bits.
         TT - Column type bits.
         */
@@ -141,6 +185,63 @@
         char module_querry[COLUMN_MODULE_SIZE];
     } __attribute__((packed)) table_column_t;
 
+    /*
+    Calc columns (calc=<formula>) compiled to RPN program and evaluated in kernel
+    without module launch. Formula has same syntax with calc module (Check modules/calc):
+    int numbers, column names and + - * / % ^ operators with parentheses.
+    */
+    #define CALC_MODULE_NAME    "calc"
+    // Formula with COLUMN_MODULE_SIZE chars can't give more instructions.
+    #define CALC_PROGRAM_SIZE   COLUMN_MODULE_SIZE
+
+    #define CALC_OP_NUMBER      0x00
+    #define CALC_OP_COLUMN      0x01
+    #define CALC_OP_ADD         0x02
+    #define CALC_OP_SUB         0x03
+    #define CALC_OP_MUL         0x04
+    #define CALC_OP_DIV         0x05
+    #define CALC_OP_MOD         0x06
+    #define CALC_OP_POW         0x07
+
+    typedef struct {
+        unsigned char opcode;
+
+        // Column place in text row (CALC_OP_COLUMN)
+        unsigned short offset;
+        unsigned short size;
+
+        // Number value (CALC_OP_NUMBER)
+        long long value;
+    } calc_instruction_t;
+
+    typedef struct {
+        // Count of instructions. Zero if column isn't compiled calc column.
+        unsigned char count;
+        calc_instruction_t code[CALC_PROGRAM_SIZE];
+    } calc_program_t;
+
+    /*
+    Zone filters used by scan for skipping pages and directories (Check dirman.h zone maps).
+    Int columns compared as numbers, other columns support only eq.
+    Bloom filters (ZONE_BLOOM) use same struct, and skip pages without value.
+    */
+    #define ZONE_EQUALS     0x00
+    #define ZONE_LESS       0x01
+    #define ZONE_MORE       0x02
+    // Text compare (eq). Equal texts have equal keys, that's why it works with number zones too.
+    #define ZONE_MATCH      0x03
+    // Bloom filter. Zone field is Bloom column index, key is Bloom key (Check DRM_make_bloom_key).
+    #define ZONE_BLOOM      0x04
+
+    typedef struct {
+        // Zone index in directories and zone column, that directory should have at this index
+        int zone;
+        directory_zone_column_t column;
+
+        unsigned char operation;
+        long long key;
+    } zone_filter_t;
+
     typedef struct {
         // Table magic
         unsigned char magic;
@@ -170,9 +271,21 @@
 
         // Dir count in this table
         // How much directories in this table
-        unsigned char dir_count;
+        unsigned int dir_count;
+
+        // Page layout flags for table pages (Check PAGE_FLAG_* flags)
+        unsigned char page_flags;
+
+        // Content size of table pages (PAGE_MIN_SIZE - PAGE_MAX_SIZE).
+        // Small pages fit tables with tiny rows, large pages fit wide rows.
+        unsigned int page_size;
 
-        // Table checksum
+        // Last value of auto increment columns. Counter only grows, that's why
+        // values don't repeat after delete. Zero in migrated tables (Initialized from last row).
+        unsigned long long increment;
+
+        // Table checksum and checksum algorithm (Check checksum.h)
+        unsigned char checksum_type;
         checksum_t checksum;
     } __attribute__((packed)) table_header_t;
 
@@ -183,14 +296,24 @@
 
         // Table header
         table_header_t* header;
-        unsigned char append_offset;
+        unsigned int append_offset;
+        // Global offset of last appended content (Check TBM_append_content)
+        int last_append;
 
         // Column names
+        // Row size in pages and row size in text form (Input and output rows of dataman).
+        // Sizes are same, if table don't have binary columns.
         table_column_t** columns;
         unsigned short row_size;
+        unsigned short text_size;
+
+        // Compiled calc programs for every column (Check TBM_compile_calcs).
+        // NULL if table hasn't calc columns.
+        calc_program_t* programs;
 
-        // Table directories
-        char dir_names[DIRECTORIES_PER_TABLE][DIRECTORY_NAME_SIZE];
+        // Table directories. Directory map allocated with TBM_reserve_dirs.
+        unsigned int dir_capacity;
+        char (*dir_names)[DIRECTORY_NAME_SIZE];
     } __attribute__((packed)) table_t;
 
 #pragma region [Directories]
@@ -213,7 +336,7 @@
     Insert data row to content pages in directories. Main difference with append_content is hard part.
     This maeans, that we don't care about signature and other stuff. One thing that can cause fail, directory end.
     Note: If table don't have any directories, it will return error code (-3)
-    Note 2: If during insert process, we reach page limit in directory, we return error code (-2)
+    Note 2: Insert don't create pages. If content reach end of existed pages, it will trunc (Return 2).
 
     ! In summary, this function shouldn't be used in ususal tasks. It may broke whole table at one time. !
 
@@ -223,10 +346,10 @@
     - data - Append data.
     - data_size - Size of data.
 
-    Return -3 if table is empty.
-    Return -1 if something goes wrong.
-    Return 0 if row insert was success.
-    Return 1 if row insert was success and we create new pages.
+    Return -3 if offset outside of table pages. Nothing was written.
+    Return -1 if something goes wrong (Directory locked or not loaded). Nothing was written.
+    Return 1 if content insert was success.
+    Return 2 if content insert was success, but content was trunc at table end.
     */
     int TBM_insert_content(table_t* __restrict table, int offset, unsigned char* __restrict data, size_t data_size);
 
@@ -234,6 +357,7 @@
     Append data to content pages in directories
     Note: If table don't have any directories, it will create one, then create one additional page
     Note 2: If during append process, we reach page limit in directory, we create a new one
+    Note 3: Global offset of appended content saved in table->last_append
 
     Params:
     - table - pointer to table
@@ -244,6 +368,7 @@
     Return -12 if we can't create uniqe name for page.
     Return -13 if data size too large for one page. Check [pageman.h] docs for explanation.
     }
+    Return -6 if table reach size limit (Check TABLE_MAX_SIZE)
     Return -1 if something goes wrong
     Return 0 if append was success
     Return 1 if append was success and we create new pages
@@ -251,14 +376,34 @@
     */
     int TBM_append_content(table_t* __restrict table, unsigned char* __restrict data, size_t data_size);
 
+    /*
+    Append rows to content pages in directories. Batch version of TBM_append_content, where every
+    touched directory and page saved once.
+    Note: Table not saved here. Save it once after batch.
+
+    Params:
+    - table - pointer to table
+    - data - rows for append (count * row_size bytes)
+    - count - count of rows
+    - offsets - pointer to array for global offsets of appended rows (Or NULL)
+
+    Return {
+    Return -12 if we can't create uniqe name for page.
+    }
+    Return -6 if table reach size limit (Check TABLE_MAX_SIZE)
+    Return -1 if something goes wrong
+    Return count of appended rows
+    */
+    int TBM_append_rows(table_t* __restrict table, unsigned char* __restrict data, int count, int* offsets);
+
     /*
     Delete content in table. All steps below:
     TABLE -> DIRECTORY -> PAGE
     This is a highest abstraction level delete function, that can delete content in many directories at one function call.
     Note: If you will try to delete content from not existed pages or directories, this function will return -1.
     Note 2: For offset in pages or directories use defined vars like:
-    - DIRECTORY_OFFSET for directory offset.
-    - PAGE_CONTENT_SIZE for page offset.
+    - DIRECTORY_OFFSET(table->header->page_size) for directory offset.
+    - table->header->page_size for page offset.
 
     Params:
     - table - pointer to table.
@@ -278,11 +423,26 @@
     Params:
     - table - pointer to table.
 
-    Return 1 if cleanup success.
+    Return count of removed and compacted pages (Check DRM_cleanup_pages).
     Return -1 if something goes wrong.
     */
     int TBM_cleanup_dirs(table_t* table);
 
+    /*
+    Make one bounded compaction step. Sparse pages merged inside every directory, then rows from
+    last directories moved to free rows of first directories. Empty pages and directories deleted.
+    Note: Row positions will be changed. After full compaction all pages, except last, are full.
+    Note 2: Step can be repeated, until it returns 0.
+
+    Params:
+    - table - pointer to table.
+    - max_pages - Max count of source pages for processing (Check TABLE_COMPACTION_STEP).
+
+    Return -2 if delete command disabled.
+    Return count of processed pages.
+    */
+    int TBM_compact_table(table_t* table, int max_pages);
+
     /*
     Find data function return global index in table of provided data. (Will return first entry of data).
     Note: Will return index, if we have perfect fit. That's means:
@@ -295,13 +455,14 @@
 
     Note 2: For avoiding situations, where function return part of word, add space to target data (Don't forget to encrease size).
     Note 3: Don't use CD and RD symbols in data. (Optionaly). If you want find row, use find row function.
-    Note 4: This function is sungle thread, because we should be sure, that data sequence is correct.
+    Note 4: Directories searched in order, pages of every directory searched in parallel (Check DRM_find_content).
+            Entry, that starts in directory tail and continues in next directory, also will be found.
 
     Params:
     - table - pointer to table.
     - offset - global offset. For simple use, try:
-                DIRECTORY_OFFSET for directory offset,
-                PAGE_CONTENT_SIZE for page offset.
+                DIRECTORY_OFFSET(table->header->page_size) for directory offset,
+                table->header->page_size for page offset.
     - data - data for seacrh
     - data_size - data for search size
 
@@ -322,7 +483,7 @@
 
     Params:
     - type - Column type.
-    - size - Size of columns. Remember, that max size of row - PAGE_CONTENT_SIZE.
+    - size - Size of columns. Remember, that max size of row - table page size.
     - name - Column name (Should equals or smaller then column max size).
            If it large then max size, name will trunc for fit.
 
@@ -331,7 +492,7 @@
     table_column_t* TBM_create_column(unsigned char type, unsigned short size, char* name);
 
     /*
-    This function get offset in row for getting data.
+    This function get offset in row for getting data. Also it saves column index in table.
 
     Params:
     - table - Pointer to table.
@@ -353,13 +514,149 @@
 
     Return -4 if column type unknown. Check table, that you provide into function.
     Return -3 if signature is wrong. You provide value for FLOAT column, but value is not float.
-    Return -2 if signature is wrong. You provide value for TYPE_INT column, but value is not integer.
+    Return -2 if signature is wrong. You provide value for TYPE_INT column, but value is not integer
+              (Or value overflows long long in binary int column).
     Return -1 if provided data too small. Maybe you forgot additional CD? <DEPRECATED>
               This error indicates, that data to small for this column count.
     Return 1 if signature is correct.
     */
     int TBM_check_signature(table_t* __restrict table, unsigned char* __restrict data);
 
+    /*
+    Convert text row to stored row. Binary int columns parsed from text, other columns copied.
+
+    Params:
+    - table - Pointer to table.
+    - text - Text row (table->text_size bytes).
+    - row - Stored row buffer (table->row_size bytes).
+
+    Return 1 if row converted.
+    */
+    int TBM_encode_row(table_t* __restrict table, unsigned char* __restrict text, unsigned char* __restrict row);
+
+    /*
+    Convert stored row to text row. Binary int columns printed with zero padding to column size.
+    Note: Deleted row (PAGE_EMPTY) copied as is.
+
+    Params:
+    - table - Pointer to table.
+    - row - Stored row (table->row_size bytes).
+    - text - Text row buffer (table->text_size bytes).
+
+    Return 1 if row converted.
+    */
+    int TBM_decode_row(table_t* __restrict table, unsigned char* __restrict row, unsigned char* __restrict text);
+
+#pragma endregion
+
+#pragma region [Calc]
+
+    /*
+    Compile formulas of calc columns to RPN programs with column offsets in text row.
+    Programs saved in table->programs. Column with wrong formula stay module column
+    and will be launched as calc module.
+
+    Params:
+    - table - Pointer to table.
+
+    Return -1 if something goes wrong.
+    Return count of compiled columns.
+    */
+    int TBM_compile_calcs(table_t* table);
+
+    /*
+    Evaluate calc program for text row. Function don't allocate memory.
+
+    Params:
+    - program - Compiled program (Check TBM_compile_calcs).
+    - row - Text row (table->text_size bytes).
+    - result - Pointer to result value.
+
+    Return -1 if evaluation failed (Division by zero).
+    Return 1 if result calculated.
+    */
+    int TBM_eval_calc(calc_program_t* __restrict program, unsigned char* __restrict row, long long* __restrict result);
+
+#pragma endregion
+
+#pragma region [Zones]
+
+    /*
+    Set zone columns of new directory. First DIRECTORY_ZONE_COUNT int columns selected,
+    then string columns. Module columns don't have zones (Value changes after load).
+    Note: Call it before first page of directory.
+
+    Params:
+    - table - Pointer to table.
+    - directory - Pointer to new directory.
+
+    Return count of zone columns.
+    */
+    int TBM_set_zones(table_t* __restrict table, directory_t* __restrict directory);
+
+    /*
+    Make zone filter for column condition.
+
+    Params:
+    - table - Pointer to table.
+    - column - Column index in table.
+    - operation - ZONE_EQUALS, ZONE_LESS, ZONE_MORE or ZONE_MATCH.
+    - value - Value from expression.
+    - filter - Pointer to filter.
+
+    Return -1 if column don't have zone, or zone don't support operation.
+    Return 1 if filter created.
+    */
+    int TBM_make_zone_filter(table_t* __restrict table, int column, unsigned char operation, char* __restrict value, zone_filter_t* __restrict filter);
+
+    /*
+    Set Bloom columns of new directory. First DIRECTORY_BLOOM_COUNT columns with COLUMN_INDEX_BLOOM selected.
+    Filter size depends from count of rows in page (8 bits per row).
+    Note: Call it before first page of directory.
+
+    Params:
+    - table - Pointer to table.
+    - directory - Pointer to new directory.
+
+    Return -1 if filters can't be allocated.
+    Return count of Bloom columns.
+    */
+    int TBM_set_blooms(table_t* __restrict table, directory_t* __restrict directory);
+
+    /*
+    Make Bloom filter for column value.
+
+    Params:
+    - table - Pointer to table.
+    - column - Column index in table.
+    - operation - ZONE_EQUALS (Compare as numbers) or ZONE_MATCH (Compare as text).
+    - value - Value in stored form (Binary int columns - int32 / int64, other columns - text).
+    - size - Size of value.
+    - filter - Pointer to filter.
+
+    Return -1 if column don't have Bloom filter, or filter don't support operation.
+    Return 1 if filter created.
+    */
+    int TBM_make_bloom_filter(
+        table_t* __restrict table, int column, unsigned char operation, unsigned char* __restrict value, int size, zone_filter_t* __restrict filter
+    );
+
+    /*
+    Count pages, where rows can't match all filters. Pages counted from provided page,
+    while page zones (Or summary of directory) exclude one of filters, or page Bloom filter don't contain value.
+    Note: Pages mapped to directories same with TBM_get_content.
+    Note 2: Directories without zones and Bloom filters (Migrated first layout directories) never skipped.
+
+    Params:
+    - table - Pointer to table.
+    - page - Global page index (Global offset / page size).
+    - filters - Zone filters (Conditions joined by "and").
+    - count - Count of filters.
+
+    Return count of pages, that can be skipped.
+    */
+    int TBM_skip_pages(table_t* __restrict table, int page, zone_filter_t* __restrict filters, int count);
+
 #pragma endregion
 
 #pragma region [Table]
@@ -371,11 +668,15 @@
     - name - name of table (Can be freed after function)
     - columns - columns in table (Please avoid free operations)
     - col_count - columns count
-    - access - access of table
+    - page_flags - layout flags of table pages (PAGE_FLAG_*)
+    - page_size - content size of table pages (PAGE_MIN_SIZE - PAGE_MAX_SIZE)
 
+    Return NULL if row don't fit page or page size is wrong
     Return pointer to new table
     */
-    table_t* TBM_create_table(char* __restrict name, table_column_t** __restrict columns, int col_count);
+    table_t* TBM_create_table(
+        char* __restrict name, table_column_t** __restrict columns, int col_count, unsigned char page_flags, unsigned int page_size
+    );
 
     /*
     Save table to the disk
@@ -405,6 +706,20 @@
     */
     table_t* TBM_load_table(char* name);
 
+    /*
+    Reserve place in table directory map. Map grows by TABLE_DIRECTORIES_STEP.
+    Note: Count limited by TABLE_MAX_DIRECTORIES, that's why global offsets of table don't overflow.
+
+    Params:
+    - table - Pointer to table.
+    - count - Required directory count.
+
+    Return -2 if count larger than TABLE_MAX_DIRECTORIES of table page size.
+    Return -1 if map can't be allocated.
+    Return 1 if map has place for count directories.
+    */
+    int TBM_reserve_dirs(table_t* table, unsigned int count);
+
     /*
     Delete table from disk.
     Note: Will delete all linked directories and linked pages if flag full is 1.
@@ -460,10 +775,12 @@
     unsigned int TBM_get_checksum(table_t* table);
 
     /*
-    Migrate table data to new table structure.
+    Migrate table data to new table structure. Source pages readed one by one, converted rows
+    appended to destination with TBM_append_rows. Deleted rows don't migrate.
     Note: Before migration dst table should have structure, with columns that has size greater or equal size.
     Note 2: querry should store structure navigation for migration with indexes of columns. Like:
     src index | dst index | src index | dst index 
+    Note 3: With OpenMP, pages of source directory loaded and converted in parallel. Rows order is same.
 
     Params:
     - src - Source table for migration.
@@ -471,14 +788,28 @@
     - querry - Navigation array (Check notes).
     - querry_size - Size of navigation array.
 
+    Return -3 if rows can't be appended to destination.
     Return -2 if was allocation error.
     Return -1 if was lock error.
     Return 1 if migration success.
     */
     int TBM_migrate_table(table_t* __restrict src, table_t* __restrict dst, char* __restrict querry[], size_t querry_size);
 
+    /*
+    Check if table has module columns, that invoked at provided stage.
+
+    Params:
+    - table - Pointer to table.
+    - type - COLUMN_MODULE_PRELOAD or COLUMN_MODULE_POSTLOAD.
+
+    Return 1 if table has modules for this stage.
+    Return 0 if table hasn't modules.
+    */
+    int TBM_has_modules(table_t* table, unsigned char type);
+
     /*
     Invoke modules in table and change input data.
+    Note: Modules loaded once and cached by name (Check MDL_launch_module).
 
     Params:
     - table - Pointer to table.
@@ -489,6 +820,25 @@
     */
     int TBM_invoke_modules(table_t* __restrict table, unsigned char* __restrict data, unsigned char type);
 
+    /*
+    Invoke modules for several text rows. Every module launched once per batch (Check MDL_launch_batch),
+    that's why module worker get all rows in one round trip.
+
+    Params:
+    - table - Pointer to table.
+    - data - Text rows (count * table->text_size bytes).
+    - count - Count of rows.
+    - type - Addition params.
+    - columns - Column flags (One byte per column). Only modules of flagged columns invoked.
+                Provide NULL for invoke of all modules.
+
+    Return -1 if something goes wrong.
+    Return 1 if success.
+    */
+    int TBM_invoke_modules_rows(
+        table_t* __restrict table, unsigned char* __restrict data, int count, unsigned char type, unsigned char* __restrict columns
+    );
+
 #pragma endregion
 
 #endif
@@ -2,10 +2,14 @@
 // - tcc hash.c -o hash.mdl -lssl -lcrypto
 // MacOS: brew install openssh
 // - gcc-14 hash.c -o hash.mdl -I$(brew --prefix openssl)/include -L$(brew --prefix openssl)/lib -lssl -lcrypto
+// Shared object (Loaded once, without process per row):
+// - gcc -shared -fPIC hash.c -o hash.mdl -lssl -lcrypto
+// Executable module works as batch worker (Started once, rows streamed by pipes).
 #include <openssl/sha.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "../worker.h"
 
 
 char* hash_string(const char* input, size_t output_size) {
@@ -28,7 +32,21 @@ char* hash_string(const char* input, size_t output_size) {
     return output;
 }
 
+int mdl_invoke(char* args, unsigned char* in, unsigned char* out, size_t size) {
+    char input[256] = { 0 };
+    if (sscanf(args, "%255s", input) != 1) return 1;
+
+    char* hash_result = hash_string(input, size + 1);
+    if (!hash_result) return 3;
+
+    strncpy((char*)out, hash_result, size);
+    free(hash_result);
+
+    return 100;
+}
+
 int main(int argc, char* argv[]) {
+    if (argc == 2 && !strcmp(argv[1], MDL_WORKER_ARG)) return mdl_worker_loop(mdl_invoke);
     if (argc != 3) return 1;
 
     char* hash_result = hash_string(argv[1], atoi_s(argv[2]));
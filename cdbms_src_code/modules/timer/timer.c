@@ -1,14 +1,17 @@
 // tss timer.c -o timer.mdl
+// Shared object (Loaded once, without process per row): gcc -shared -fPIC timer.c -o timer.mdl
 #include <time.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include "../worker.h"
 
 
 #define NOW "now"
 
 
 char* get_current_time();
+int mdl_invoke(char* args, unsigned char* in, unsigned char* out, size_t size);
 int main(int argc, char* argv[]);
 
 
@@ -24,7 +27,17 @@ char* get_current_time() {
     return time_str;
 }
 
+int mdl_invoke(char* args, unsigned char* in, unsigned char* out, size_t size) {
+    if (strncmp(args, NOW, strlen(NOW)) == 0) {
+        strncpy((char*)out, get_current_time(), size);
+        return 100;
+    }
+
+    return 2;
+}
+
 int main(int argc, char* argv[]) {
+    if (argc == 2 && !strcmp(argv[1], MDL_WORKER_ARG)) return mdl_worker_loop(mdl_invoke);
     if (argc != 2) exit(1);
     if (strcmp_s(argv[1], NOW) == 0) {
         printf("%s", get_current_time());
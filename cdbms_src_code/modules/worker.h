@@ -0,0 +1,89 @@
+// Worker mode for executable modules. Worker started once by cdbms and get rows in batches
+// (Check MODULE_WORKER_ARG in include/module.h). Usage in module main:
+// - if (argc == 2 && !strcmp(argv[1], MDL_WORKER_ARG)) return mdl_worker_loop(mdl_invoke);
+#ifndef MDL_WORKER_H_
+#define MDL_WORKER_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define MDL_WORKER_ARG      "--worker"
+#define MDL_WORKER_MAGIC    0x574C444D
+
+
+typedef struct {
+    char* args;
+    unsigned char* in;
+    unsigned int size;
+} mdl_request_t;
+
+
+static void mdl_free_batch(mdl_request_t* batch, unsigned int count) {
+    for (unsigned int i = 0; i < count; i++) {
+        free(batch[i].args);
+        free(batch[i].in);
+    }
+
+    free(batch);
+}
+
+/*
+Read batches from stdin and write answers to stdout until cdbms close pipe.
+Whole batch readed before answer.
+
+Return 0 if pipe closed.
+Return 1 if batch broken.
+*/
+static int mdl_worker_loop(int (*invoke)(char*, unsigned char*, unsigned char*, size_t)) {
+    unsigned int magic = MDL_WORKER_MAGIC;
+    fwrite(&magic, sizeof(magic), 1, stdout);
+    fflush(stdout);
+
+    unsigned int count = 0;
+    while (fread(&count, sizeof(count), 1, stdin) == 1) {
+        mdl_request_t* batch = (mdl_request_t*)calloc(count, sizeof(mdl_request_t));
+        if (!batch) return 1;
+
+        for (unsigned int i = 0; i < count; i++) {
+            unsigned int header[2] = { 0 };
+            if (fread(header, sizeof(header), 1, stdin) != 1) {
+                mdl_free_batch(batch, count);
+                return 1;
+            }
+
+            batch[i].size = header[1];
+            batch[i].args = (char*)calloc(header[0] + 1, 1);
+            batch[i].in   = (unsigned char*)malloc(header[1] + 1);
+            if (
+                !batch[i].args || !batch[i].in ||
+                fread(batch[i].args, 1, header[0], stdin) != header[0] ||
+                fread(batch[i].in, 1, header[1], stdin) != header[1]
+            ) {
+                mdl_free_batch(batch, count);
+                return 1;
+            }
+        }
+
+        for (unsigned int i = 0; i < count; i++) {
+            unsigned char* out = (unsigned char*)calloc(batch[i].size + 1, 1);
+            int answer[2] = { 1, 0 };
+            if (out) {
+                answer[0] = invoke(batch[i].args, batch[i].in, out, batch[i].size);
+                answer[1] = (int)strlen((char*)out);
+            }
+
+            fwrite(answer, sizeof(answer), 1, stdout);
+            if (answer[1]) fwrite(out, 1, answer[1], stdout);
+            free(out);
+        }
+
+        fflush(stdout);
+        mdl_free_batch(batch, count);
+    }
+
+    return 0;
+}
+
+#endif
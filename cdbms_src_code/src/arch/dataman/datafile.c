@@ -28,6 +28,7 @@ int DB_delete_database(database_t* database, int full) {
         for (int i = 0; i < database->header->table_count; i++) {
             table_t* table = DB_get_table(database, database->table_names[i]);
             if (table == NULL) continue;
+            IND_delete_indexes(table);
             result = MIN(TBM_delete_table(table, full), result);
         }
     }
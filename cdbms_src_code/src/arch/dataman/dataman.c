@@ -20,14 +20,283 @@ static int _unlink_table_from_database(database_t* __restrict database, char* __
     return status;
 }
 
-static int _get_global_offset(int row_size, int row) {
-    int rows_per_page = PAGE_CONTENT_SIZE / row_size;
+static int _get_global_offset(int row_size, int page_size, int row) {
+    int rows_per_page = page_size / row_size;
     int pages_offset  = row / rows_per_page;
     int row_offset    = row % rows_per_page;
-    int global_offset = pages_offset * PAGE_CONTENT_SIZE + row_offset * row_size;
+    int global_offset = pages_offset * page_size + row_offset * row_size;
     return global_offset;
 }
 
+/*
+Inverse of _get_global_offset. Rows don't cross page border, that's why
+we can't divide global offset by row size directly.
+*/
+static int _get_row_index(int row_size, int page_size, int global_offset) {
+    int rows_per_page = page_size / row_size;
+    return (global_offset / page_size) * rows_per_page + (global_offset % page_size) / row_size;
+}
+
+/*
+Check if table has indexed columns. Tables without indexes don't read old rows before update.
+*/
+static int _has_indexes(table_t* table) {
+    for (int i = 0; i < table->header->column_count; i++) {
+        if (IS_COLUMN_INDEXED(table->columns[i]->type)) return 1;
+    }
+
+    return 0;
+}
+
+/*
+Read stored row without modules invoke.
+Note: Free row after use.
+
+Return NULL if row not found or deleted.
+Return pointer to row data.
+*/
+static unsigned char* _read_row(table_t* table, int row) {
+    unsigned char* row_data = (unsigned char*)malloc_s(table->row_size);
+    if (!row_data) return NULL;
+    if (
+        !TBM_get_content(table, _get_global_offset(table->row_size, table->header->page_size, row), row_data, table->row_size) || 
+        *row_data == PAGE_EMPTY
+    ) {
+        free_s(row_data);
+        return NULL;
+    }
+
+    return row_data;
+}
+
+/*
+Fill index with table rows. Table readed page by page, because rows don't cross page border.
+
+Return -1 if something goes wrong.
+Return count of indexed rows.
+*/
+static int _build_index(table_t* __restrict table, index_t* __restrict index) {
+    int page_size = (int)table->header->page_size;
+    int rows_per_page = page_size / table->row_size;
+    unsigned char* content = (unsigned char*)malloc_s(page_size);
+    unsigned char* key = (unsigned char*)malloc_s(index->header->key_size);
+    if (!content || !key) {
+        SOFT_FREE(content);
+        SOFT_FREE(key);
+        return -1;
+    }
+
+    int count = 0;
+    for (int page = 0; count >= 0; page++) {
+        str_memset(content, PAGE_EMPTY, page_size);
+        if (!TBM_get_content(table, page * page_size, content, page_size)) break;
+        for (int i = 0; i < rows_per_page; i++) {
+            unsigned char* row_data = content + i * table->row_size;
+            if (*row_data == PAGE_EMPTY) continue;
+            if (IND_make_row_key(index, row_data, key) != 1) continue;
+            if (IND_insert_key(index, key, page * rows_per_page + i) != 1) {
+                count = -1;
+                break;
+            }
+
+            count++;
+        }
+    }
+
+    free_s(content);
+    free_s(key);
+    return count;
+}
+
+/*
+Get primary column of table.
+
+Return -1 if table hasn't primary column.
+Return column index.
+*/
+static int _get_primary_column(table_t* table) {
+    for (int i = 0; i < table->header->column_count; i++) {
+        if (GET_COLUMN_PRIMARY(table->columns[i]->type) == COLUMN_PRIMARY) return i;
+    }
+
+    return -1;
+}
+
+/*
+Load hash index of primary column.
+
+Return NULL if column hasn't hash index (Use DB_find_data_row).
+Return pointer to index.
+*/
+static index_t* _load_primary_index(table_t* table, int column) {
+    if (column < 0 || GET_COLUMN_INDEX(table->columns[column]->type) != COLUMN_INDEX_HASH) return NULL;
+    return IND_load_index(table, column);
+}
+
+/*
+Find row with primary value by hash index of primary column. Index lookup read one bucket chain,
+that's why uniqueness check don't scan table.
+
+Return -2 if something goes wrong (Use DB_find_data_row).
+Return -1 if value not presented in table.
+Return row index.
+*/
+static int _find_primary_row(index_t* __restrict index, unsigned char* __restrict value, int value_size) {
+    int row = -2;
+    unsigned char* key = (unsigned char*)malloc_s(index->header->key_size);
+    if (key) {
+        int* rows = NULL;
+        int count = -1;
+        if (IND_make_key(index, value, value_size, key) == 1) {
+            count = IND_find_rows(index, INDEX_EQUALS, key, &rows);
+        }
+
+        if (count >= 0) row = count > 0 ? rows[0] : -1;
+        SOFT_FREE(rows);
+        free_s(key);
+    }
+
+    return row;
+}
+
+/*
+Check primary value of row in table.
+
+Return 1 if value already presented in table.
+Return 0 if value uniqe.
+*/
+static int _is_primary_presented(
+    database_t* __restrict database, char* __restrict table_name, table_t* __restrict table,
+    index_t* __restrict index, int column, unsigned char* __restrict data
+) {
+    table_columns_info_t primary_info;
+    TBM_get_column_info(table, table->columns[column]->name, &primary_info);
+    int row = index ? _find_primary_row(index, data + primary_info.offset, primary_info.size) : -2;
+    if (row == -2) {
+        row = DB_find_data_row(
+            database, table_name, table->columns[column]->name, 0, data + primary_info.offset, primary_info.size
+        );
+    }
+
+    return row >= 0;
+}
+
+/*
+Check if column is auto increment int column.
+
+Return 1 if column filled by _fill_increments.
+Return 0 if column filled by user.
+*/
+static int _is_increment_column(table_t* table, int column) {
+    return (
+        GET_COLUMN_TYPE(table->columns[column]->type) == COLUMN_AUTO_INCREMENT && 
+        GET_COLUMN_DATA_TYPE(table->columns[column]->type) == COLUMN_TYPE_INT
+    );
+}
+
+/*
+Find max value of column in live rows. Table readed page by page like in _build_index.
+Note: Rows don't have append order (Insert and compact reuse free places), that's why last row can't be used.
+
+Return max value (Zero if table hasn't live rows).
+*/
+static unsigned long long _find_max_value(table_t* table, int column) {
+    table_columns_info_t info;
+    TBM_get_column_info(table, table->columns[column]->name, &info);
+
+    int page_size = (int)table->header->page_size;
+    int rows_per_page = page_size / table->row_size;
+    unsigned char* content = (unsigned char*)malloc_s(page_size);
+    if (!content) return 0;
+
+    long long max_value = 0;
+    for (int page = 0; ; page++) {
+        str_memset(content, PAGE_EMPTY, page_size);
+        if (!TBM_get_content(table, page * page_size, content, page_size)) break;
+        for (int i = 0; i < rows_per_page; i++) {
+            unsigned char* row_data = content + i * table->row_size;
+            if (*row_data == PAGE_EMPTY) continue;
+
+            long long value = 0;
+            unsigned char* value_data = row_data + info.offset;
+            if (!GET_COLUMN_BINARY(table->columns[column]->type)) value = str_atoll((char*)value_data, info.size);
+            else if (info.size == sizeof(int)) {
+                int short_value = 0;
+                str_memcpy(&short_value, value_data, sizeof(int));
+                value = short_value;
+            }
+            else str_memcpy(&value, value_data, sizeof(long long));
+            max_value = MAX(max_value, value);
+        }
+    }
+
+    free_s(content);
+    return (unsigned long long)max_value;
+}
+
+/*
+Get next auto increment value. Counter saved in table header, that's why append don't read previous rows.
+Note: Migrated tables have zero counter. It seeded once from max value of live rows at first append.
+*/
+static unsigned long long _next_increment(table_t* table, int column) {
+    if (!table->header->increment && table->header->row_count > 0) {
+        #pragma omp critical (increment_seed)
+        {
+            if (!table->header->increment) table->header->increment = _find_max_value(table, column);
+        }
+    }
+
+    unsigned long long value = 0;
+    #pragma omp atomic capture
+    value = ++table->header->increment;
+    return value;
+}
+
+/*
+Fill auto increment columns of row. Auto increment columns of one row share one counter value.
+Note: Call it after primary check, that's why rejected rows don't take values from counter.
+*/
+static void _fill_increments(table_t* __restrict table, unsigned char* __restrict data) {
+    int column_offset = 0;
+    unsigned long long increment = 0;
+    for (int i = 0; i < table->header->column_count; i++) { // O(n)
+        unsigned char* current_data = data + column_offset;
+        if (_is_increment_column(table, i)) {
+            if (!increment) increment = _next_increment(table, i);
+
+            // Value padded by zeros to column size. If value larger than column, low digits saved.
+            char buffer[32] = { 0 };
+            int size = table->columns[i]->size;
+            int length = sprintf(buffer, "%llu", increment);
+            str_memset(current_data, '0', size);
+            str_memcpy(current_data + MAX(size - length, 0), buffer + MAX(length - size, 0), MIN(length, size));
+        }
+
+        column_offset += table->columns[i]->size;
+    }
+}
+
+/*
+Check primary value in rows of current batch. Set is open addressing table with
+row positions (Position + 1, zero is empty place). Set size should be power of two.
+
+Return 1 if value already presented in batch.
+Return 0 if row added to set.
+*/
+static int _batch_contains(
+    int* __restrict set, int set_size, unsigned char* __restrict rows, int row_size, int value_offset, int value_size, int position
+) {
+    unsigned char* value = rows + position * row_size + value_offset;
+    unsigned int place = checksum_memory(DBMS_CHECKSUM, value, value_size, 0) & (set_size - 1);
+    while (set[place]) {
+        if (!str_memcmp(rows + (set[place] - 1) * row_size + value_offset, value, value_size)) return 1;
+        place = (place + 1) & (set_size - 1);
+    }
+
+    set[place] = position + 1;
+    return 0;
+}
+
 #pragma region [CRUD]
 
 int DB_append_row(
@@ -36,7 +305,7 @@ int DB_append_row(
 ) {
     table_t* table = DB_get_table(database, table_name);
     if (!table) return -4;
-    if (table->row_size > data_size) {
+    if (table->text_size > data_size) {
         TBM_flush_table(table);
         return -5;
     }
@@ -47,58 +316,135 @@ int DB_append_row(
         return result - 10;
     }
 
-    // Get primary column and column offset
-    int column_offset = 0;
-    table_column_t* primary_column = NULL;
-    for (int i = 0; i < table->header->column_count; i++) { // O(n)
-        if (GET_COLUMN_PRIMARY(table->columns[i]->type) == COLUMN_PRIMARY) {
-            primary_column = table->columns[i];
+    unsigned char* row_data = (unsigned char*)malloc_s(table->row_size);
+    if (!row_data) {
+        TBM_flush_table(table);
+        return -1;
+    }
+
+    // Increments filled after primary check. Primary increment column filled before, because check needs value.
+    int primary = _get_primary_column(table);
+    int primary_increment = primary >= 0 && _is_increment_column(table, primary);
+    if (primary_increment) _fill_increments(table, data);
+    TBM_encode_row(table, data, row_data);
+
+    // If in provided table presented primary column
+    if (primary >= 0) {
+        index_t* primary_index = _load_primary_index(table, primary);
+        int presented = _is_primary_presented(database, table_name, table, primary_index, primary, row_data);
+        if (primary_index) IND_flush_index(primary_index);
+
+        // If in table already presented this value.
+        // That means, that this data not uniqe.
+        if (presented) {
+            free_s(row_data);
+            TBM_flush_table(table);
+            return -20;
         }
+    }
 
-        unsigned char* current_data = data + column_offset;
-        if (
-            GET_COLUMN_TYPE(table->columns[i]->type) == COLUMN_AUTO_INCREMENT && 
-            GET_COLUMN_DATA_TYPE(table->columns[i]->type) == COLUMN_TYPE_INT
-        ) {
-            unsigned char* previous_data = (unsigned char*)malloc_s(table->row_size);
-            if (previous_data != NULL) {
-                if (DB_get_row(database, table_name, MAX(table->header->row_count - 1, 0), previous_data, table->row_size)) {
-                    char number_buffer[128] = { 0 };
-                    str_strncpy(number_buffer, (char*)(previous_data + column_offset), table->columns[i]->size);
+    // Modules work with text row, that's why row encoded again
+    if (!primary_increment) _fill_increments(table, data);
+    TBM_invoke_modules(table, data, COLUMN_MODULE_PRELOAD); // O(n)
+    TBM_encode_row(table, data, row_data);
+    result = TBM_append_content(table, row_data, table->row_size);
+    if (result >= 0) {
+        IND_update_row(table, NULL, row_data, _get_row_index(table->row_size, table->header->page_size, table->last_append));
+        table->header->row_count++;
+    }
 
-                    char buffer[128] = { 0 };
-                    sprintf(buffer, "%0*d", table->columns[i]->size, atoi_s(number_buffer) + 1);
+    free_s(row_data);
+    TBM_flush_table(table);
+    return result;
+}
 
-                    str_memset(current_data, buffer, table->columns[i]->size);
-                }
+int DB_append_rows(
+    database_t* __restrict database, char* __restrict table_name, 
+    unsigned char* __restrict data, size_t data_size
+) {
+    table_t* table = DB_get_table(database, table_name);
+    if (!table) return -4;
+    if (!data_size || data_size % table->text_size) {
+        TBM_flush_table(table);
+        return -5;
+    }
 
-                free_s(previous_data);
-            }
+    // Whole batch validated before first write
+    int count = (int)(data_size / table->text_size);
+    for (int i = 0; i < count; i++) {
+        int result = TBM_check_signature(table, data + i * table->text_size);
+        if (result != 1) {
+            TBM_flush_table(table);
+            return result - 10;
         }
+    }
 
-        column_offset += table->columns[i]->size;
+    int set_size = 0;
+    int* batch_set = NULL;
+    index_t* primary_index = NULL;
+    table_columns_info_t primary_info;
+    int primary = _get_primary_column(table);
+    int primary_increment = primary >= 0 && _is_increment_column(table, primary);
+    if (primary >= 0) {
+        TBM_get_column_info(table, table->columns[primary]->name, &primary_info);
+        primary_index = _load_primary_index(table, primary);
+        for (set_size = 1; set_size < count * 2; set_size <<= 1);
+        batch_set = (int*)malloc_s(set_size * sizeof(int));
+        if (batch_set) str_memset(batch_set, 0, set_size * sizeof(int));
     }
 
-    // If in provided table presented primary column
-    if (primary_column != NULL) {
-        table_columns_info_t primary_info;
-        TBM_get_column_info(table, primary_column->name, &primary_info);
-        int row = DB_find_data_row(
-            database, table_name, primary_column->name, 0, data + primary_info.offset, primary_column->size
-        );
+    int* offsets = (int*)malloc_s(count * sizeof(int));
+    unsigned char* rows = (unsigned char*)malloc_s(count * table->row_size);
+    if (!offsets || !rows || (primary >= 0 && !batch_set)) {
+        SOFT_FREE(offsets);
+        SOFT_FREE(rows);
+        SOFT_FREE(batch_set);
+        if (primary_index) IND_flush_index(primary_index);
+        TBM_flush_table(table);
+        return -1;
+    }
 
-        // If in table already presented this value.
-        // That means, that this data not uniqe.
-        if (row >= 0) {
-            TBM_flush_table(table);
-            return -20;
+    // Rows with presented primary value skipped. Accepted text rows moved to buffer start.
+    // Increments filled only for accepted rows (Primary increment column filled before check).
+    int accepted = 0;
+    for (int i = 0; i < count; i++) {
+        unsigned char* text_data = data + i * table->text_size;
+        unsigned char* row_data  = rows + accepted * table->row_size;
+        if (primary_increment) _fill_increments(table, text_data);
+        TBM_encode_row(table, text_data, row_data);
+        if (primary >= 0 && _is_primary_presented(database, table_name, table, primary_index, primary, row_data)) continue;
+        if (
+            primary >= 0 && 
+            _batch_contains(batch_set, set_size, rows, table->row_size, primary_info.offset, primary_info.size, accepted)
+        ) continue;
+
+        if (!primary_increment) {
+            _fill_increments(table, text_data);
+            TBM_encode_row(table, text_data, row_data);
         }
+
+        if (accepted != i) str_memcpy(data + accepted * table->text_size, text_data, table->text_size);
+        accepted++;
     }
 
-    TBM_invoke_modules(table, data, COLUMN_MODULE_PRELOAD); // O(n)
-    result = TBM_append_content(table, data, data_size);
+    SOFT_FREE(batch_set);
+    if (primary_index) IND_flush_index(primary_index);
 
-    table->header->row_count++;
+    // Modules invoked once per batch (One worker round trip), rows encoded again after modules
+    if (TBM_has_modules(table, COLUMN_MODULE_PRELOAD)) {
+        TBM_invoke_modules_rows(table, data, accepted, COLUMN_MODULE_PRELOAD, NULL);
+        for (int i = 0; i < accepted; i++) TBM_encode_row(table, data + i * table->text_size, rows + i * table->row_size);
+    }
+
+    int result = accepted ? TBM_append_rows(table, rows, accepted, offsets) : 0;
+    if (result > 0) {
+        for (int i = 0; i < result; i++) offsets[i] = _get_row_index(table->row_size, table->header->page_size, offsets[i]);
+        IND_append_rows(table, rows, result, offsets);
+        table->header->row_count += result;
+    }
+
+    free_s(rows);
+    free_s(offsets);
     TBM_flush_table(table);
     return result;
 }
@@ -110,15 +456,37 @@ int DB_get_row(
     table_t* table = DB_get_table(database, table_name);
     if (!table) return 0;
 
-    int get_result = TBM_get_content(table, _get_global_offset(table->row_size, row), buffer, buffer_size);
-    if (get_result) {
-        TBM_invoke_modules(table, buffer, COLUMN_MODULE_POSTLOAD);
+    // Stored row and text row placed in one buffer
+    int get_result = 0;
+    unsigned char* row_data = (unsigned char*)malloc_s(table->row_size + table->text_size);
+    if (row_data) {
+        unsigned char* text_data = row_data + table->row_size;
+        if (TBM_get_content(table, _get_global_offset(table->row_size, table->header->page_size, row), row_data, table->row_size)) {
+            TBM_decode_row(table, row_data, text_data);
+            TBM_invoke_modules(table, text_data, COLUMN_MODULE_POSTLOAD);
+            get_result = MIN((int)buffer_size, table->text_size);
+            str_memcpy(buffer, text_data, get_result);
+        }
+
+        free_s(row_data);
     }
 
     TBM_flush_table(table);
     return get_result;
 }
 
+int DB_read_row(
+    database_t* __restrict database, char* __restrict table_name, int row, 
+    unsigned char* buffer, size_t buffer_size
+) {
+    table_t* table = DB_get_table(database, table_name);
+    if (!table) return 0;
+
+    int get_result = TBM_get_content(table, _get_global_offset(table->row_size, table->header->page_size, row), buffer, buffer_size);
+    TBM_flush_table(table);
+    return get_result;
+}
+
 int DB_insert_row(
     database_t* __restrict database, char* __restrict table_name, 
     int row, unsigned char* __restrict data, size_t data_size
@@ -126,7 +494,7 @@ int DB_insert_row(
 #ifndef NO_UPDATE_COMMAND
     table_t* table = DB_get_table(database, table_name);
     if (!table) return -1;
-    if (table->row_size > data_size) {
+    if (table->text_size > data_size) {
         TBM_flush_table(table);
         return -5;
     }
@@ -137,12 +505,27 @@ int DB_insert_row(
         return result - 10;
     }
 
+    unsigned char* row_data = (unsigned char*)malloc_s(table->row_size);
+    if (!row_data) {
+        TBM_flush_table(table);
+        return -1;
+    }
+
     TBM_invoke_modules(table, data, COLUMN_MODULE_PRELOAD);
+    TBM_encode_row(table, data, row_data);
+
+    // Indexes updated only after confirmed write. Otherwise index and stored rows will differ.
+    result = -1;
     if (THR_require_write(&table->lock, get_thread_num())) {
-        result = TBM_insert_content(table, _get_global_offset(table->row_size, row), data, data_size);
+        int indexed = _has_indexes(table);
+        unsigned char* old_data = indexed ? _read_row(table, row) : NULL;
+        result = TBM_insert_content(table, _get_global_offset(table->row_size, table->header->page_size, row), row_data, table->row_size);
+        if (indexed && result > 0) IND_update_row(table, old_data, row_data, row);
+        SOFT_FREE(old_data);
         THR_release_write(&table->lock, get_thread_num());
     }
 
+    free_s(row_data);
     TBM_flush_table(table);
     return result;
 #endif
@@ -156,7 +539,10 @@ int DB_delete_row(database_t* __restrict database, char* __restrict table_name,
 
     int result = -1;
     if (THR_require_write(&table->lock, get_thread_num())) {
-        result = TBM_delete_content(table, _get_global_offset(table->row_size, row), table->row_size);
+        unsigned char* old_data = _has_indexes(table) ? _read_row(table, row) : NULL;
+        result = TBM_delete_content(table, _get_global_offset(table->row_size, table->header->page_size, row), table->row_size);
+        if (old_data && result >= 0) IND_update_row(table, old_data, NULL, row);
+        SOFT_FREE(old_data);
         THR_release_write(&table->lock, get_thread_num());
     }
 
@@ -169,19 +555,120 @@ int DB_delete_row(database_t* __restrict database, char* __restrict table_name,
 
 #pragma endregion
 
+#pragma region [Index]
+
+int DB_create_index(database_t* __restrict database, char* __restrict table_name, char* __restrict column_name) {
+#ifndef NO_CREATE_COMMAND
+    table_t* table = DB_get_table(database, table_name);
+    if (!table) return -4;
+
+    table_columns_info_t col_info;
+    TBM_get_column_info(table, column_name, &col_info);
+    if (col_info.index < 0) {
+        TBM_flush_table(table);
+        return -2;
+    }
+
+    // Column keeps existed index. Primary hash index used by append, and Bloom filter can't be replaced by B+tree.
+    table_column_t* column = table->columns[col_info.index];
+    if (GET_COLUMN_INDEX(column->type)) {
+        TBM_flush_table(table);
+        return -3;
+    }
+
+    int status = -1;
+    if (THR_require_write(&table->lock, get_thread_num())) {
+        index_t* index = IND_create_index(table, col_info.index);
+        if (index) {
+            // Column marked as indexed only after index build. Otherwise appends will use broken index.
+            if (_build_index(table, index) >= 0) {
+                column->type = SET_COLUMN_INDEX(column->type, COLUMN_INDEX_BTREE);
+                status = 1;
+            }
+
+            IND_free_index(index);
+            if (status != 1) IND_delete_index(table, col_info.index);
+        }
+
+        THR_release_write(&table->lock, get_thread_num());
+    }
+
+    TBM_flush_table(table);
+    return status;
+#endif
+    return 1;
+}
+
+int DB_rebuild_indexes(table_t* table) {
+    int rebuilt = 0;
+    for (int i = 0; i < table->header->column_count; i++) {
+        if (!IS_COLUMN_INDEXED(table->columns[i]->type)) continue;
+        index_t* index = IND_create_index(table, i);
+        if (!index) continue;
+        if (_build_index(table, index) >= 0) rebuilt++;
+        IND_free_index(index);
+    }
+
+    return rebuilt;
+}
+
+#pragma endregion
+
 int DB_cleanup_tables(database_t* database) {
 #ifndef NO_DELETE_COMMAND
-    #pragma omp parallel for schedule(dynamic, 1)
+    // Tables loaded through GCT, that's why tables cleaned one by one (Check TBM_cleanup_dirs).
     for (int i = 0; i < database->header->table_count; i++) {
         table_t* table = DB_get_table(database, database->table_names[i]);
         if (!table) continue;
-        TBM_cleanup_dirs(table);
+        if (TBM_cleanup_dirs(table) > 0 && _has_indexes(table)) DB_rebuild_indexes(table);
         TBM_flush_table(table);
     }
 #endif
     return 1;
 }
 
+/*
+Find row with exact column value. Pages, that can't contain value, skipped by Bloom filter of column.
+
+Return -2 if something goes wrong.
+Return -1 if value not presented in table.
+Return row index.
+*/
+static int _find_bloom_row(
+    table_t* __restrict table, table_columns_info_t* __restrict col_info, zone_filter_t* __restrict filter,
+    int offset, unsigned char* __restrict data
+) {
+    // Pages, that can contain value, readed whole like in _build_index. Rows compared in page buffer.
+    int page_size = (int)table->header->page_size;
+    int rows_per_page = page_size / table->row_size;
+    unsigned char* content = (unsigned char*)malloc_s(page_size);
+    if (!content) return -2;
+
+    int answer = -1, skipped_pages = 0;
+    int row = _get_row_index(table->row_size, page_size, offset);
+    for (int page = row / rows_per_page; answer == -1; page++) {
+        int skip = TBM_skip_pages(table, page, filter, 1);
+        if (skip > 0) {
+            page += skip;
+            skipped_pages += skip;
+        }
+
+        str_memset(content, PAGE_EMPTY, page_size);
+        if (!TBM_get_content(table, page * page_size, content, page_size)) break;
+        for (int i = MAX(row - page * rows_per_page, 0); i < rows_per_page; i++) {
+            unsigned char* row_data = content + i * table->row_size;
+            if (*row_data != PAGE_EMPTY && !str_memcmp(row_data + col_info->offset, data, col_info->size)) {
+                answer = page * rows_per_page + i;
+                break;
+            }
+        }
+    }
+
+    if (skipped_pages) print_debug("Bloom filter skipped [%i] pages of table [%.*s]", skipped_pages, TABLE_NAME_SIZE, table->header->name);
+    free_s(content);
+    return answer;
+}
+
 int DB_find_data_row(
     database_t* __restrict database, char* __restrict table_name, 
     char* __restrict column, int offset, unsigned char* __restrict data, size_t data_size
@@ -194,18 +681,30 @@ int DB_find_data_row(
 
     int answer = -1;
     if (THR_require_read(&table->lock)) {
+        // Whole column value can be checked by Bloom filter. In this case we compare columns, not search substring.
+        zone_filter_t filter;
+        if (
+            col_info.index >= 0 && (int)data_size == col_info.size &&
+            TBM_make_bloom_filter(table, col_info.index, ZONE_MATCH, data, (int)data_size, &filter) == 1
+        ) {
+            answer = _find_bloom_row(table, &col_info, &filter, offset, data);
+            TBM_flush_table(table);
+            THR_release_read(&table->lock);
+            return answer;
+        }
+
         while (1) {
             int global_offset = TBM_find_content(table, offset, data, data_size);
             TBM_flush_table(table);
             if (global_offset < 0) break;
 
-            int row = global_offset / table->row_size;
+            int row = _get_row_index(table->row_size, table->header->page_size, global_offset);
             if (col_info.offset == -1 && col_info.size == -1) {
                 answer = row;
                 break;
             }
 
-            int position_in_row = global_offset % table->row_size;
+            int position_in_row = (global_offset % (int)table->header->page_size) % table->row_size;
             if (position_in_row >= col_info.offset && position_in_row < col_info.offset + col_info.size) {
                 answer = row;
                 break;
@@ -225,11 +724,10 @@ table_t* DB_get_table(database_t* __restrict database, char* __restrict table_na
     if (table_name == NULL) return NULL;
 
     table_t* table = NULL;
-    #pragma omp parallel for schedule(dynamic, 1)
     for (int i = 0; i < database->header->table_count; i++) {
-        if (table) continue;
         if (strncmp_s(database->table_names[i], table_name, TABLE_NAME_SIZE) == 0) {
             table = TBM_load_table(table_name);
+            break;
         }
     }
 
@@ -244,6 +742,7 @@ int DB_delete_table(database_t* __restrict database, char* __restrict table_name
     if (!table) return -1;
 
     _unlink_table_from_database(database, table_name);
+    if (full) IND_delete_indexes(table);
     return TBM_delete_table(table, full);
 #endif
     return 1;
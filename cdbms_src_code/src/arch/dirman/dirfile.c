@@ -1,5 +1,33 @@
 #include <dirman.h>
 
+/*
+First directory header (DIRECTORY_BASE_MAGIC). Page names followed by end of file,
+directory of this layout don't have free space summary.
+*/
+typedef struct {
+    unsigned char magic;
+    char name[DIRECTORY_NAME_SIZE];
+    unsigned char page_count;
+    checksum_t checksum;
+} __attribute__((packed)) directory_base_header_t;
+
+/*
+Convert first header to current layout. Pages of this layout have default size
+and plain layout (Without slots and compression).
+*/
+static int _migrate_base_header(decoded_t* encoded_header, directory_header_t* header) {
+    directory_base_header_t base;
+    unpack_memory(encoded_header, (byte_t*)&base, sizeof(directory_base_header_t));
+
+    str_memset(header, 0, sizeof(directory_header_t));
+    header->magic         = DIRECTORY_MAGIC;
+    str_memcpy(header->name, base.name, DIRECTORY_NAME_SIZE);
+    header->page_count    = base.page_count;
+    header->page_size     = PAGE_CONTENT_SIZE;
+    header->checksum_type = CHECKSUM_MURMUR3;
+    return sizeof(directory_base_header_t) * sizeof(decoded_t);
+}
+
 directory_t* DRM_create_directory(char* name) {
     directory_t* directory = (directory_t*)malloc_s(sizeof(directory_t));
     directory_header_t* header = (directory_header_t*)malloc_s(sizeof(directory_header_t));
@@ -14,6 +42,8 @@ directory_t* DRM_create_directory(char* name) {
 
     str_strncpy(header->name, name, DIRECTORY_NAME_SIZE);
     header->magic = DIRECTORY_MAGIC;
+    header->page_size = PAGE_CONTENT_SIZE;
+    header->checksum_type = DBMS_CHECKSUM;
 
     directory->lock = NULL_LOCK;
     directory->header = header;
@@ -62,6 +92,45 @@ int DRM_save_directory(directory_t* directory) {
                 offset += PAGE_NAME_SIZE * sizeof(unsigned short);
             }
 
+            int free_size = directory->header->page_count * sizeof(unsigned int);
+            unsigned short encoded_page_free[sizeof(directory->page_free)] = { 0 };
+            pack_memory((byte_t*)directory->page_free, (decoded_t*)encoded_page_free, free_size);
+            if (status == 1 && NIFAT32_write_buffer2content(
+                ci, offset, (const_buffer_t)encoded_page_free, free_size * sizeof(decoded_t)
+            ) != free_size * (int)sizeof(decoded_t)) status = -2;
+            offset += free_size * sizeof(decoded_t);
+
+            if (directory->header->zone_count) {
+                int zones_size = directory->header->page_count * sizeof(directory->page_zones[0]);
+                unsigned short encoded_page_zones[sizeof(directory->page_zones)] = { 0 };
+                pack_memory((byte_t*)directory->page_zones, (decoded_t*)encoded_page_zones, zones_size);
+                if (status == 1 && NIFAT32_write_buffer2content(
+                    ci, offset, (const_buffer_t)encoded_page_zones, zones_size * sizeof(decoded_t)
+                ) != zones_size * (int)sizeof(decoded_t)) status = -2;
+                offset += zones_size * sizeof(decoded_t);
+            }
+
+            if (directory->header->bloom_count && directory->page_blooms) {
+                int stale_size = directory->header->page_count;
+                unsigned short encoded_page_stale[sizeof(directory->page_stale)] = { 0 };
+                pack_memory((byte_t*)directory->page_stale, (decoded_t*)encoded_page_stale, stale_size);
+                if (status == 1 && NIFAT32_write_buffer2content(
+                    ci, offset, (const_buffer_t)encoded_page_stale, stale_size * sizeof(decoded_t)
+                ) != stale_size * (int)sizeof(decoded_t)) status = -2;
+                offset += stale_size * sizeof(decoded_t);
+
+                // Filters saved page by page, that's why encode buffer don't depend from page count.
+                int blooms_size = directory->header->bloom_count * directory->header->bloom_size;
+                for (int i = 0; i < directory->header->page_count; i++) {
+                    unsigned short encoded_page_blooms[DIRECTORY_BLOOM_COUNT * DIRECTORY_BLOOM_MAX] = { 0 };
+                    pack_memory((byte_t*)(directory->page_blooms + i * blooms_size), (decoded_t*)encoded_page_blooms, blooms_size);
+                    if (status == 1 && NIFAT32_write_buffer2content(
+                        ci, offset, (const_buffer_t)encoded_page_blooms, blooms_size * sizeof(decoded_t)
+                    ) != blooms_size * (int)sizeof(decoded_t)) status = -2;
+                    offset += blooms_size * sizeof(decoded_t);
+                }
+            }
+
             NIFAT32_close_content(ci);
         }
     }
@@ -87,19 +156,29 @@ directory_t* DRM_load_directory(char* name) {
         else {
             directory_header_t* header = (directory_header_t*)malloc_s(sizeof(directory_header_t));
             if (header) {
-                int offset = 0;
+                int offset = 0, has_free = 1;
                 str_memset(header, 0, sizeof(directory_header_t));
 
                 unsigned short encoded_header[sizeof(directory_header_t)] = { 0 };
-                NIFAT32_read_content2buffer(ci, offset, (const_buffer_t)encoded_header, sizeof(directory_header_t) * sizeof(unsigned short));
+                NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_header, sizeof(directory_header_t) * sizeof(unsigned short));
                 unpack_memory((unsigned short*)encoded_header, (unsigned char*)header, sizeof(directory_header_t));
                 offset += sizeof(directory_header_t) * sizeof(unsigned short);
+                if (header->magic == DIRECTORY_BASE_MAGIC) {
+                    print_warn("Directory [%s] has first header layout. Migrating...", load_path);
+                    offset = _migrate_base_header((decoded_t*)encoded_header, header);
+                    has_free = 0;
+                }
 
                 if (header->magic != DIRECTORY_MAGIC) {
                     print_error("Directory file wrong magic for [%s]", load_path);
                     free_s(header);
                     NIFAT32_close_content(ci);
                 } 
+                else if (header->page_size < PAGE_MIN_SIZE || header->page_size > PAGE_MAX_SIZE) {
+                    print_error("Directory file wrong page size for [%s]", load_path);
+                    free_s(header);
+                    NIFAT32_close_content(ci);
+                }
                 else {
                     directory_t* directory = (directory_t*)malloc_s(sizeof(directory_t));
                     if (!directory) free_s(header);
@@ -107,11 +186,59 @@ directory_t* DRM_load_directory(char* name) {
                         str_memset(directory, 0, sizeof(directory_t));
                         for (int i = 0; i < MIN(header->page_count, PAGES_PER_DIRECTORY); i++) {
                             unsigned short encoded_page_name[PAGE_NAME_SIZE] = { 0 };
-                            NIFAT32_read_content2buffer(ci, offset, (const_buffer_t)encoded_page_name, PAGE_NAME_SIZE * sizeof(unsigned short));
+                            NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_page_name, PAGE_NAME_SIZE * sizeof(unsigned short));
                             unpack_memory((unsigned short*)encoded_page_name, (unsigned char*)directory->page_names[i], PAGE_NAME_SIZE);
                             offset += PAGE_NAME_SIZE * sizeof(unsigned short);
                         }
 
+                        // Directory without summary marks all pages as free. Summary refreshed from page at first append.
+                        if (!has_free) {
+                            for (int i = 0; i < MIN(header->page_count, PAGES_PER_DIRECTORY); i++) directory->page_free[i] = header->page_size;
+                        }
+                        else {
+                            int free_size = MIN(header->page_count, PAGES_PER_DIRECTORY) * sizeof(unsigned int);
+                            unsigned short encoded_page_free[sizeof(directory->page_free)] = { 0 };
+                            NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_page_free, free_size * sizeof(unsigned short));
+                            unpack_memory((unsigned short*)encoded_page_free, (unsigned char*)directory->page_free, free_size);
+                            offset += free_size * sizeof(unsigned short);
+                        }
+
+                        header->zone_count = MIN(header->zone_count, DIRECTORY_ZONE_COUNT);
+                        if (header->zone_count) {
+                            int zones_size = MIN(header->page_count, PAGES_PER_DIRECTORY) * sizeof(directory->page_zones[0]);
+                            unsigned short encoded_page_zones[sizeof(directory->page_zones)] = { 0 };
+                            NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_page_zones, zones_size * sizeof(unsigned short));
+                            unpack_memory((unsigned short*)encoded_page_zones, (unsigned char*)directory->page_zones, zones_size);
+                            offset += zones_size * sizeof(unsigned short);
+                        }
+
+                        // Wrong filter layout disables filters. Pages without filters never skipped by them.
+                        if (
+                            header->bloom_count > DIRECTORY_BLOOM_COUNT || 
+                            header->bloom_size < DIRECTORY_BLOOM_MIN || header->bloom_size > DIRECTORY_BLOOM_MAX
+                        ) header->bloom_count = 0;
+
+                        if (header->bloom_count) {
+                            directory->page_blooms = (unsigned char*)malloc_s(PAGES_PER_DIRECTORY * header->bloom_count * header->bloom_size);
+                            if (!directory->page_blooms) header->bloom_count = 0;
+                            else {
+                                str_memset(directory->page_blooms, 0, PAGES_PER_DIRECTORY * header->bloom_count * header->bloom_size);
+                                int stale_size = MIN(header->page_count, PAGES_PER_DIRECTORY);
+                                unsigned short encoded_page_stale[sizeof(directory->page_stale)] = { 0 };
+                                NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_page_stale, stale_size * sizeof(unsigned short));
+                                unpack_memory((unsigned short*)encoded_page_stale, (unsigned char*)directory->page_stale, stale_size);
+                                offset += stale_size * sizeof(unsigned short);
+
+                                int blooms_size = header->bloom_count * header->bloom_size;
+                                for (int i = 0; i < stale_size; i++) {
+                                    unsigned short encoded_page_blooms[DIRECTORY_BLOOM_COUNT * DIRECTORY_BLOOM_MAX] = { 0 };
+                                    NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_page_blooms, blooms_size * sizeof(unsigned short));
+                                    unpack_memory((unsigned short*)encoded_page_blooms, directory->page_blooms + i * blooms_size, blooms_size);
+                                    offset += blooms_size * sizeof(unsigned short);
+                                }
+                            }
+                        }
+
                         NIFAT32_close_content(ci);
 
                         directory->lock   = NULL_LOCK;
@@ -168,6 +295,7 @@ int DRM_flush_directory(directory_t* directory) {
 
 int DRM_free_directory(directory_t* directory) {
     if (!directory) return -1;
+    SOFT_FREE(directory->page_blooms);
     SOFT_FREE(directory->header);
     SOFT_FREE(directory);
     return 1;
@@ -178,12 +306,27 @@ unsigned int DRM_get_checksum(directory_t* directory) {
     unsigned int prev_checksum = directory->header->checksum;
     directory->header->checksum = 0;
 
+    int algorithm = directory->header->checksum_type;
     unsigned int _checksum = 0;
     if (directory->header) {
-        _checksum = murmur3_x86_32((const unsigned char*)directory->header, sizeof(directory_header_t), 0);
+        _checksum = checksum_memory(algorithm, (const unsigned char*)directory->header, sizeof(directory_header_t), 0);
     }
 
+    // Only rows of existed pages hashed (Same with save). Rows after page_count can keep data of deleted pages.
     directory->header->checksum = prev_checksum;
-    _checksum = murmur3_x86_32((const unsigned char*)directory->page_names, sizeof(directory->page_names), 0);
+    int page_count = directory->header->page_count;
+    _checksum = checksum_memory(algorithm, (const unsigned char*)directory->page_names, page_count * PAGE_NAME_SIZE, _checksum);
+    _checksum = checksum_memory(algorithm, (const unsigned char*)directory->page_free, page_count * sizeof(directory->page_free[0]), _checksum);
+    if (directory->header->zone_count) {
+        _checksum = checksum_memory(algorithm, (const unsigned char*)directory->page_zones, page_count * sizeof(directory->page_zones[0]), _checksum);
+    }
+
+    if (directory->header->bloom_count && directory->page_blooms) {
+        _checksum = checksum_memory(algorithm, (const unsigned char*)directory->page_stale, page_count, _checksum);
+        _checksum = checksum_memory(
+            algorithm, directory->page_blooms, directory->header->page_count * directory->header->bloom_count * directory->header->bloom_size, _checksum
+        );
+    }
+
     return _checksum;
 }
@@ -1,16 +1,121 @@
 #include <dirman.h>
 
+/*
+Get bit of Bloom filter for one of key hashes (Double hashing).
+*/
+static unsigned int _get_bloom_bit(long long key, int hash, unsigned int bits) {
+    unsigned int first  = (unsigned int)key;
+    unsigned int second = (unsigned int)((unsigned long long)key >> 32) | 1;
+    return (first + hash * second) % bits;
+}
+
+/*
+Add keys of row to page zones (And page Bloom filters, if blooms is 1).
+*/
+static void _add_row_keys(directory_t* __restrict directory, int index, unsigned char* __restrict row, int blooms) {
+    directory_header_t* header = directory->header;
+    directory_zone_t* zones = directory->page_zones[index];
+    for (int i = 0; i < header->zone_count; i++) {
+        directory_zone_column_t* column = &header->zone_columns[i];
+        long long key = DRM_make_zone_key(column->type, row + column->offset, column->size);
+        zones[i].min = MIN(zones[i].min, key);
+        zones[i].max = MAX(zones[i].max, key);
+    }
+
+    if (!blooms || !directory->page_blooms) return;
+    unsigned char* filter = directory->page_blooms + index * header->bloom_count * header->bloom_size;
+    for (int i = 0; i < header->bloom_count; i++, filter += header->bloom_size) {
+        directory_zone_column_t* column = &header->bloom_columns[i];
+        long long key = DRM_make_bloom_key(column->type, row + column->offset, column->size);
+        for (int j = 0; j < BLOOM_HASH_COUNT; j++) {
+            unsigned int bit = _get_bloom_bit(key, j, header->bloom_size * 8);
+            filter[bit / 8] |= 1 << (bit % 8);
+        }
+    }
+}
+
+/*
+Recalculate zone keys of page (And Bloom filters, if blooms is 1).
+Rows placed with slot_size step, free and deleted rows skipped.
+*/
+static int _scan_page_keys(directory_t* __restrict directory, int index, page_t* __restrict page, int blooms) {
+    directory_header_t* header = directory->header;
+    blooms = blooms && header->bloom_count && directory->page_blooms;
+    if ((!header->zone_count && !blooms) || !header->slot_size) return 0;
+
+    directory_zone_t* zones = directory->page_zones[index];
+    for (int i = 0; i < header->zone_count; i++) {
+        zones[i].min = ZONE_KEY_MAX;
+        zones[i].max = ZONE_KEY_MIN;
+    }
+
+    if (blooms) {
+        str_memset(directory->page_blooms + index * header->bloom_count * header->bloom_size, 0, header->bloom_count * header->bloom_size);
+        directory->page_stale[index] = 0;
+    }
+
+    unsigned char* plain = PGM_get_plain(page);
+    for (int offset = 0; offset + header->slot_size <= PAGE_SIZE_OF(page); offset += header->slot_size) {
+        if (plain[offset] == PAGE_EMPTY) continue;
+        _add_row_keys(directory, index, plain + offset, blooms);
+    }
+
+    return 1;
+}
+
 static int _link_page2dir(directory_t* __restrict directory, page_t* __restrict page) {
+    directory->page_free[directory->header->page_count] = PGM_get_max_free_space(page);
+    _scan_page_keys(directory, directory->header->page_count, page, 1);
     str_strncpy(directory->page_names[directory->header->page_count++], page->header->name, PAGE_NAME_SIZE);
     return 1;
 }
 
+static int _update_page_free(directory_t* __restrict directory, int index, page_t* __restrict page) {
+    if (index < 0 || index >= directory->header->page_count) return -1;
+    directory->page_free[index] = PGM_get_max_free_space(page);
+    _scan_page_keys(directory, index, page, 1);
+    return 1;
+}
+
+/*
+Same with _update_page_free, but zones and Bloom filters extended by appended rows without page scan.
+Append can't narrow zones. Stale Bloom filters rebuilt here, because page already loaded.
+*/
+static int _update_page_append(directory_t* __restrict directory, int index, page_t* __restrict page, unsigned char* __restrict rows, int count) {
+    if (index < 0 || index >= directory->header->page_count) return -1;
+    directory->page_free[index] = PGM_get_max_free_space(page);
+    if (directory->header->bloom_count && directory->page_stale[index]) return _scan_page_keys(directory, index, page, 1);
+    if (!directory->header->slot_size) return 1;
+    for (int i = 0; i < count; i++) _add_row_keys(directory, index, rows + i * directory->header->slot_size, 1);
+    return 1;
+}
+
+/*
+Same with _update_page_free, but Bloom filters aren't rebuilt. Deleted keys stay in filters
+(Filter can't give false negative), and page marked as stale for rebuild at next change.
+*/
+static int _update_page_delete(directory_t* __restrict directory, int index, page_t* __restrict page) {
+    if (index < 0 || index >= directory->header->page_count) return -1;
+    directory->page_free[index] = PGM_get_max_free_space(page);
+    _scan_page_keys(directory, index, page, 0);
+    if (directory->header->bloom_count) directory->page_stale[index] = 1;
+    return 1;
+}
+
 static int _unlink_page_from_directory(directory_t* __restrict directory, char* __restrict page_name) {
     int status = 0;
     for (int i = 0; i < directory->header->page_count; i++) {
         if (strncmp_s(directory->page_names[i], page_name, PAGE_NAME_SIZE) == 0) {
-            for (int j = i; j < directory->header->page_count - 1; j++)
-                str_memset(directory->page_names[j], directory->page_names[j + 1], PAGE_NAME_SIZE);
+            for (int j = i; j < directory->header->page_count - 1; j++) {
+                str_memcpy(directory->page_names[j], directory->page_names[j + 1], PAGE_NAME_SIZE);
+                directory->page_free[j] = directory->page_free[j + 1];
+                str_memcpy(directory->page_zones[j], directory->page_zones[j + 1], sizeof(directory->page_zones[j]));
+                directory->page_stale[j] = directory->page_stale[j + 1];
+                if (directory->page_blooms) {
+                    int blooms_size = directory->header->bloom_count * directory->header->bloom_size;
+                    str_memcpy(directory->page_blooms + j * blooms_size, directory->page_blooms + (j + 1) * blooms_size, blooms_size);
+                }
+            }
 
             directory->header->page_count--;
             directory->append_offset = MAX(directory->append_offset - 1, 0);
@@ -22,32 +127,54 @@ static int _unlink_page_from_directory(directory_t* __restrict directory, char*
     return status;
 }
 
+static int _delete_page(directory_t* __restrict directory, page_t* __restrict page) {
+    char page_path[DEFAULT_PATH_SIZE] = { 0 };
+    get_load_path(page->header->name, PAGE_NAME_SIZE, page_path, directory->header->name, PAGE_EXTENSION);
+    _unlink_page_from_directory(directory, page->header->name);
+    if (CHC_flush_entry(page, PAGE_CACHE) == -2) PGM_free_page(page);
+    ci_t ci = NIFAT32_open_content(NO_RCI, page_path, DF_MODE);
+    int del_res = ci >= 0 ? NIFAT32_delete_content(ci) : 0;
+    print_debug("Page [%s] was deleted with result [%i]", page_path, del_res);
+    return 1;
+}
+
 int DRM_append_content(directory_t* __restrict directory, unsigned char* __restrict data, size_t data_lenght) {
     for (int i = directory->append_offset; i < directory->header->page_count; i++) {
+        if (directory->page_free[i] < data_lenght) continue;
         page_t* page = PGM_load_page(directory->header->name, directory->page_names[i]);
         if (!page) continue;
-        if (page->append_offset == -1) {
+        // Slotted page can have tombstones before append offset, that's why we check slot map every time.
+        if (page->append_offset == -1 || (page->header->flags & PAGE_FLAG_SLOTTED)) {
             page->append_offset = PGM_get_fit_free_space(page, PAGE_START, data_lenght);
         }
 
-        if (page->append_offset >= 0 && PAGE_CONTENT_SIZE - page->append_offset >= (int)data_lenght) {
+        if (page->append_offset >= 0 && PAGE_SIZE_OF(page) - page->append_offset >= (int)data_lenght) {
             if (THR_require_write(&page->lock, get_thread_num())) {
                 PGM_insert_content(page, page->append_offset, data, data_lenght);
-                page->append_offset += data_lenght;
+                directory->last_append = i * (int)directory->header->page_size + page->append_offset;
+                page->append_offset += (int)data_lenght;
+                int slot_size = directory->header->slot_size;
+                if (slot_size && !(data_lenght % slot_size)) _update_page_append(directory, i, page, data, (int)data_lenght / slot_size);
+                else _update_page_free(directory, i, page);
                 THR_release_lock(&page->lock, get_thread_num());
                 PGM_flush_page(page);
                 return 1;
             }
         }
 
+        // Summary was too optimistic (Free space fragmented). Refresh it from page.
+        _update_page_free(directory, i, page);
         PGM_flush_page(page);
     }
 
     if (directory->header->page_count + 1 > PAGES_PER_DIRECTORY) return (int)data_lenght;
-    page_t* new_page = PGM_create_empty_page(directory->header->name);
+    page_t* new_page = PGM_create_empty_page(
+        directory->header->name, directory->header->page_size, directory->header->page_flags, directory->header->slot_size
+    );
     if (new_page == NULL) return -2;
 
     directory->append_offset = directory->header->page_count;
+    directory->last_append = directory->header->page_count * (int)directory->header->page_size;
     PGM_insert_content(new_page, 0, data, data_lenght);
 
     _link_page2dir(directory, new_page);
@@ -57,16 +184,77 @@ int DRM_append_content(directory_t* __restrict directory, unsigned char* __restr
     return 2;
 }
 
+int DRM_append_rows(directory_t* __restrict directory, unsigned char* __restrict data, int row_size, int count, int* offsets) {
+    int appended = 0;
+    int page_size = (int)directory->header->page_size;
+    for (int i = directory->append_offset; i < directory->header->page_count && appended < count; i++) {
+        if ((int)directory->page_free[i] < row_size) continue;
+        page_t* page = PGM_load_page(directory->header->name, directory->page_names[i]);
+        if (!page) continue;
+        int first_row = appended;
+        if (THR_require_write(&page->lock, get_thread_num())) {
+            int slotted = page->header->flags & PAGE_FLAG_SLOTTED;
+            while (appended < count) {
+                // Rows placed one by one after append offset. Slotted page can have tombstones, that's why we check slot map.
+                if (slotted || page->append_offset < 0 || PAGE_SIZE_OF(page) - page->append_offset < row_size) {
+                    page->append_offset = PGM_get_fit_free_space(page, PAGE_START, row_size);
+                }
+
+                if (page->append_offset < 0 || PAGE_SIZE_OF(page) - page->append_offset < row_size) break;
+                PGM_insert_content(page, page->append_offset, data + appended * row_size, row_size);
+                directory->last_append = i * page_size + page->append_offset;
+                if (offsets) offsets[appended] = directory->last_append;
+
+                page->append_offset += row_size;
+                appended++;
+            }
+
+            THR_release_write(&page->lock, get_thread_num());
+        }
+
+        _update_page_append(directory, i, page, data + first_row * row_size, appended - first_row);
+        PGM_flush_page(page);
+    }
+
+    while (appended < count && directory->header->page_count < PAGES_PER_DIRECTORY) {
+        page_t* new_page = PGM_create_empty_page(
+            directory->header->name, directory->header->page_size, directory->header->page_flags, directory->header->slot_size
+        );
+        if (new_page == NULL) return -2;
+
+        int page_offset = 0;
+        int first_row = appended;
+        while (appended < count && PAGE_SIZE_OF(new_page) - page_offset >= row_size) {
+            if (offsets) offsets[appended] = directory->header->page_count * page_size + page_offset;
+            page_offset += row_size;
+            appended++;
+        }
+
+        // Rows placed sequentially, that's why whole block inserted by one call.
+        PGM_insert_content(new_page, 0, data + first_row * row_size, page_offset);
+        new_page->append_offset = page_offset;
+        directory->append_offset = directory->header->page_count;
+        directory->last_append = directory->header->page_count * page_size + page_offset - row_size;
+
+        _link_page2dir(directory, new_page);
+        CHC_add_entry(new_page, new_page->header->name, directory->header->name, PAGE_CACHE, (void*)PGM_free_page, (void*)PGM_save_page);
+        PGM_flush_page(new_page);
+    }
+
+    return appended;
+}
+
 int DRM_get_content(directory_t* __restrict directory, int offset, unsigned char* __restrict buffer, size_t data_lenght) {
     int status = 0;
     unsigned char* content_pointer = buffer;
-    int start_page  = offset / PAGE_CONTENT_SIZE;
-    int page_offset = offset % PAGE_CONTENT_SIZE;
+    int page_size   = (int)directory->header->page_size;
+    int start_page  = offset / page_size;
+    int page_offset = offset % page_size;
     for (int i = start_page; i < directory->header->page_count && data_lenght > 0; i++) {
         page_t* page = PGM_load_page(directory->header->name, directory->page_names[i]);
         if (!page) continue;
         if (THR_require_lock(&page->lock, get_thread_num())) {
-            int current_size = MIN(PAGE_CONTENT_SIZE - page_offset, (int)data_lenght);
+            int current_size = MIN(page_size - page_offset, (int)data_lenght);
             PGM_get_content(page, page_offset, content_pointer, current_size);
 
             page_offset = 0;
@@ -86,14 +274,15 @@ int DRM_get_content(directory_t* __restrict directory, int offset, unsigned char
 int DRM_insert_content(directory_t* __restrict directory, int offset, unsigned char* __restrict data, size_t data_lenght) {
 #ifndef NO_UPDATE_COMMAND
     unsigned char* data_pointer = data;
-    int page_offset  = offset / PAGE_CONTENT_SIZE;
-    int index_offset = offset % PAGE_CONTENT_SIZE;
+    int page_offset  = offset / (int)directory->header->page_size;
+    int index_offset = offset % (int)directory->header->page_size;
     for (int i = page_offset; i < directory->header->page_count && data_lenght > 0; i++) {
         page_t* page = PGM_load_page(directory->header->name, directory->page_names[i]);
         if (!page) return -1;
 
         if (THR_require_lock(&page->lock, get_thread_num())) { 
             int result = PGM_insert_content(page, index_offset, data_pointer, (int)data_lenght);
+            _update_page_free(directory, i, page);
             THR_release_lock(&page->lock, get_thread_num());
 
             index_offset = 0;
@@ -113,14 +302,16 @@ int DRM_insert_content(directory_t* __restrict directory, int offset, unsigned c
 int DRM_delete_content(directory_t* directory, int offset, size_t data_size) {
 #ifndef NO_DELETE_COMMAND
     int deleted_data = 0;
-    int start_page  = offset / PAGE_CONTENT_SIZE;
-    int page_offset = offset % PAGE_CONTENT_SIZE;
+    int page_size   = (int)directory->header->page_size;
+    int start_page  = offset / page_size;
+    int page_offset = offset % page_size;
     for (int i = start_page; i < directory->header->page_count && data_size > 0; i++) {
         page_t* page = PGM_load_page(directory->header->name, directory->page_names[i]);
         if (!page) return -1;
         if (THR_require_lock(&page->lock, get_thread_num())) {
             int result = PGM_delete_content(page, page_offset, data_size);
             directory->append_offset = MIN(directory->append_offset, i);
+            _update_page_delete(directory, i, page);
 
             page_offset = 0;
             data_size  -= result;
@@ -139,76 +330,208 @@ int DRM_delete_content(directory_t* directory, int offset, size_t data_size) {
 
 #pragma endregion
 
-int DRM_find_content(
-    directory_t* __restrict directory, int offset, unsigned char* __restrict data, size_t data_size
+#pragma region [Search]
+
+/*
+Read content from directory pages. Used by search workers.
+Note: GCT isn't thread safe, that's why pages loaded and read in critical section.
+
+Params:
+- directory - Pointer to directory.
+- offset - Offset in directory.
+- buffer - Destination buffer.
+- size - Size of content.
+
+Return size of read content.
+*/
+static int _read_search_content(directory_t* __restrict directory, int offset, unsigned char* __restrict buffer, int size) {
+    int read_size = 0;
+    int page_size = (int)directory->header->page_size;
+    while (read_size < size) {
+        int index = (offset + read_size) / page_size;
+        if (index >= directory->header->page_count) break;
+
+        int result = -1;
+        int page_offset = (offset + read_size) % page_size;
+        #pragma omp critical (page_cache)
+        {
+            page_t* page = PGM_load_page(directory->header->name, directory->page_names[index]);
+            if (page && THR_require_read(&page->lock)) {
+                result = PGM_get_content(page, page_offset, buffer + read_size, size - read_size);
+                THR_release_read(&page->lock);
+            }
+
+            PGM_flush_page(page);
+        }
+
+        if (result <= 0) break;
+        read_size += result;
+    }
+
+    return read_size;
+}
+
+/*
+Find first entry of data, that starts in page. Entry can start in page tail and continue in next pages,
+that's why we copy page tail to window (Check _find_page_content).
+
+Params:
+- page - Pointer to page.
+- offset - Offset in page.
+- data - Data for search.
+- data_size - Data size.
+- window - Window for page tail (At least data_size - 1 bytes).
+- tail_size - Size of copied page tail.
+
+Return -1 if entry, that fully placed in page, not found.
+Return index of entry in page.
+*/
+static int _find_page_entry(
+    page_t* __restrict page, int offset, unsigned char* __restrict data, size_t data_size, 
+    unsigned char* __restrict window, int* tail_size
 ) {
-    int target_global_index = -1;
-    int page_offset   = offset / PAGE_CONTENT_SIZE;
-    int current_index = offset % PAGE_CONTENT_SIZE;
-    int pages4search  = directory->header->page_count - page_offset;
-    size_t temp_data_size = data_size;
+    int result = PGM_find_content(page, offset, data, data_size);
+    if (result >= 0 || !window) return result;
+
+    int page_size  = PAGE_SIZE_OF(page);
+    int tail_start = MAX(offset, page_size - (int)data_size + 1);
+    *tail_size = MAX(page_size - tail_start, 0);
+    if (*tail_size > 0) PGM_get_content(page, tail_start, window, *tail_size);
+    return -1;
+}
 
-    unsigned char* data_pointer = data;
-    for (; pages4search > 0 && temp_data_size > 0 && page_offset < directory->header->page_count; pages4search--) {
-        page_t* page = PGM_load_page(directory->header->name, directory->page_names[page_offset]);
-        if (!page) return -2;
+/*
+Find first entry of data, that starts in directory page. This function works in search worker.
+Note: Page loaded in critical section (GCT isn't thread safe). Read lock keeps page in GCT
+      while worker searches in it.
+
+Params:
+- directory - Pointer to directory.
+- index - Page index in directory.
+- offset - Offset in page.
+- data - Data for search.
+- data_size - Data size.
+
+Return -2 if page can't be loaded.
+Return -1 if data not found.
+Return index of entry in directory.
+*/
+static int _find_page_content(
+    directory_t* __restrict directory, int index, int offset, unsigned char* __restrict data, size_t data_size
+) {
+    int page_size = (int)directory->header->page_size;
+    int tail_size = 0;
+    unsigned char* window = NULL;
+    if (data_size > 1) {
+        window = (unsigned char*)malloc_s(2 * (data_size - 1));
+        if (!window) return -2;
+    }
 
-        int current_size = MIN(PAGE_CONTENT_SIZE - current_index, (int)temp_data_size);
-        if (THR_require_lock(&page->lock, get_thread_num())) {
-            int result = PGM_find_content(page, current_index, data_pointer, current_size);
-            THR_release_lock(&page->lock, get_thread_num());
+    int result = -2;
+    int is_locked = 0;
+    page_t* page = NULL;
+    #pragma omp critical (page_cache)
+    {
+        page = PGM_load_page(directory->header->name, directory->page_names[index]);
+        if (page) is_locked = THR_require_read(&page->lock);
+    }
 
-            // If TGI is -1, we know that we start searching from start.
-            // Save current TGI of find part of data.
-            if (target_global_index == -1) target_global_index = result + page_offset * PAGE_CONTENT_SIZE;
-            if (result == -1) {
-                // We don`t find any entry of data part.
-                // This indicates, that we don`t find any data.
-                // Restore size4search and datapointer, we go to start
-                temp_data_size = data_size;
-                data_pointer = data;
-                target_global_index = -1;
-            } 
-            else {
-                // Move pointer to next position
-                temp_data_size -= current_size;
-                data_pointer += current_size;
-            }
+    if (is_locked) {
+        result = _find_page_entry(page, offset, data, data_size, window, &tail_size);
+        THR_release_read(&page->lock);
+    }
 
-            // Set local index to 0. We don`t need offset now.
-            current_index = 0;
-            page_offset++;
+    if (page) {
+        #pragma omp critical (page_cache)
+        PGM_flush_page(page);
+    }
+
+    if (result >= 0) result += index * page_size;
+    else if (result == -1 && tail_size > 0) {
+        // Read next pages only if page tail starts with data prefix.
+        int is_prefix = 0;
+        for (int i = 0; i < tail_size && !is_prefix; i++) {
+            is_prefix = !str_memcmp(window + i, data, tail_size - i);
         }
 
-        PGM_flush_page(page);
+        if (is_prefix) {
+            int page_end  = (index + 1) * page_size;
+            int head_size = _read_search_content(directory, page_end, window + tail_size, (int)data_size - 1);
+            int window_result = str_memfind(window, tail_size + head_size, data, data_size);
+            if (window_result >= 0) result = page_end - tail_size + window_result;
+        }
+    }
+
+    SOFT_FREE(window);
+    return result;
+}
+
+int DRM_find_content(
+    directory_t* __restrict directory, int offset, unsigned char* __restrict data, size_t data_size
+) {
+    int target_global_index = -1;
+    int failed_index  = -1;
+    int page_size     = (int)directory->header->page_size;
+    int start_page    = offset / page_size;
+    int start_index   = offset % page_size;
+    int page_count    = directory->header->page_count;
+
+    // Every worker search entries, that starts in own page. Lowest index wins, that's why
+    // workers skip pages after already found entry.
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i = start_page; i < page_count; i++) {
+        int current_index;
+        #pragma omp atomic read
+        current_index = target_global_index;
+        if (current_index >= 0 && current_index < i * page_size) continue;
+
+        int result = _find_page_content(directory, i, i == start_page ? start_index : 0, data, data_size);
+        if (result == -1) continue;
+        #pragma omp critical (find_content_result)
+        {
+            if (result == -2) {
+                if (failed_index < 0 || i * page_size < failed_index) failed_index = i * page_size;
+            }
+            else if (target_global_index < 0 || result < target_global_index) {
+                #pragma omp atomic write
+                target_global_index = result;
+            }
+        }
     }
 
+    // Broken page before entry means, that we can't be sure in result.
+    if (failed_index >= 0 && (target_global_index < 0 || failed_index < target_global_index)) return -2;
     return target_global_index;
 }
 
+#pragma endregion
+
 int DRM_cleanup_pages(directory_t* directory) {
 #ifndef NO_DELETE_COMMAND
     int temp_count = directory->header->page_count;
     char** temp_names = copy_array2array((void*)directory->page_names, PAGE_NAME_SIZE, temp_count, PAGE_NAME_SIZE);
     if (!temp_names) return -1;
 
+    int removed = 0;
+    int changed = 0;
+
     for (int i = 0; i < temp_count; i++) {
-        char page_path[DEFAULT_PATH_SIZE] = { 0 };
-        get_load_path(temp_names[i], PAGE_NAME_SIZE, page_path, directory->header->name, PAGE_EXTENSION);
         page_t* page = PGM_load_page(directory->header->name, temp_names[i]);
         if (page) {
             if (THR_require_lock(&page->lock, get_thread_num())) {
                 // If page, after delete operation, full empty, we delete page.
                 // Also we realise page pointer in RAM.
+                // Slotted pages compacted here, that's why tombstones moved to page end.
+                if (PGM_compact_page(page) > 0) changed++;
                 int free_space = PGM_get_free_space(page, PAGE_START);
-                if (free_space == PAGE_CONTENT_SIZE) {
-                    _unlink_page_from_directory(directory, page->header->name);
-                    if (CHC_flush_entry(page, PAGE_CACHE) == -2) PGM_free_page(page);
-                    int del_res = remove(page_path);
-                    print_debug("Page [%s] was deleted with result [%i]", page_path, del_res);
+                if (free_space == PAGE_SIZE_OF(page)) {
+                    _delete_page(directory, page);
+                    removed++;
+                    changed++;
                     continue;
                 }
                 else {
+                    _update_page_free(directory, i - removed, page);
                     THR_release_lock(&page->lock, get_thread_num());
                 }
             }
@@ -218,7 +541,237 @@ int DRM_cleanup_pages(directory_t* directory) {
     }
 
     ARRAY_SOFT_FREE(temp_names, temp_count);
-    return 1;
+    return changed;
+#endif
+    return -2;
+}
+
+/*
+Find next free row in destination directory. Pages, that full by directory summary, skipped without load.
+Note: Left page will be flushed.
+
+Params:
+- directory - Destination directory.
+- page - Current destination page (Or NULL).
+- index - Current destination page index.
+- row - Current destination row in page.
+- row_size - Row size.
+- limit - Pages with index equals or larger than limit can't be used.
+          If limit is -1, whole directory used, and new pages created (Until directory is full).
+
+Return NULL if free row not found.
+Return page with free row.
+*/
+static page_t* _find_free_row(directory_t* directory, page_t* page, int* index, int* row, int row_size, int limit) {
+    int rows_per_page = (int)directory->header->page_size / row_size;
+    while (*index < (limit < 0 ? directory->header->page_count : limit)) {
+        if (!page) {
+            if (directory->page_free[*index] + 1 < (unsigned int)row_size) {
+                (*index)++;
+                continue;
+            }
+
+            page = PGM_load_page(directory->header->name, directory->page_names[*index]);
+            if (!page) return NULL;
+            *row = 0;
+        }
+
+        while (*row < rows_per_page && PGM_get_free_space(page, *row * row_size) < row_size) (*row)++;
+        if (*row < rows_per_page) return page;
+
+        _update_page_free(directory, *index, page);
+        PGM_flush_page(page);
+        page = NULL;
+        (*index)++;
+    }
+
+    if (page) {
+        _update_page_free(directory, *index, page);
+        PGM_flush_page(page);
+    }
+
+    if (limit >= 0 || directory->header->page_count + 1 > PAGES_PER_DIRECTORY) return NULL;
+    page = PGM_create_empty_page(
+        directory->header->name, directory->header->page_size, directory->header->page_flags, directory->header->slot_size
+    );
+    if (!page) return NULL;
+
+    *row   = 0;
+    *index = directory->header->page_count;
+    _link_page2dir(directory, page);
+    CHC_add_entry(page, page->header->name, directory->header->name, PAGE_CACHE, (void*)PGM_free_page, (void*)PGM_save_page);
+    return page;
+}
+
+int DRM_compact_pages(directory_t* dst, directory_t* src, int row_size, int max_pages) {
+#ifndef NO_DELETE_COMMAND
+    if (row_size <= 0 || row_size > (int)src->header->page_size) return -1;
+    unsigned char* row = (unsigned char*)malloc_s(row_size);
+    if (!row) return -1;
+
+    int processed = 0;
+    int dst_index = 0;
+    int dst_row   = 0;
+    page_t* dst_page = NULL;
+    int rows_per_page = (int)src->header->page_size / row_size;
+    while (processed < max_pages && src->header->page_count > 0) {
+        // Rows moved from last source page to first free rows. In same directory
+        // we stop, when destination reach source page.
+        int src_index = src->header->page_count - 1;
+        int limit = dst == src ? src_index : -1;
+        dst_page = _find_free_row(dst, dst_page, &dst_index, &dst_row, row_size, limit);
+        if (!dst_page) break;
+
+        page_t* src_page = PGM_load_page(src->header->name, src->page_names[src_index]);
+        if (!src_page) break;
+        processed++;
+
+        for (int i = 0; i < rows_per_page && dst_page; i++) {
+            if (PGM_get_free_space(src_page, i * row_size) >= row_size) continue;
+            PGM_get_content(src_page, i * row_size, row, row_size);
+            PGM_insert_content(dst_page, dst_row * row_size, row, row_size);
+            PGM_delete_content(src_page, i * row_size, row_size);
+
+            dst_row++;
+            dst_page = _find_free_row(dst, dst_page, &dst_index, &dst_row, row_size, limit);
+        }
+
+        if (PGM_get_free_space(src_page, PAGE_START) == PAGE_SIZE_OF(src_page)) {
+            _delete_page(src, src_page);
+            continue;
+        }
+
+        // Destination is full. Source page keeps rest of rows.
+        src_page->append_offset = -1;
+        _update_page_delete(src, src_index, src_page);
+        src->append_offset = MIN(src->append_offset, src_index);
+        PGM_flush_page(src_page);
+        break;
+    }
+
+    if (dst_page) {
+        _update_page_free(dst, dst_index, dst_page);
+        PGM_flush_page(dst_page);
+    }
+
+    free_s(row);
+    return processed;
 #endif
     return -2;
 }
+
+#pragma region [Zones]
+
+long long DRM_make_zone_key(unsigned char type, unsigned char* data, int size) {
+    switch (type) {
+        case ZONE_TYPE_INT32: {
+            int value = 0;
+            str_memcpy(&value, data, sizeof(int));
+            return value;
+        }
+
+        case ZONE_TYPE_INT64: {
+            long long value = 0;
+            str_memcpy(&value, data, sizeof(long long));
+            return value;
+        }
+
+        case ZONE_TYPE_STRING: {
+            // Big-endian packing keeps strcmp order of strings. Bytes after end of string are zero.
+            int start = 0;
+            while (start < size && data[start] == ' ') start++;
+
+            long long key = 0;
+            for (int i = 0, end = 0; i < ZONE_STRING_SIZE; i++) {
+                if (start + i >= size || !data[start + i]) end = 1;
+                key = (key << 8) | (end ? 0 : data[start + i]);
+            }
+
+            return key;
+        }
+
+        default: return str_atoll((char*)data, size);
+    }
+}
+
+int DRM_get_zone(directory_t* __restrict directory, int page, int zone, directory_zone_t* __restrict result) {
+    if (zone < 0 || zone >= directory->header->zone_count || page >= directory->header->page_count) return -1;
+    if (page >= 0) {
+        *result = directory->page_zones[page][zone];
+        return 1;
+    }
+
+    result->min = ZONE_KEY_MAX;
+    result->max = ZONE_KEY_MIN;
+    for (int i = 0; i < directory->header->page_count; i++) {
+        result->min = MIN(result->min, directory->page_zones[i][zone].min);
+        result->max = MAX(result->max, directory->page_zones[i][zone].max);
+    }
+
+    return 1;
+}
+
+#pragma endregion
+
+#pragma region [Bloom]
+
+/*
+Mix key bits. Close values (Sequential ids) should give different filter bits.
+*/
+static long long _mix_key(unsigned long long key) {
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ULL;
+    key ^= key >> 33;
+    return (long long)key;
+}
+
+long long DRM_make_bloom_key(unsigned char type, unsigned char* data, int size) {
+    if (type != ZONE_TYPE_STRING) return _mix_key((unsigned long long)DRM_make_zone_key(type, data, size));
+
+    // String hashed until end of string (Same with eq compare).
+    int start = 0;
+    while (start < size && data[start] == ' ') start++;
+
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    for (int i = start; i < size && data[i]; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001B3ULL;
+    }
+
+    return _mix_key(hash);
+}
+
+int DRM_set_blooms(directory_t* __restrict directory, directory_zone_column_t* __restrict columns, int count, int size) {
+    SOFT_FREE(directory->page_blooms);
+    directory->header->bloom_count = 0;
+    if (count <= 0) return 0;
+
+    count = MIN(count, DIRECTORY_BLOOM_COUNT);
+    size  = MAX(MIN(size, DIRECTORY_BLOOM_MAX), DIRECTORY_BLOOM_MIN);
+    directory->page_blooms = (unsigned char*)malloc_s(PAGES_PER_DIRECTORY * count * size);
+    if (!directory->page_blooms) return -1;
+
+    str_memset(directory->page_blooms, 0, PAGES_PER_DIRECTORY * count * size);
+    str_memset(directory->page_stale, 0, sizeof(directory->page_stale));
+    str_memcpy(directory->header->bloom_columns, columns, count * sizeof(directory_zone_column_t));
+    directory->header->bloom_count = count;
+    directory->header->bloom_size  = size;
+    return count;
+}
+
+int DRM_check_bloom(directory_t* directory, int page, int bloom, long long key) {
+    directory_header_t* header = directory->header;
+    if (!directory->page_blooms || bloom < 0 || bloom >= header->bloom_count || page < 0 || page >= header->page_count) return 1;
+
+    unsigned char* filter = directory->page_blooms + (page * header->bloom_count + bloom) * header->bloom_size;
+    for (int i = 0; i < BLOOM_HASH_COUNT; i++) {
+        unsigned int bit = _get_bloom_bit(key, i, header->bloom_size * 8);
+        if (!(filter[bit / 8] & (1 << (bit % 8)))) return 0;
+    }
+
+    return 1;
+}
+
+#pragma endregion
@@ -0,0 +1,966 @@
+#include <indman.h>
+
+// Entry in node: | KEY | ROW | CHILD |. Child used only in internal nodes.
+#define ENTRY_SIZE(index)           ((int)(index)->header->key_size + 2 * (int)sizeof(int))
+#define NODE_CAPACITY(index)        (((int)(index)->header->node_size - (int)sizeof(index_node_t)) / ENTRY_SIZE(index))
+#define NODE_ENTRY(index, node, i)  ((unsigned char*)(node) + sizeof(index_node_t) + (i) * ENTRY_SIZE(index))
+#define INDEX_ROWS_STEP             64
+// Hash buckets placed at odd nodes and overflow nodes at even nodes, that's why buckets can grow without bucket map.
+#define BUCKET_NODE(bucket)         (1 + 2 * (unsigned int)(bucket))
+#define OVERFLOW_NODE(number)       (2 + 2 * (unsigned int)(number))
+
+#pragma region [Nodes]
+
+    static int _read_node(index_t* __restrict index, unsigned int node, unsigned char* __restrict buffer) {
+        int size = (int)index->header->node_size;
+        if (NIFAT32_read_content2buffer(
+            index->ci, node * size * sizeof(encoded_t), (buffer_t)index->encoded, size * sizeof(encoded_t)
+        ) != size * (int)sizeof(encoded_t)) {
+            print_error("Can't read node [%u] of index", node);
+            return -1;
+        }
+
+        unpack_memory(index->encoded, buffer, size);
+        return 1;
+    }
+
+    static int _write_node(index_t* __restrict index, unsigned int node, unsigned char* __restrict buffer) {
+        int size = (int)index->header->node_size;
+        pack_memory(buffer, (decoded_t*)index->encoded, size);
+        if (NIFAT32_write_buffer2content(
+            index->ci, node * size * sizeof(encoded_t), (const_buffer_t)index->encoded, size * sizeof(encoded_t)
+        ) != size * (int)sizeof(encoded_t)) {
+            print_error("Can't write node [%u] of index", node);
+            return -1;
+        }
+
+        return 1;
+    }
+
+    static unsigned int _alloc_node(index_t* index) {
+        index->is_dirty = 1;
+        return index->header->node_count++;
+    }
+
+    static int _push_row(int** rows, int* count, int* capacity, int row) {
+        if (*count >= *capacity) {
+            *capacity += INDEX_ROWS_STEP;
+            int* new_rows = (int*)realloc_s(*rows, *capacity * sizeof(int));
+            if (!new_rows) return -1;
+            *rows = new_rows;
+        }
+
+        (*rows)[(*count)++] = row;
+        return 1;
+    }
+
+    static int _save_header(index_t* index) {
+        unsigned char* buffer = (unsigned char*)malloc_s(index->header->node_size);
+        if (!buffer) return -1;
+
+        str_memset(buffer, 0, index->header->node_size);
+        index->header->checksum = IND_get_checksum(index);
+        str_memcpy(buffer, index->header, sizeof(index_header_t));
+
+        int status = _write_node(index, 0, buffer);
+        if (status == 1) index->is_dirty = 0;
+        free_s(buffer);
+        return status;
+    }
+
+#pragma endregion
+
+#pragma region [Entries]
+
+    static int _get_row(index_t* __restrict index, unsigned char* __restrict entry) {
+        int row = 0;
+        str_memcpy(&row, entry + index->header->key_size, sizeof(int));
+        return row;
+    }
+
+    static unsigned int _get_child(index_t* __restrict index, unsigned char* __restrict entry) {
+        unsigned int child = 0;
+        str_memcpy(&child, entry + index->header->key_size + sizeof(int), sizeof(int));
+        return child;
+    }
+
+    static void _set_entry(index_t* __restrict index, unsigned char* entry, unsigned char* key, int row, unsigned int child) {
+        if (entry != key) str_memcpy(entry, key, index->header->key_size);
+        str_memcpy(entry + index->header->key_size, &row, sizeof(int));
+        str_memcpy(entry + index->header->key_size + sizeof(int), &child, sizeof(int));
+    }
+
+    static int _compare_keys(index_t* __restrict index, unsigned char* first, unsigned char* second) {
+        if (index->header->key_type == INDEX_KEY_INT) {
+            int first_value = 0, second_value = 0;
+            str_memcpy(&first_value, first, sizeof(int));
+            str_memcpy(&second_value, second, sizeof(int));
+            return (first_value > second_value) - (first_value < second_value);
+        }
+
+        if (index->header->key_type == INDEX_KEY_LONG) {
+            long long first_value = 0, second_value = 0;
+            str_memcpy(&first_value, first, sizeof(long long));
+            str_memcpy(&second_value, second, sizeof(long long));
+            return (first_value > second_value) - (first_value < second_value);
+        }
+
+        return str_memcmp(first, second, index->header->key_size);
+    }
+
+    /*
+    Compare entry with (key, row) pair. Row makes every entry unique.
+    */
+    static int _compare_entry(index_t* __restrict index, unsigned char* entry, unsigned char* key, int row) {
+        int comparison = _compare_keys(index, entry, key);
+        if (comparison) return comparison;
+        int entry_row = _get_row(index, entry);
+        return (entry_row > row) - (entry_row < row);
+    }
+
+    /*
+    Binary search in node.
+
+    Params:
+    - index - Pointer to index.
+    - node - Node buffer.
+    - key - Target key.
+    - row - Target row.
+    - upper - 0 for first entry >= (key, row), 1 for first entry > (key, row).
+
+    Return entry position in node (Or count of entries).
+    */
+    static int _search_node(index_t* __restrict index, unsigned char* node, unsigned char* key, int row, int upper) {
+        int low = 0, high = ((index_node_t*)node)->count;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            int comparison = _compare_entry(index, NODE_ENTRY(index, node, middle), key, row);
+            if (comparison < 0 || (upper && !comparison)) low = middle + 1;
+            else high = middle;
+        }
+
+        return low;
+    }
+
+    /*
+    Get child of internal node, that can contain (key, row) pair.
+    */
+    static unsigned int _route_node(index_t* __restrict index, unsigned char* node, unsigned char* key, int row) {
+        int position = _search_node(index, node, key, row, 1);
+        if (!position) return ((index_node_t*)node)->link;
+        return _get_child(index, NODE_ENTRY(index, node, position - 1));
+    }
+
+    static void _insert_entry(
+        index_t* __restrict index, unsigned char* node, int position, unsigned char* key, int row, unsigned int child
+    ) {
+        index_node_t* header = (index_node_t*)node;
+        unsigned char* entry = NODE_ENTRY(index, node, position);
+        for (int i = header->count - 1; i >= position; i--) {
+            str_memcpy(NODE_ENTRY(index, node, i + 1), NODE_ENTRY(index, node, i), ENTRY_SIZE(index));
+        }
+
+        _set_entry(index, entry, key, row, child);
+        header->count++;
+    }
+
+#pragma endregion
+
+#pragma region [Tree]
+
+    /*
+    Insert (key, row) pair to subtree.
+
+    Params:
+    - index - Pointer to index.
+    - node_index - Root of subtree.
+    - key - Entry key.
+    - row - Entry row.
+    - up_entry - Place for separator entry, if node was splitted.
+
+    Return -1 if something goes wrong.
+    Return 0 if entry inserted.
+    Return 1 if entry inserted and node was splitted (Separator in up_entry).
+    */
+    static int _insert_subtree(
+        index_t* __restrict index, unsigned int node_index, unsigned char* key, int row, unsigned char* up_entry
+    ) {
+        int entry_size = ENTRY_SIZE(index);
+        unsigned char* node = (unsigned char*)malloc_s(index->header->node_size + entry_size);
+        if (!node) return -1;
+        if (_read_node(index, node_index, node) != 1) {
+            free_s(node);
+            return -1;
+        }
+
+        index_node_t* header = (index_node_t*)node;
+        if (header->is_leaf) {
+            int position = _search_node(index, node, key, row, 0);
+            if (position < header->count && !_compare_entry(index, NODE_ENTRY(index, node, position), key, row)) {
+                free_s(node);
+                return 0;
+            }
+
+            _insert_entry(index, node, position, key, row, INDEX_NO_NODE);
+        }
+        else {
+            int position = _search_node(index, node, key, row, 1);
+            unsigned int child = position ? _get_child(index, NODE_ENTRY(index, node, position - 1)) : header->link;
+            int result = _insert_subtree(index, child, key, row, up_entry);
+            if (result != 1) {
+                free_s(node);
+                return result;
+            }
+
+            _insert_entry(index, node, position, up_entry, _get_row(index, up_entry), _get_child(index, up_entry));
+        }
+
+        int status = 0;
+        if (header->count <= NODE_CAPACITY(index)) status = _write_node(index, node_index, node) == 1 ? 0 : -1;
+        else {
+            unsigned char* right = (unsigned char*)malloc_s(index->header->node_size);
+            if (!right) {
+                free_s(node);
+                return -1;
+            }
+
+            str_memset(right, 0, index->header->node_size);
+            index_node_t* right_header = (index_node_t*)right;
+            unsigned int right_index = _alloc_node(index);
+
+            // Leaf copy first key of right node to parent. Internal node move middle key to parent.
+            int middle = header->count / 2;
+            unsigned char* middle_entry = NODE_ENTRY(index, node, middle);
+            str_memcpy(up_entry, middle_entry, index->header->key_size);
+            _set_entry(index, up_entry, up_entry, _get_row(index, middle_entry), right_index);
+
+            right_header->is_leaf = header->is_leaf;
+            int first = middle;
+            if (header->is_leaf) {
+                right_header->link = header->link;
+                header->link = right_index;
+            }
+            else {
+                right_header->link = _get_child(index, middle_entry);
+                first = middle + 1;
+            }
+
+            right_header->count = header->count - first;
+            str_memcpy(NODE_ENTRY(index, right, 0), NODE_ENTRY(index, node, first), right_header->count * entry_size);
+            header->count = middle;
+
+            status = 1;
+            if (_write_node(index, right_index, right) != 1 || _write_node(index, node_index, node) != 1) status = -1;
+            free_s(right);
+        }
+
+        free_s(node);
+        return status;
+    }
+
+    /*
+    Find leaf, that can contain (key, row) pair. Leaf will be placed in index->node.
+
+    Params:
+    - index - Pointer to index.
+    - key - Target key. If NULL, will return leftmost leaf.
+    - row - Target row.
+
+    Return INDEX_NO_NODE if tree is empty or broken.
+    Return leaf node index.
+    */
+    static unsigned int _find_leaf(index_t* __restrict index, unsigned char* key, int row) {
+        unsigned int node = index->header->root;
+        while (node != INDEX_NO_NODE) {
+            if (_read_node(index, node, index->node) != 1) return INDEX_NO_NODE;
+            if (((index_node_t*)index->node)->is_leaf) break;
+            node = key ? _route_node(index, index->node, key, row) : ((index_node_t*)index->node)->link;
+        }
+
+        return node;
+    }
+
+    static int _btree_insert(index_t* __restrict index, unsigned char* __restrict key, int row) {
+        unsigned char* up_entry = (unsigned char*)malloc_s(ENTRY_SIZE(index));
+        unsigned char* root = (unsigned char*)malloc_s(index->header->node_size);
+        if (!up_entry || !root) {
+            SOFT_FREE(up_entry);
+            SOFT_FREE(root);
+            return -1;
+        }
+
+        int status = 1;
+        str_memset(root, 0, index->header->node_size);
+        if (index->header->root == INDEX_NO_NODE) {
+            ((index_node_t*)root)->is_leaf = 1;
+            _insert_entry(index, root, 0, key, row, INDEX_NO_NODE);
+            index->header->root = _alloc_node(index);
+            status = _write_node(index, index->header->root, root);
+        }
+        else {
+            int result = _insert_subtree(index, index->header->root, key, row, up_entry);
+            if (result < 0) status = -1;
+            else if (result == 1) {
+                // Root was splitted. New root has old root as first child.
+                ((index_node_t*)root)->link = index->header->root;
+                _insert_entry(index, root, 0, up_entry, _get_row(index, up_entry), _get_child(index, up_entry));
+                index->header->root = _alloc_node(index);
+                status = _write_node(index, index->header->root, root);
+            }
+        }
+
+        free_s(up_entry);
+        free_s(root);
+        return status;
+    }
+
+    static int _btree_delete(index_t* __restrict index, unsigned char* __restrict key, int row) {
+        unsigned int leaf = _find_leaf(index, key, row);
+        if (leaf == INDEX_NO_NODE) return 0;
+
+        index_node_t* header = (index_node_t*)index->node;
+        int position = _search_node(index, index->node, key, row, 0);
+        if (position >= header->count || _compare_entry(index, NODE_ENTRY(index, index->node, position), key, row)) return 0;
+
+        for (int i = position; i < header->count - 1; i++) {
+            str_memcpy(NODE_ENTRY(index, index->node, i), NODE_ENTRY(index, index->node, i + 1), ENTRY_SIZE(index));
+        }
+
+        header->count--;
+        return _write_node(index, leaf, index->node);
+    }
+
+    static int _btree_find(
+        index_t* __restrict index, int operation, unsigned char* __restrict key, int** rows, int* count, int* capacity
+    ) {
+        // Equals search starts from first entry with key, more search starts after last entry with key.
+        int row = operation == INDEX_MORE ? 0x7FFFFFFF : -1;
+        unsigned int leaf = _find_leaf(index, operation == INDEX_LESS ? NULL : key, row);
+        int position = -1;
+        while (leaf != INDEX_NO_NODE) {
+            index_node_t* header = (index_node_t*)index->node;
+            if (position < 0) position = operation == INDEX_LESS ? 0 : _search_node(index, index->node, key, row, 1);
+
+            for (; position < header->count; position++) {
+                unsigned char* entry = NODE_ENTRY(index, index->node, position);
+                int comparison = _compare_keys(index, entry, key);
+                if ((operation == INDEX_EQUALS && comparison) || (operation == INDEX_LESS && comparison >= 0)) {
+                    leaf = INDEX_NO_NODE;
+                    break;
+                }
+
+                if (_push_row(rows, count, capacity, _get_row(index, entry)) != 1) return -1;
+            }
+
+            if (leaf == INDEX_NO_NODE) break;
+            leaf = header->link;
+            position = 0;
+            if (leaf != INDEX_NO_NODE && _read_node(index, leaf, index->node) != 1) return -1;
+        }
+
+        return 1;
+    }
+
+    static void _sift_rows(int* rows, int root, int end) {
+        while (1) {
+            int child = root * 2 + 1;
+            if (child >= end) break;
+            if (child + 1 < end && rows[child + 1] > rows[child]) child++;
+            if (rows[root] >= rows[child]) break;
+
+            int temp = rows[root];
+            rows[root] = rows[child];
+            rows[child] = temp;
+            root = child;
+        }
+    }
+
+    static void _sort_rows(int* rows, int count) {
+        for (int i = count / 2 - 1; i >= 0; i--) _sift_rows(rows, i, count);
+        for (int end = count - 1; end > 0; end--) {
+            int temp = rows[0];
+            rows[0] = rows[end];
+            rows[end] = temp;
+            _sift_rows(rows, 0, end);
+        }
+    }
+
+#pragma endregion
+
+#pragma region [Hash]
+
+    /*
+    Get bucket of key. Linear hashing: buckets before split pointer already splitted,
+    that's why they use next level hash.
+    */
+    static unsigned int _hash_bucket(index_t* __restrict index, unsigned char* __restrict key) {
+        unsigned int hash = checksum_memory(index->header->checksum_type, key, index->header->key_size, 0);
+        unsigned int buckets = INDEX_HASH_BUCKETS;
+        while (buckets * 2 <= index->header->bucket_count) buckets *= 2;
+
+        unsigned int bucket = hash % buckets;
+        if (bucket < index->header->bucket_count - buckets) bucket = hash % (buckets * 2);
+        return bucket;
+    }
+
+    /*
+    Get overflow node from free list or allocate new one.
+    */
+    static unsigned int _alloc_overflow(index_t* __restrict index, unsigned char* __restrict buffer) {
+        index->is_dirty = 1;
+        unsigned int node = index->header->free_node;
+        if (node == INDEX_NO_NODE) return OVERFLOW_NODE(index->header->node_count++);
+        if (_read_node(index, node, buffer) != 1) return INDEX_NO_NODE;
+        index->header->free_node = ((index_node_t*)buffer)->link;
+        return node;
+    }
+
+    /*
+    Add entry to first node of bucket chain with free place. If chain full, overflow node linked to chain end.
+    */
+    static int _hash_add(index_t* __restrict index, unsigned int bucket, unsigned char* __restrict key, int row) {
+        unsigned char* node = (unsigned char*)malloc_s(index->header->node_size);
+        if (!node) return -1;
+
+        int status = -1;
+        index_node_t* header = (index_node_t*)node;
+        unsigned int current = BUCKET_NODE(bucket);
+        while (current != INDEX_NO_NODE && _read_node(index, current, node) == 1) {
+            if (header->count < NODE_CAPACITY(index)) {
+                _set_entry(index, NODE_ENTRY(index, node, header->count++), key, row, INDEX_NO_NODE);
+                status = _write_node(index, current, node);
+                break;
+            }
+
+            if (header->link == INDEX_NO_NODE) {
+                unsigned int overflow = _alloc_overflow(index, node);
+                if (overflow == INDEX_NO_NODE || _read_node(index, current, node) != 1) break;
+                header->link = overflow;
+                if (_write_node(index, current, node) != 1) break;
+
+                str_memset(node, 0, index->header->node_size);
+                header->is_leaf = 1;
+                header->count = 1;
+                _set_entry(index, NODE_ENTRY(index, node, 0), key, row, INDEX_NO_NODE);
+                status = _write_node(index, overflow, node);
+                break;
+            }
+
+            current = header->link;
+        }
+
+        free_s(node);
+        return status;
+    }
+
+    /*
+    Split bucket at split pointer. Entries of bucket chain rehashed between old and new bucket,
+    overflow nodes of chain moved to free list.
+    */
+    static int _hash_split(index_t* index) {
+        int entry_size = ENTRY_SIZE(index);
+        unsigned int buckets = INDEX_HASH_BUCKETS;
+        while (buckets * 2 <= index->header->bucket_count) buckets *= 2;
+        unsigned int split = index->header->bucket_count - buckets;
+
+        int count = 0, capacity = 0;
+        unsigned char* entries = NULL;
+        unsigned char* node = (unsigned char*)malloc_s(index->header->node_size);
+        if (!node) return -1;
+
+        int status = 1;
+        index_node_t* header = (index_node_t*)node;
+        unsigned int current = BUCKET_NODE(split);
+        while (current != INDEX_NO_NODE && status == 1) {
+            if (_read_node(index, current, node) != 1) {
+                status = -1;
+                break;
+            }
+
+            if (count + header->count > capacity) {
+                capacity = count + header->count + NODE_CAPACITY(index);
+                unsigned char* new_entries = (unsigned char*)realloc_s(entries, capacity * entry_size);
+                if (!new_entries) {
+                    status = -1;
+                    break;
+                }
+
+                entries = new_entries;
+            }
+
+            str_memcpy(entries + count * entry_size, NODE_ENTRY(index, node, 0), header->count * entry_size);
+            count += header->count;
+
+            unsigned int next = header->link;
+            if (current != BUCKET_NODE(split)) {
+                header->count = 0;
+                header->link = index->header->free_node;
+                index->header->free_node = current;
+                if (_write_node(index, current, node) != 1) status = -1;
+            }
+
+            current = next;
+        }
+
+        if (status == 1) {
+            str_memset(node, 0, index->header->node_size);
+            header->is_leaf = 1;
+            if (
+                _write_node(index, BUCKET_NODE(split), node) != 1 ||
+                _write_node(index, BUCKET_NODE(index->header->bucket_count), node) != 1
+            ) status = -1;
+        }
+
+        if (status == 1) {
+            index->header->bucket_count++;
+            index->is_dirty = 1;
+            for (int i = 0; i < count && status == 1; i++) {
+                unsigned char* entry = entries + i * entry_size;
+                status = _hash_add(index, _hash_bucket(index, entry), entry, _get_row(index, entry));
+            }
+        }
+
+        SOFT_FREE(entries);
+        free_s(node);
+        return status;
+    }
+
+    static int _hash_insert(index_t* __restrict index, unsigned char* __restrict key, int row) {
+        if (_hash_add(index, _hash_bucket(index, key), key, row) != 1) return -1;
+        index->header->entry_count++;
+        index->is_dirty = 1;
+
+        unsigned int limit = index->header->bucket_count * NODE_CAPACITY(index) * INDEX_HASH_LOAD / 100;
+        if (index->header->entry_count > limit) return _hash_split(index);
+        return 1;
+    }
+
+    static int _hash_delete(index_t* __restrict index, unsigned char* __restrict key, int row) {
+        index_node_t* header = (index_node_t*)index->node;
+        unsigned int current = BUCKET_NODE(_hash_bucket(index, key));
+        while (current != INDEX_NO_NODE) {
+            if (_read_node(index, current, index->node) != 1) return -1;
+            for (int i = 0; i < header->count; i++) {
+                if (_compare_entry(index, NODE_ENTRY(index, index->node, i), key, row)) continue;
+
+                // Order in bucket not important. Last entry moved to free place.
+                header->count--;
+                if (i != header->count) {
+                    str_memcpy(NODE_ENTRY(index, index->node, i), NODE_ENTRY(index, index->node, header->count), ENTRY_SIZE(index));
+                }
+
+                index->header->entry_count--;
+                index->is_dirty = 1;
+                return _write_node(index, current, index->node);
+            }
+
+            current = header->link;
+        }
+
+        return 0;
+    }
+
+    static int _hash_find(
+        index_t* __restrict index, unsigned char* __restrict key, int** rows, int* count, int* capacity
+    ) {
+        index_node_t* header = (index_node_t*)index->node;
+        unsigned int current = BUCKET_NODE(_hash_bucket(index, key));
+        while (current != INDEX_NO_NODE) {
+            if (_read_node(index, current, index->node) != 1) return -1;
+            for (int i = 0; i < header->count; i++) {
+                unsigned char* entry = NODE_ENTRY(index, index->node, i);
+                if (_compare_keys(index, entry, key)) continue;
+                if (_push_row(rows, count, capacity, _get_row(index, entry)) != 1) return -1;
+            }
+
+            current = header->link;
+        }
+
+        return 1;
+    }
+
+#pragma endregion
+
+#pragma region [Keys]
+
+    int IND_make_key(index_t* __restrict index, unsigned char* __restrict data, int data_size, unsigned char* __restrict key) {
+        str_memset(key, 0, index->header->key_size);
+        if (index->header->key_type == INDEX_KEY_RAW) {
+            if (data_size > index->header->key_size) return -1;
+            str_memcpy(key, data, data_size);
+            return 1;
+        }
+
+        // Same with expression compare, leading spaces skipped and value ends with first zero.
+        int start = 0, size = 0;
+        while (start < data_size && data[start] == ' ') start++;
+        while (start + size < data_size && data[start + size]) size++;
+
+        if (index->header->key_type == INDEX_KEY_INT) {
+            char number_buffer[32] = { 0 };
+            str_memcpy(number_buffer, data + start, MIN(size, (int)sizeof(number_buffer) - 1));
+            int value = atoi_s(number_buffer);
+            str_memcpy(key, &value, sizeof(int));
+            return 1;
+        }
+
+        if (index->header->key_type == INDEX_KEY_LONG) {
+            long long value = str_atoll((char*)data + start, size);
+            str_memcpy(key, &value, sizeof(long long));
+            return 1;
+        }
+
+        if (size > index->header->key_size) return -1;
+        str_memcpy(key, data + start, size);
+        return 1;
+    }
+
+    int IND_make_row_key(index_t* __restrict index, unsigned char* __restrict row, unsigned char* __restrict key) {
+        unsigned char* data = row + index->column_offset;
+        if (!index->is_binary || index->header->key_type == INDEX_KEY_RAW) return IND_make_key(index, data, index->column_size, key);
+
+        // Binary int column already contains key value.
+        str_memset(key, 0, index->header->key_size);
+        str_memcpy(key, data, MIN(index->column_size, index->header->key_size));
+        return 1;
+    }
+
+    int IND_insert_key(index_t* __restrict index, unsigned char* __restrict key, int row) {
+        if (index->header->type == INDEX_TYPE_HASH) return _hash_insert(index, key, row);
+        return _btree_insert(index, key, row);
+    }
+
+    int IND_delete_key(index_t* __restrict index, unsigned char* __restrict key, int row) {
+        if (index->header->type == INDEX_TYPE_HASH) return _hash_delete(index, key, row);
+        return _btree_delete(index, key, row);
+    }
+
+    int IND_find_rows(index_t* __restrict index, int operation, unsigned char* __restrict key, int** rows) {
+        *rows = NULL;
+        int count = 0, capacity = 0;
+        int status = -1;
+        if (index->header->type == INDEX_TYPE_BTREE) status = _btree_find(index, operation, key, rows, &count, &capacity);
+        else if (operation == INDEX_EQUALS) status = _hash_find(index, key, rows, &count, &capacity);
+        if (status != 1) {
+            SOFT_FREE(*rows);
+            return -1;
+        }
+
+        // Table processed in row order, that's why we sort rows here.
+        if (count > 1) _sort_rows(*rows, count);
+        return count;
+    }
+
+    int IND_update_row(table_t* __restrict table, unsigned char* old_data, unsigned char* new_data, int row) {
+        int updated = 0;
+        for (int i = 0; i < table->header->column_count; i++) {
+            if (!IS_COLUMN_INDEXED(table->columns[i]->type)) continue;
+            index_t* index = IND_load_index(table, i);
+            if (!index) continue;
+
+            unsigned char* key = (unsigned char*)malloc_s(index->header->key_size);
+            if (key) {
+                if (old_data && IND_make_row_key(index, old_data, key) == 1) {
+                    IND_delete_key(index, key, row);
+                }
+
+                if (new_data && IND_make_row_key(index, new_data, key) == 1) {
+                    IND_insert_key(index, key, row);
+                }
+
+                free_s(key);
+                updated++;
+            }
+
+            IND_flush_index(index);
+        }
+
+        return updated;
+    }
+
+    int IND_append_rows(table_t* __restrict table, unsigned char* __restrict data, int count, int* rows) {
+        int updated = 0;
+        for (int i = 0; i < table->header->column_count; i++) {
+            if (!IS_COLUMN_INDEXED(table->columns[i]->type)) continue;
+            index_t* index = IND_load_index(table, i);
+            if (!index) continue;
+
+            unsigned char* key = (unsigned char*)malloc_s(index->header->key_size);
+            if (key) {
+                for (int j = 0; j < count; j++) {
+                    unsigned char* row_data = data + j * table->row_size;
+                    if (IND_make_row_key(index, row_data, key) == 1) {
+                        IND_insert_key(index, key, rows[j]);
+                    }
+                }
+
+                free_s(key);
+                updated++;
+            }
+
+            IND_flush_index(index);
+        }
+
+        return updated;
+    }
+
+#pragma endregion
+
+#pragma region [Index]
+
+    static int _get_index_path(table_t* __restrict table, int column, char* __restrict path) {
+        return get_load_path(table->columns[column]->name, COLUMN_NAME_SIZE, path, table->header->name, INDEX_EXTENSION);
+    }
+
+    /*
+    Opened indexes. Row updates use opened index files, that's why index file opened and
+    header readed once, but not for every row. Header saved at every flush.
+    */
+    static index_t* _opened_indexes[INDEX_OPENED_COUNT] = { NULL };
+    static int _opened_next = 0;
+
+    static int _find_opened(table_t* table, int column) {
+        for (int i = 0; i < INDEX_OPENED_COUNT; i++) {
+            index_t* index = _opened_indexes[i];
+            if (index && index->column == column && !str_memcmp(index->table_name, table->header->name, TABLE_NAME_SIZE)) return i;
+        }
+
+        return -1;
+    }
+
+    static void _close_opened(int place) {
+        index_t* index = _opened_indexes[place];
+        _opened_indexes[place] = NULL;
+        index->is_cached = 0;
+        IND_free_index(index);
+    }
+
+    static void _add_opened(index_t* index) {
+        int place = -1;
+        for (int i = 0; i < INDEX_OPENED_COUNT && place < 0; i++) {
+            if (!_opened_indexes[i]) place = i;
+        }
+
+        if (place < 0) {
+            place = _opened_next;
+            _opened_next = (_opened_next + 1) % INDEX_OPENED_COUNT;
+            _close_opened(place);
+        }
+
+        index->is_cached = 1;
+        _opened_indexes[place] = index;
+    }
+
+    static index_t* _init_index(table_t* __restrict table, int column, ci_t ci, index_header_t* __restrict header) {
+        index_t* index = (index_t*)malloc_s(sizeof(index_t));
+        unsigned char* node = (unsigned char*)malloc_s(header->node_size);
+        encoded_t* encoded = (encoded_t*)malloc_s(header->node_size * sizeof(encoded_t));
+        if (!index || !node || !encoded) {
+            SOFT_FREE(index);
+            SOFT_FREE(node);
+            SOFT_FREE(encoded);
+            return NULL;
+        }
+
+        str_memset(index, 0, sizeof(index_t));
+        index->header  = header;
+        index->ci      = ci;
+        index->node    = node;
+        index->encoded = encoded;
+
+        index->is_binary   = GET_COLUMN_BINARY(table->columns[column]->type);
+        index->column_size = GET_COLUMN_STORED_SIZE(table->columns[column]);
+        for (int i = 0; i < column; i++) index->column_offset += GET_COLUMN_STORED_SIZE(table->columns[i]);
+        return index;
+    }
+
+    index_t* IND_create_index(table_t* table, int column) {
+        if (column < 0 || column >= table->header->column_count) return NULL;
+        table_column_t* target = table->columns[column];
+        if (GET_COLUMN_DATA_TYPE(target->type) == COLUMN_TYPE_MODULE) return NULL;
+
+        IND_delete_index(table, column);
+        char save_path[DEFAULT_PATH_SIZE] = { 0 };
+        _get_index_path(table, column, save_path);
+        ci_t ci = NIFAT32_open_content(NO_RCI, save_path, MODE((R_MODE | W_MODE | CR_MODE), FILE_TARGET));
+        if (ci < 0) {
+            print_error("Can't create index file [%s]", save_path);
+            return NULL;
+        }
+
+        index_header_t* header = (index_header_t*)malloc_s(sizeof(index_header_t));
+        if (!header) {
+            NIFAT32_close_content(ci);
+            return NULL;
+        }
+
+        str_memset(header, 0, sizeof(index_header_t));
+        header->magic = INDEX_MAGIC;
+        header->type = GET_COLUMN_INDEX(target->type) == COLUMN_INDEX_HASH ? INDEX_TYPE_HASH : INDEX_TYPE_BTREE;
+        if (header->type == INDEX_TYPE_HASH) header->key_type = INDEX_KEY_RAW;
+        else if (GET_COLUMN_DATA_TYPE(target->type) != COLUMN_TYPE_INT) header->key_type = INDEX_KEY_BYTES;
+        else if (GET_COLUMN_BINARY(target->type) && GET_COLUMN_STORED_SIZE(target) == sizeof(long long)) header->key_type = INDEX_KEY_LONG;
+        else header->key_type = INDEX_KEY_INT;
+
+        if (header->key_type == INDEX_KEY_INT) header->key_size = sizeof(int);
+        else if (header->key_type == INDEX_KEY_LONG) header->key_size = sizeof(long long);
+        else header->key_size = GET_COLUMN_STORED_SIZE(target);
+        header->node_size = MAX(INDEX_NODE_SIZE, sizeof(index_node_t) + INDEX_MIN_KEYS * (header->key_size + 2 * sizeof(int)));
+        header->root = INDEX_NO_NODE;
+        header->node_count = header->type == INDEX_TYPE_HASH ? 0 : 1;
+        header->bucket_count = header->type == INDEX_TYPE_HASH ? INDEX_HASH_BUCKETS : 0;
+        header->free_node = INDEX_NO_NODE;
+        header->checksum_type = DBMS_CHECKSUM;
+
+        index_t* index = _init_index(table, column, ci, header);
+        int status = index ? _save_header(index) : -1;
+        if (status == 1 && header->type == INDEX_TYPE_HASH) {
+            // Empty buckets written at creation, that's why bucket reads never miss.
+            str_memset(index->node, 0, header->node_size);
+            ((index_node_t*)index->node)->is_leaf = 1;
+            for (unsigned int i = 0; i < header->bucket_count && status == 1; i++) {
+                status = _write_node(index, BUCKET_NODE(i), index->node);
+            }
+        }
+
+        if (status != 1) {
+            if (index) IND_free_index(index);
+            else {
+                free_s(header);
+                NIFAT32_close_content(ci);
+            }
+
+            return NULL;
+        }
+
+        return index;
+    }
+
+    index_t* IND_load_index(table_t* table, int column) {
+        if (column < 0 || column >= table->header->column_count) return NULL;
+        char load_path[DEFAULT_PATH_SIZE] = { 0 };
+        _get_index_path(table, column, load_path);
+
+        index_t* loaded_index = NULL;
+        #pragma omp critical (opened_indexes)
+        {
+            int place = _find_opened(table, column);
+            if (place >= 0) loaded_index = _opened_indexes[place];
+        }
+
+        if (loaded_index) {
+            print_io("Loading index [%s] from opened indexes", load_path);
+            return loaded_index;
+        }
+
+        ci_t ci = NIFAT32_open_content(NO_RCI, load_path, DF_MODE);
+        if (ci < 0) {
+            print_warn("Index file [%s] not found", load_path);
+            return NULL;
+        }
+
+        encoded_t encoded_header[sizeof(index_header_t)] = { 0 };
+        index_header_t* header = (index_header_t*)malloc_s(sizeof(index_header_t));
+        if (!header || NIFAT32_read_content2buffer(
+            ci, 0, (buffer_t)encoded_header, sizeof(index_header_t) * sizeof(encoded_t)
+        ) != sizeof(index_header_t) * sizeof(encoded_t)) {
+            SOFT_FREE(header);
+            NIFAT32_close_content(ci);
+            return NULL;
+        }
+
+        unpack_memory(encoded_header, (byte_t*)header, sizeof(index_header_t));
+        index_t* index = NULL;
+        if (header->magic != INDEX_MAGIC) { print_error("Index file wrong magic for [%s]", load_path); }
+        else {
+            index = _init_index(table, column, ci, header);
+            if (index && IND_get_checksum(index) != header->checksum) {
+                print_error("Index file [%s] checksum mismatch", load_path);
+                index->header = NULL;
+                index->ci = -1;
+                IND_free_index(index);
+                index = NULL;
+            }
+        }
+
+        if (!index) {
+            free_s(header);
+            NIFAT32_close_content(ci);
+        }
+        else {
+            str_memcpy(index->table_name, table->header->name, TABLE_NAME_SIZE);
+            index->column = column;
+            #pragma omp critical (opened_indexes)
+            _add_opened(index);
+        }
+
+        return index;
+    }
+
+    int IND_flush_index(index_t* index) {
+        if (!index) return -2;
+        if (index->is_cached) {
+            if (index->is_dirty) _save_header(index);
+            return -1;
+        }
+
+        return IND_free_index(index);
+    }
+
+    int IND_free_index(index_t* index) {
+        if (!index) return -1;
+        int status = 1;
+        if (index->header && index->is_dirty) status = _save_header(index);
+        if (index->ci >= 0) NIFAT32_close_content(index->ci);
+
+        SOFT_FREE(index->header);
+        SOFT_FREE(index->node);
+        SOFT_FREE(index->encoded);
+        free_s(index);
+        return status;
+    }
+
+    int IND_delete_index(table_t* table, int column) {
+        // Opened index should be closed before file delete.
+        #pragma omp critical (opened_indexes)
+        {
+            int place = _find_opened(table, column);
+            if (place >= 0) _close_opened(place);
+        }
+
+        char delete_path[DEFAULT_PATH_SIZE] = { 0 };
+        _get_index_path(table, column, delete_path);
+        ci_t ci = NIFAT32_open_content(NO_RCI, delete_path, DF_MODE);
+        if (ci < 0) return 0;
+        if (!NIFAT32_delete_content(ci)) {
+            print_error("Can't delete index [%s]", delete_path);
+            return -1;
+        }
+
+        print_debug("Index [%s] was deleted", delete_path);
+        return 1;
+    }
+
+    int IND_delete_indexes(table_t* table) {
+        int deleted = 0;
+        for (int i = 0; i < table->header->column_count; i++) {
+            if (!IS_COLUMN_INDEXED(table->columns[i]->type)) continue;
+            deleted += IND_delete_index(table, i) == 1;
+        }
+
+        return deleted;
+    }
+
+    unsigned int IND_get_checksum(index_t* index) {
+        if (!index || !index->header) return 0;
+        unsigned int prev_checksum = index->header->checksum;
+        index->header->checksum = 0;
+        unsigned int _checksum = checksum_memory(
+            index->header->checksum_type, (const unsigned char*)index->header, sizeof(index_header_t), 0
+        );
+
+        index->header->checksum = prev_checksum;
+        return _checksum;
+    }
+
+#pragma endregion
@@ -1,37 +1,393 @@
+// pipe2 with O_CLOEXEC flag
+#define _GNU_SOURCE
 #include <module.h>
 
-int MDL_launch_module(char* module_name, char* args, unsigned char* buffer, size_t buffer_size) {
-    str_memset(buffer, ' ', buffer_size);
-    char module_path[DEFAULT_PATH_SIZE] = { 0 };
-    char command[256] = { 0 };
-    char result[128] = { 0 };
+static module_t _modules[MODULE_CACHE_SIZE];
+static int _module_count = 0;
 
-    sprintf(module_path, "%s%s.%s", MODULE_BASE_PATH, module_name, MODULE_EXTENSION);
-    if (!file_exists(module_path, NULL, NULL)) {
-        print_warn("Module not found");
-        return -1;
+/*
+Find module in cache or load it. Shared object without entry point and
+executable module cached without handle, that's why dlopen called once per module.
+
+Return NULL if cache is full.
+Return pointer to cached module.
+*/
+static module_t* _get_module(char* module_name, char* module_path) {
+    module_t* module = NULL;
+    #pragma omp critical (module_cache)
+    {
+        for (int i = 0; i < _module_count; i++) {
+            if (!str_strncmp(_modules[i].name, module_name, MODULE_NAME_SIZE)) {
+                module = &_modules[i];
+                break;
+            }
+        }
+
+        if (!module && _module_count < MODULE_CACHE_SIZE) {
+            module = &_modules[_module_count++];
+            str_memset(module, 0, sizeof(module_t));
+            str_strncpy(module->name, module_name, MODULE_NAME_SIZE);
+            module->is_found = file_exists(module_path, NULL, NULL) ? 1 : 0;
+            if (module->is_found) {
+                char library_path[DEFAULT_PATH_SIZE + 2] = { 0 };
+                snprintf(library_path, sizeof(library_path), "./%s", module_path);
+                module->handle = dlopen(library_path, RTLD_NOW | RTLD_LOCAL);
+                if (module->handle) {
+                    module->invoke = (mdl_invoke_t)dlsym(module->handle, MODULE_ENTRY);
+                    if (!module->invoke) {
+                        dlclose(module->handle);
+                        module->handle = NULL;
+                    }
+                }
+
+                print_debug("Module [%s] loaded as [%s]", module_name, module->invoke ? "shared object" : "executable");
+            }
+        }
+    }
+
+    return module;
+}
+
+/*
+Place module answer at right side of buffer. Large answer trunced.
+*/
+static void _put_answer(unsigned char* buffer, size_t buffer_size, char* answer, size_t answer_size) {
+    if (answer_size > buffer_size) {
+        print_warn("Module answer trunced [%lu > %lu]", answer_size, buffer_size);
     }
 
+    size_t offset = buffer_size > answer_size ? buffer_size - answer_size : 0;
+    str_memcpy(buffer + offset, answer, MIN(buffer_size, answer_size));
+}
+
+/*
+Launch executable module with popen. Used for modules without mdl_invoke entry.
+*/
+static int _launch_process(char* module_path, char* args, unsigned char* buffer, size_t buffer_size) {
+    char command[256] = { 0 };
+    char result[128] = { 0 };
+
     snprintf(command, sizeof(command), "./%s %s", module_path, args);
     FILE* fp = popen(command, "r");
     if (fp == NULL) {
-        print_error("Error executing command");
+        print_error("Module [%s] can't be executed", module_path);
         return -2;
     }
 
     fgets(result, sizeof(result), fp);
 
     int status = pclose(fp);
-    if (status == -1) print_error("Error closing pipe");
+    if (status == -1) {
+        print_error("Module [%s] pipe can't be closed", module_path);
+    }
     else {
         int exit_code = WEXITSTATUS(status);
-        print_log("Module [%s] exit code: [%d]", module_name, exit_code);
-        if (exit_code == 100) {
-            size_t result_len = str_strlen(result);
-            size_t offset = buffer_size > result_len ? buffer_size - result_len : 0;
-            str_memset(buffer + offset, result, MIN(buffer_size, result_len));
+        print_log("Module [%s] exit code: [%d]", module_path, exit_code);
+        if (exit_code == MODULE_SUCCESS) _put_answer(buffer, buffer_size, result, str_strlen(result));
+    }
+
+    return 1;
+}
+
+#pragma region [Worker]
+
+    /*
+    Write whole data to pipe. SIGPIPE blocked only during write, that's why crashed worker
+    gives EPIPE error instead of dbms termination, and signal handling of dbms don't change.
+
+    Return -1 if pipe closed (Worker crashed).
+    Return 1 if data written.
+    */
+    static int _write_pipe(int fd, unsigned char* data, size_t size) {
+        sigset_t pipe_set, old_set, pending_set;
+        sigemptyset(&pipe_set);
+        sigaddset(&pipe_set, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+        sigpending(&pending_set);
+        int was_pending = sigismember(&pending_set, SIGPIPE);
+
+        int result = 1;
+        while (size > 0 && result == 1) {
+            ssize_t written = write(fd, data, size);
+            if (written <= 0) result = -1;
+            else {
+                data += written;
+                size -= written;
+            }
+        }
+
+        // SIGPIPE from this write consumed before mask restore
+        if (result != 1 && !was_pending) {
+            struct timespec no_wait = { 0, 0 };
+            sigtimedwait(&pipe_set, NULL, &no_wait);
+        }
+
+        pthread_sigmask(SIG_SETMASK, &old_set, NULL);
+        return result;
+    }
+
+    /*
+    Read whole data from pipe with MODULE_WORKER_TIMEOUT.
+
+    Return -1 if pipe closed or worker don't answer.
+    Return 1 if data readed.
+    */
+    static int _read_pipe(int fd, void* buffer, size_t size) {
+        unsigned char* data = (unsigned char*)buffer;
+        while (size > 0) {
+            struct pollfd request = { .fd = fd, .events = POLLIN };
+            if (poll(&request, 1, MODULE_WORKER_TIMEOUT) <= 0) return -1;
+
+            ssize_t readed = read(fd, data, size);
+            if (readed <= 0) return -1;
+            data += readed;
+            size -= readed;
         }
+
+        return 1;
     }
 
+    static void _stop_worker(module_worker_t* worker) {
+        if (worker->pid > 0) {
+            close(worker->input);
+            close(worker->output);
+            kill(worker->pid, SIGKILL);
+            waitpid(worker->pid, NULL, 0);
+        }
+
+        worker->pid = 0;
+    }
+
+    /*
+    Start module with MODULE_WORKER_ARG and wait worker magic.
+
+    Return -1 if module don't support worker mode.
+    Return 1 if worker started.
+    */
+    static int _start_worker(module_worker_t* worker, char* module_path) {
+        char worker_path[DEFAULT_PATH_SIZE + 2] = { 0 };
+        snprintf(worker_path, sizeof(worker_path), "./%s", module_path);
+
+        // Pipes created with O_CLOEXEC, that's why workers (And modules started by popen in other threads)
+        // don't inherit pipes of other workers. Worker gets own ends as stdin / stdout by dup2.
+        int to_worker[2], from_worker[2];
+        if (pipe2(to_worker, O_CLOEXEC)) return -1;
+        if (pipe2(from_worker, O_CLOEXEC)) {
+            close(to_worker[0]);
+            close(to_worker[1]);
+            return -1;
+        }
+
+        int pid = fork();
+        if (!pid) {
+            dup2(to_worker[0], STDIN_FILENO);
+            dup2(from_worker[1], STDOUT_FILENO);
+            close(to_worker[0]);
+            close(from_worker[1]);
+            execl(worker_path, worker_path, MODULE_WORKER_ARG, (char*)NULL);
+            _exit(127);
+        }
+
+        close(to_worker[0]);
+        close(from_worker[1]);
+        if (pid < 0) {
+            close(to_worker[1]);
+            close(from_worker[0]);
+            return -1;
+        }
+
+        worker->pid    = pid;
+        worker->input  = to_worker[1];
+        worker->output = from_worker[0];
+
+        unsigned int magic = 0;
+        if (_read_pipe(worker->output, &magic, sizeof(magic)) != 1 || magic != MODULE_WORKER_MAGIC) {
+            _stop_worker(worker);
+            return -1;
+        }
+
+        return 1;
+    }
+
+    /*
+    Send batch to worker and read answers. Answer with MODULE_SUCCESS code placed to buffer.
+
+    Return -1 if worker crashed or broke protocol.
+    Return 1 if batch processed.
+    */
+    static int _worker_batch(module_worker_t* worker, char** args, unsigned char** buffers, int count, size_t buffer_size) {
+        size_t request_size = sizeof(unsigned int);
+        for (int i = 0; i < count; i++) request_size += 2 * sizeof(unsigned int) + str_strlen(args[i]) + buffer_size;
+
+        unsigned char* request = (unsigned char*)malloc_s(request_size);
+        if (!request) return -2;
+
+        unsigned char* pointer = request;
+        unsigned int header[2] = { (unsigned int)count, 0 };
+        str_memcpy(pointer, header, sizeof(unsigned int));
+        pointer += sizeof(unsigned int);
+        for (int i = 0; i < count; i++) {
+            header[0] = str_strlen(args[i]);
+            header[1] = buffer_size;
+            str_memcpy(pointer, header, sizeof(header));
+            str_memcpy(pointer + sizeof(header), args[i], header[0]);
+            str_memcpy(pointer + sizeof(header) + header[0], buffers[i], buffer_size);
+            pointer += sizeof(header) + header[0] + buffer_size;
+        }
+
+        // Request buffer reused for answers. Answers applied after whole batch,
+        // that's why batch can be repeated with same input after worker crash.
+        int* codes = (int*)request;
+        unsigned char* answers = request + count * 2 * sizeof(int);
+        int result = _write_pipe(worker->input, request, request_size);
+        for (int i = 0; i < count && result == 1; i++) {
+            if (
+                _read_pipe(worker->output, codes + i * 2, 2 * sizeof(int)) != 1 ||
+                (unsigned int)codes[i * 2 + 1] > buffer_size ||
+                (codes[i * 2 + 1] && _read_pipe(worker->output, answers + i * buffer_size, codes[i * 2 + 1]) != 1)
+            ) result = -1;
+        }
+
+        for (int i = 0; i < count && result == 1; i++) {
+            str_memset(buffers[i], ' ', buffer_size);
+            if (codes[i * 2] == MODULE_SUCCESS) _put_answer(buffers[i], buffer_size, (char*)(answers + i * buffer_size), codes[i * 2 + 1]);
+        }
+
+        free_s(request);
+        return result;
+    }
+
+    /*
+    Process batch with module worker. Worker restarted once, if it crashed during batch.
+
+    Return -1 if batch should be processed without worker.
+    Return 1 if batch processed.
+    */
+    static int _launch_worker(module_t* module, char* module_path, char** args, unsigned char** buffers, int count, size_t buffer_size) {
+        if (module->no_worker) return -1;
+
+        // Concurrent batches limited by count of workers
+        module_worker_t* worker = NULL;
+        while (!worker) {
+            #pragma omp critical (module_cache)
+            {
+                for (int i = 0; i < MODULE_WORKER_LIMIT; i++) {
+                    if (!module->workers[i].is_busy) {
+                        worker = &module->workers[i];
+                        worker->is_busy = 1;
+                        break;
+                    }
+                }
+            }
+
+            // All workers busy. Wait for release of worker by other batch.
+            if (!worker) {
+                struct timespec wait = { 0, MODULE_WORKER_WAIT };
+                nanosleep(&wait, NULL);
+            }
+        }
+
+        int result = -1;
+        for (int attempt = 0; attempt < 2 && result != 1 && !module->no_worker; attempt++) {
+            if (!worker->pid && _start_worker(worker, module_path) != 1) {
+                print_warn("Module [%s] worker can't be started", module->name);
+                result = -1;
+            }
+            else result = _worker_batch(worker, args, buffers, count, buffer_size);
+
+            #pragma omp critical (module_cache)
+            {
+                if (result == 1) {
+                    module->is_worker = 1;
+                    module->failures  = 0;
+                }
+                else {
+                    _stop_worker(worker);
+                    // Module without worker mode fail at first start
+                    if (!module->is_worker || ++module->failures >= MODULE_WORKER_RETRIES) module->no_worker = 1;
+                }
+            }
+        }
+
+        #pragma omp critical (module_cache)
+        worker->is_busy = 0;
+        return result;
+    }
+
+#pragma endregion
+
+/*
+Invoke shared object module in process. Module get copy of column data,
+that's why it can use current value (PRELOAD / POSTLOAD transformations).
+*/
+static int _launch_shared(module_t* module, char* args, unsigned char* buffer, size_t buffer_size) {
+    unsigned char* in = (unsigned char*)malloc_s(buffer_size * 2 + 1);
+    if (!in) return -2;
+
+    unsigned char* out = in + buffer_size;
+    str_memcpy(in, buffer, buffer_size);
+    str_memset(out, 0, buffer_size + 1);
+    str_memset(buffer, ' ', buffer_size);
+
+    int exit_code = module->invoke(args, in, out, buffer_size);
+    if (exit_code == MODULE_SUCCESS) _put_answer(buffer, buffer_size, (char*)out, str_strlen((char*)out));
+    else {
+        print_log("Module [%s] return code: [%d]", module->name, exit_code);
+    }
+
+    free_s(in);
     return 1;
 }
+
+int MDL_launch_module(char* module_name, char* args, unsigned char* buffer, size_t buffer_size) {
+    return MDL_launch_batch(module_name, &args, &buffer, 1, buffer_size);
+}
+
+int MDL_launch_batch(char* module_name, char** args, unsigned char** buffers, int count, size_t buffer_size) {
+    char module_path[DEFAULT_PATH_SIZE] = { 0 };
+    snprintf(module_path, sizeof(module_path), "%s%.*s.%s", MODULE_BASE_PATH, MODULE_NAME_SIZE, module_name, MODULE_EXTENSION);
+
+    module_t* module = _get_module(module_name, module_path);
+    if (module && module->invoke) {
+        for (int i = 0; i < count; i++) {
+            if (_launch_shared(module, args[i], buffers[i], buffer_size) != 1) return -2;
+        }
+
+        return 1;
+    }
+
+    if (module ? !module->is_found : !file_exists(module_path, NULL, NULL)) {
+        for (int i = 0; i < count; i++) str_memset(buffers[i], ' ', buffer_size);
+        print_warn("Module not found");
+        return -1;
+    }
+
+    for (int start = 0; start < count; start += MODULE_BATCH_SIZE) {
+        int part = MIN(MODULE_BATCH_SIZE, count - start);
+        if (module && _launch_worker(module, module_path, args + start, buffers + start, part, buffer_size) == 1) continue;
+        for (int i = start; i < start + part; i++) {
+            str_memset(buffers[i], ' ', buffer_size);
+            if (_launch_process(module_path, args[i], buffers[i], buffer_size) != 1) return -2;
+        }
+    }
+
+    return 1;
+}
+
+int MDL_unload_modules() {
+    int closed = 0;
+    #pragma omp critical (module_cache)
+    {
+        for (int i = 0; i < _module_count; i++) {
+            for (int j = 0; j < MODULE_WORKER_LIMIT; j++) _stop_worker(&_modules[i].workers[j]);
+            if (_modules[i].handle) {
+                dlclose(_modules[i].handle);
+                closed++;
+            }
+        }
+
+        _module_count = 0;
+    }
+
+    return closed;
+}
@@ -1,6 +1,56 @@
 #include <pageman.h>
 
-page_t* PGM_create_page(char* __restrict name, unsigned char* __restrict buffer, size_t data_size) {
+/*
+First page header (PAGE_BASE_MAGIC). Header followed by encoded content with default page size.
+*/
+typedef struct {
+    unsigned char magic;
+    char name[PAGE_NAME_SIZE];
+    checksum_t checksum;
+} __attribute__((packed)) page_base_header_t;
+
+/*
+Convert first header to current layout. Free-extent map marked as invalid,
+and will be rebuilt with page scan at first free space request.
+*/
+static int _migrate_base_header(encoded_t* encoded_header, page_header_t* header) {
+    page_base_header_t base;
+    unpack_memory(encoded_header, (byte_t*)&base, sizeof(page_base_header_t));
+
+    str_memset(header, 0, sizeof(page_header_t));
+    header->magic         = PAGE_MAGIC;
+    str_memcpy(header->name, base.name, PAGE_NAME_SIZE);
+    header->checksum_type = CHECKSUM_MURMUR3;
+    header->extent_count  = PAGE_EXTENTS_INVALID;
+    header->page_size     = PAGE_CONTENT_SIZE;
+    return sizeof(page_base_header_t) * sizeof(encoded_t);
+}
+
+/*
+Allocate page buffers for provided page size. Content, plain image and slot map
+placed in one memory block (Released with content pointer).
+
+Params:
+- page - pointer to page.
+- page_size - page content size.
+
+Return 0 if allocation failed.
+Return 1 if allocation was success.
+*/
+static int _alloc_page_buffers(page_t* page, unsigned int page_size) {
+    size_t buffers_size = page_size * sizeof(encoded_t) + page_size + PAGE_SLOTS_MAP_SIZE(page_size);
+    unsigned char* buffers = (unsigned char*)malloc_s(buffers_size);
+    if (!buffers) return 0;
+
+    str_memset(buffers, 0, buffers_size);
+    page->content = (unsigned short*)buffers;
+    page->plain   = buffers + page_size * sizeof(encoded_t);
+    page->slots   = page->plain + page_size;
+    return 1;
+}
+
+page_t* PGM_create_page(char* __restrict name, unsigned char* __restrict buffer, size_t data_size, unsigned int page_size) {
+    if (page_size < PAGE_MIN_SIZE || page_size > PAGE_MAX_SIZE) return NULL;
     page_t* page = (page_t*)malloc_s(sizeof(page_t));
     page_header_t* header = (page_header_t*)malloc_s(sizeof(page_header_t));
     if (!page || !header) {
@@ -11,29 +61,47 @@ page_t* PGM_create_page(char* __restrict name, unsigned char* __restrict buffer,
 
     str_memset(page, 0, sizeof(page_t));
     str_memset(header, 0, sizeof(page_header_t));
+    if (!_alloc_page_buffers(page, page_size)) {
+        free_s(page);
+        free_s(header);
+        return NULL;
+    }
 
     header->magic = PAGE_MAGIC;
+    header->extent_count = PAGE_EXTENTS_INVALID;
+    header->page_size = page_size;
+    header->checksum_type = DBMS_CHECKSUM;
     str_strncpy(header->name, name, PAGE_NAME_SIZE);
     page->lock = NULL_LOCK;
     page->append_offset = -1;
 
     page->header = header;
-    if (buffer != NULL) str_memset(page->content, buffer, data_size);
-    for (int i = data_size + 1; i < PAGE_CONTENT_SIZE; i++) {
-        page->content[i] = encode_hamming_15_11(PAGE_EMPTY);
-    }
+    data_size = MIN(data_size, (size_t)page_size);
+    str_memset(page->plain, PAGE_EMPTY, page_size);
+    if (buffer != NULL) str_memcpy(page->plain, buffer, data_size);
+    page->is_decoded = 1;
+    page->is_dirty   = 1;
     
     return page;
 }
 
-page_t* PGM_create_empty_page(char* base_path) {
+page_t* PGM_create_empty_page(char* base_path, unsigned int page_size, unsigned char flags, unsigned short slot_size) {
     char* unique_name = generate_unique_filename(base_path, PAGE_NAME_SIZE, PAGE_EXTENSION);
     if (!unique_name) return NULL;
 
-    page_t* page = PGM_create_page(unique_name, NULL, 0);
+    page_t* page = PGM_create_page(unique_name, NULL, 0, page_size);
+    if (!page) {
+        SOFT_FREE(unique_name);
+        return NULL;
+    }
+
+    if (!slot_size || slot_size > page_size) flags &= ~PAGE_FLAG_SLOTTED;
+    page->header->flags     = flags;
+    page->header->slot_size = flags & PAGE_FLAG_SLOTTED ? slot_size : 0;
     page->base_path = (char*)malloc_s(str_strlen(base_path) + 1);
     if (!page->base_path) {
         SOFT_FREE(unique_name);
+        PGM_free_page(page);
         return NULL;
     }
 
@@ -43,92 +111,241 @@ page_t* PGM_create_empty_page(char* base_path) {
     return page;
 }
 
+/*
+Widen dirty range to sectors of page file. Content placed after header and slot map,
+that's why sector borders don't match page offsets.
+*/
+static void _align_range(int content_offset, int page_size, int* start, int* end) {
+    int sector_size = DSK_get_sector_size();
+    if (sector_size <= 0) return;
+    int file_start = (content_offset + *start * (int)sizeof(encoded_t)) / sector_size * sector_size;
+    int file_end   = (content_offset + *end * (int)sizeof(encoded_t) + sector_size - 1) / sector_size * sector_size;
+    *start = MAX(file_start - content_offset, 0) / (int)sizeof(encoded_t);
+    *end   = MIN((file_end - content_offset) / (int)sizeof(encoded_t), page_size);
+}
+
 int PGM_save_page(page_t* page) {
+    // Clean page. Nothing changed since load or last save.
+    if (!page->is_dirty) return 1;
+
     int status = -1;
+    int page_size = PAGE_SIZE_OF(page);
+    int slots_size = PAGE_SLOTS_MAP_BYTES(page->header);
+    int content_offset = (sizeof(page_header_t) + slots_size) * sizeof(decoded_t);
+    int is_full = !page->is_stored || (page->header->flags & PAGE_FLAG_COMPRESSED);
+
+    // Compressed page store encoded compressed image. If page can't be compressed, we store it as is.
+    page->header->compressed_size = 0;
+    if (page->header->flags & PAGE_FLAG_COMPRESSED) {
+        unsigned char* compressed = (unsigned char*)malloc_s(page_size);
+        if (compressed) {
+            int compressed_size = compress_memory(page->plain, page_size, compressed, page_size - 1);
+            if (compressed_size > 0) {
+                pack_memory(compressed, (void*)page->content, compressed_size);
+                page->header->compressed_size = compressed_size;
+            }
+
+            free_s(compressed);
+        }
+    }
+
+    if (!page->header->compressed_size) {
+        if (is_full) pack_memory(page->plain, (void*)page->content, page_size);
+        else {
+            for (int i = 0; i < page->dirty_count; i++) {
+                page_extent_t* range = &page->dirty_ranges[i];
+                int start = range->offset, end = range->offset + range->length;
+                _align_range(content_offset, page_size, &start, &end);
+                pack_memory(page->plain + start, (void*)(page->content + start), end - start);
+                range->offset = start;
+                range->length = end - start;
+            }
+        }
+    }
+
+    // Checksum computed from header and whole encoded content. Content buffer keeps
+    // encoded image of stored page, that's why not dirty sectors are up to date here.
     checksum_t page_cheksum = 0;
     #ifndef NO_PAGE_SAVE_OPTIMIZATION
     page_cheksum = PGM_get_checksum(page);
-    if (page_cheksum != page->header->checksum)
     #endif
-    {
-        char save_path[DEFAULT_PATH_SIZE] = { 0 };
-        get_load_path(page->header->name, PAGE_NAME_SIZE, save_path, page->base_path, PAGE_EXTENSION);   
-        ci_t ci = NIFAT32_open_content(NO_RCI, save_path, MODE(CR_MODE, FILE_TARGET));
-        if (ci < 0) { print_error("Can't save or create [%s] file", save_path); }
-        else {
-            status = 1;
-            page->header->checksum = page_cheksum;
-            unsigned short encoded_header[sizeof(page_header_t)] = { 0 };
-            pack_memory((byte_t*)page->header, (decoded_t*)encoded_header, sizeof(page_header_t));
-            
-            if (status == 1 && NIFAT32_write_buffer2content(
-                ci, 0, (const_buffer_t)&encoded_header, sizeof(page_header_t) * sizeof(decoded_t)
-            ) != sizeof(page_header_t) * sizeof(decoded_t)) status = -2;
 
-            if (status == 1 && NIFAT32_write_buffer2content(
-                ci, sizeof(page_header_t) * sizeof(decoded_t), 
-                (const_buffer_t)page->content, PAGE_CONTENT_SIZE * sizeof(decoded_t)
-            ) != PAGE_CONTENT_SIZE * sizeof(decoded_t)) status = -3;
+    char save_path[DEFAULT_PATH_SIZE] = { 0 };
+    get_load_path(page->header->name, PAGE_NAME_SIZE, save_path, page->base_path, PAGE_EXTENSION);   
+    ci_t ci = NIFAT32_open_content(NO_RCI, save_path, MODE(CR_MODE, FILE_TARGET));
+    if (ci < 0) { print_error("Can't save or create [%s] file", save_path); }
+    else {
+        status = 1;
+        page->header->checksum = page_cheksum;
+        unsigned short encoded_header[sizeof(page_header_t)] = { 0 };
+        pack_memory((byte_t*)page->header, (decoded_t*)encoded_header, sizeof(page_header_t));
+        
+        if (status == 1 && NIFAT32_write_buffer2content(
+            ci, 0, (const_buffer_t)&encoded_header, sizeof(page_header_t) * sizeof(decoded_t)
+        ) != sizeof(page_header_t) * sizeof(decoded_t)) status = -2;
 
-            NIFAT32_close_content(ci);
+        int offset = sizeof(page_header_t) * sizeof(decoded_t);
+        if (slots_size > 0) {
+            encoded_t* encoded_slots = (encoded_t*)malloc_s(slots_size * sizeof(encoded_t));
+            if (!encoded_slots) status = -2;
+            else {
+                pack_memory(page->slots, encoded_slots, slots_size);
+                if (status == 1 && NIFAT32_write_buffer2content(
+                    ci, offset, (const_buffer_t)encoded_slots, slots_size * sizeof(decoded_t)
+                ) != slots_size * (int)sizeof(decoded_t)) status = -2;
+                free_s(encoded_slots);
+            }
+        }
+
+        if (is_full) {
+            int content_size = page->header->compressed_size ? (int)page->header->compressed_size : page_size;
+            if (status == 1 && NIFAT32_write_buffer2content(
+                ci, content_offset, (const_buffer_t)page->content, content_size * sizeof(decoded_t)
+            ) != content_size * (int)sizeof(decoded_t)) status = -3;
         }
+        else {
+            // Write only sectors with modified content.
+            for (int i = 0; i < page->dirty_count && status == 1; i++) {
+                page_extent_t* range = &page->dirty_ranges[i];
+                if (NIFAT32_write_buffer2content(
+                    ci, content_offset + range->offset * sizeof(decoded_t), 
+                    (const_buffer_t)(page->content + range->offset), range->length * sizeof(decoded_t)
+                ) != (int)(range->length * sizeof(decoded_t))) status = -3;
+            }
+        }
+
+        NIFAT32_close_content(ci);
+    }
+
+    if (status == 1) {
+        page->is_dirty    = 0;
+        page->is_stored   = 1;
+        page->dirty_count = 0;
     }
 
     return status;
 }
 
-page_t* PGM_load_page(char* base_path, char* name) {
-    char load_path[DEFAULT_PATH_SIZE] = { 0 };
-    get_load_path(name, PAGE_NAME_SIZE, load_path, base_path, PAGE_EXTENSION);
+/*
+Read page file from disk. Page will not be added to GCT.
 
-    page_t* loaded_page = (page_t*)CHC_find_entry(name, base_path, PAGE_CACHE);
-    if (loaded_page) {
-        print_io("Loading page [%s] from GCT", load_path);
-        return loaded_page;
-    }
+Params:
+- load_path - Path to page file.
 
+Return NULL if page can't be loaded.
+Return pointer to page struct (Without base path).
+*/
+static page_t* _read_page(char* load_path) {
+    page_t* loaded_page = NULL;
     ci_t ci = NIFAT32_open_content(NO_RCI, load_path, DF_MODE);
     print_io("Loading page [%s]", load_path);
     if (ci < 0) { print_error("Page not found! Path: [%s]", load_path); }
     else {
         page_header_t* header = (page_header_t*)malloc_s(sizeof(page_header_t));
         if (header) {
-            int offset = 0;
+            int offset = 0, is_migrated = 0;
             str_memset(header, 0, sizeof(page_header_t));
 
             encoded_t encoded_header[sizeof(page_header_t)] = { 0 };
             NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_header, sizeof(page_header_t) * sizeof(unsigned short));
             unpack_memory((encoded_t*)encoded_header, (byte_t*)header, sizeof(page_header_t));
             offset += sizeof(page_header_t) * sizeof(unsigned short);
+            if (header->magic == PAGE_BASE_MAGIC) {
+                print_warn("Page [%s] has first header layout. Migrating...", load_path);
+                offset = _migrate_base_header(encoded_header, header);
+                is_migrated = 1;
+            }
 
             if (header->magic != PAGE_MAGIC) {
                 print_error("Page file wrong magic for [%s]", load_path);
                 free_s(header);
                 NIFAT32_close_content(ci);
+            }
+            else if (
+                header->page_size < PAGE_MIN_SIZE || header->page_size > PAGE_MAX_SIZE ||
+                ((header->flags & PAGE_FLAG_SLOTTED) && (!header->slot_size || header->slot_size > header->page_size)) ||
+                header->compressed_size >= header->page_size
+            ) {
+                print_error("Page file wrong layout for [%s]", load_path);
+                free_s(header);
+                NIFAT32_close_content(ci);
             } 
             else {
+                int page_size = (int)header->page_size;
                 page_t* page = (page_t*)malloc_s(sizeof(page_t));
-                if (!page) free_s(header);
+                if (page) str_memset(page, 0, sizeof(page_t));
+                if (!page || !_alloc_page_buffers(page, page_size)) {
+                    SOFT_FREE(page);
+                    free_s(header);
+                    NIFAT32_close_content(ci);
+                    return NULL;
+                }
                 else {
+                    // Encoded slot map fit in content buffer, that's why we use it before content loading.
+                    int slots_size = PAGE_SLOTS_MAP_BYTES(header);
+                    if (slots_size > 0) {
+                        encoded_t* encoded_slots = (encoded_t*)page->content;
+                        NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_slots, slots_size * sizeof(encoded_t));
+                        unpack_memory(encoded_slots, page->slots, slots_size);
+                        offset += slots_size * sizeof(encoded_t);
+                    }
+
                     unsigned short encoded_pm = encode_hamming_15_11((unsigned short)PAGE_EMPTY);
-                    for (int i = 0; i < PAGE_CONTENT_SIZE; i++) page->content[i] = encoded_pm;
-                    NIFAT32_read_content2buffer(ci, offset, (buffer_t)page->content, PAGE_CONTENT_SIZE * sizeof(unsigned short));
+                    int content_size = header->compressed_size ? (int)header->compressed_size : page_size;
+                    for (int i = 0; i < page_size; i++) page->content[i] = encoded_pm;
+                    NIFAT32_read_content2buffer(ci, offset, (buffer_t)page->content, content_size * sizeof(unsigned short));
                     NIFAT32_close_content(ci);
 
                     page->lock   = NULL_LOCK;
                     page->header = header;
                     loaded_page  = page;
                     page->append_offset = -1;
+                    page->is_cached  = 0;
+                    page->is_decoded = 0;
+                    page->is_dirty   = 0;
+                    page->is_stored  = 1;
 
-                    CHC_add_entry(
-                        loaded_page, loaded_page->header->name, base_path, PAGE_CACHE, 
-                        (void*)PGM_free_page, (void*)PGM_save_page
-                    );
+                    // Content placed after header, that's why migrated page rewritten fully at next save.
+                    if (is_migrated) {
+                        PGM_get_plain(page);
+                        page->is_dirty  = 1;
+                        page->is_stored = 0;
+                    }
+
+                    // Compressed page can't be searched in encoded form, that's why we decode it here.
+                    if (header->compressed_size) {
+                        str_memset(page->plain, PAGE_EMPTY, page_size);
+                        unsigned char* compressed = (unsigned char*)malloc_s(content_size);
+                        if (compressed) unpack_memory((void*)page->content, compressed, content_size);
+                        int decompressed = compressed ? decompress_memory(compressed, content_size, page->plain, page_size) : -1;
+                        SOFT_FREE(compressed);
+                        if (decompressed != page_size) {
+                            print_error("Page [%s] compressed content is broken", load_path);
+                            PGM_free_page(page);
+                            return NULL;
+                        }
+
+                        page->is_decoded = 1;
+                    }
                 }
             }
         }
     }
 
+    return loaded_page;
+}
+
+/*
+Set page base path.
+
+Params:
+- loaded_page - Pointer to page.
+- base_path - Base path of page.
+
+Return NULL if allocation failed (Page will be released).
+Return pointer to page.
+*/
+static page_t* _set_base_path(page_t* loaded_page, char* base_path) {
     loaded_page->base_path = (char*)malloc_s(str_strlen(base_path) + 1);
     if (!loaded_page->base_path) {
         PGM_free_page(loaded_page);
@@ -139,6 +356,26 @@ page_t* PGM_load_page(char* base_path, char* name) {
     return loaded_page;
 }
 
+page_t* PGM_load_page(char* base_path, char* name) {
+    char load_path[DEFAULT_PATH_SIZE] = { 0 };
+    get_load_path(name, PAGE_NAME_SIZE, load_path, base_path, PAGE_EXTENSION);
+
+    page_t* loaded_page = (page_t*)CHC_find_entry(name, base_path, PAGE_CACHE);
+    if (loaded_page) {
+        print_io("Loading page [%s] from GCT", load_path);
+        return loaded_page;
+    }
+
+    loaded_page = _read_page(load_path);
+    if (!loaded_page) return NULL;
+    CHC_add_entry(
+        loaded_page, loaded_page->header->name, base_path, PAGE_CACHE, 
+        (void*)PGM_free_page, (void*)PGM_save_page
+    );
+
+    return _set_base_path(loaded_page, base_path);
+}
+
 int PGM_flush_page(page_t* page) {
     if (!page) return -2;
     if (page->is_cached) return -1;
@@ -150,6 +387,7 @@ int PGM_free_page(page_t* page) {
     if (!page) return -1;
     SOFT_FREE(page->header);
     SOFT_FREE(page->base_path);
+    SOFT_FREE(page->content);
     SOFT_FREE(page);
     return 1;
 }
@@ -159,12 +397,13 @@ unsigned int PGM_get_checksum(page_t* page) {
     unsigned int prev_checksum = page->header->checksum;
     page->header->checksum = 0;
 
+    int algorithm = page->header->checksum_type;
     unsigned int _checksum = 0;
     if (page->header) {
-        _checksum = murmur3_x86_32((const unsigned char*)page->header, sizeof(page_header_t), 0);
+        _checksum = checksum_memory(algorithm, (const unsigned char*)page->header, sizeof(page_header_t), 0);
     }
 
     page->header->checksum = prev_checksum;
-    _checksum = murmur3_x86_32((const unsigned char*)page->content, sizeof(page->content), 0);
+    _checksum = checksum_memory(algorithm, (const unsigned char*)page->content, page->header->page_size * sizeof(encoded_t), _checksum);
     return _checksum;
 }
@@ -1,18 +1,272 @@
 #include <pageman.h>
 
-int PGM_get_content(page_t* __restrict page, int offset, unsigned char* __restrict buffer, size_t data_length) {
-    int end_index = MIN(PAGE_CONTENT_SIZE, (int)data_length + offset);
-    for (int i = offset, j = 0; i < end_index && j < (int)data_length; i++, j++) {
-        buffer[j] = (byte_t)decode_hamming_15_11(page->content[i]);
+/*
+Count empty bytes in plain page content.
+*/
+static int _count_free(page_t* page, int start, int end) {
+    int count = 0;
+    unsigned char* plain = PGM_get_plain(page);
+    for (int i = start; i < end; i++) count += plain[i] == PAGE_EMPTY;
+    return count;
+}
+
+static int _add_extent(page_header_t* header, int offset, int length) {
+    if (header->extent_count >= PAGE_EXTENTS_COUNT) {
+        header->extent_count = PAGE_EXTENTS_INVALID;
+        return -1;
+    }
+
+    int index = header->extent_count;
+    while (index > 0 && header->extents[index - 1].offset > (unsigned int)offset) {
+        header->extents[index] = header->extents[index - 1];
+        index--;
+    }
+
+    header->extents[index].offset = offset;
+    header->extents[index].length = length;
+    header->extent_count++;
+    return 1;
+}
+
+/*
+Add [start, end) range to page dirty ranges. Touched ranges merged together.
+If page has too many ranges, all ranges merged to one.
+*/
+static void _mark_dirty(page_t* page, int start, int end) {
+    page->is_dirty = 1;
+    for (int i = 0; i < page->dirty_count;) {
+        page_extent_t* range = &page->dirty_ranges[i];
+        int range_end = range->offset + range->length;
+        if ((int)range->offset > end || range_end < start) {
+            i++;
+            continue;
+        }
+
+        start = MIN(start, (int)range->offset);
+        end   = MAX(end, range_end);
+        page->dirty_ranges[i] = page->dirty_ranges[--page->dirty_count];
+    }
+
+    if (page->dirty_count == PAGE_DIRTY_RANGES_COUNT) {
+        for (int i = 0; i < page->dirty_count; i++) {
+            start = MIN(start, (int)page->dirty_ranges[i].offset);
+            end   = MAX(end, (int)(page->dirty_ranges[i].offset + page->dirty_ranges[i].length));
+        }
+
+        page->dirty_count = 0;
     }
 
+    page->dirty_ranges[page->dirty_count].offset = start;
+    page->dirty_ranges[page->dirty_count].length = end - start;
+    page->dirty_count++;
+}
+
+#pragma region [Slots]
+
+    #define SLOT_COUNT(page)        (PAGE_SIZE_OF(page) / (page)->header->slot_size)
+    #define GET_SLOT(page, slot)    (((page)->slots[(slot) / 8] >> ((slot) % 8)) & 1)
+    #define SET_SLOT(page, slot)    ((page)->slots[(slot) / 8] |= (1 << ((slot) % 8)))
+    #define CLEAR_SLOT(page, slot)  ((page)->slots[(slot) / 8] &= ~(1 << ((slot) % 8)))
+
+    /*
+    Find first free slot. We skip full bytes of slot map, that's why we don't check every slot.
+    Return -1 if page don't have free slots.
+    */
+    static int _find_free_slot(page_t* page, int slot) {
+        int slot_count = SLOT_COUNT(page);
+        while (slot < slot_count) {
+            if (!(slot % 8) && page->slots[slot / 8] == 0xFF) slot += 8;
+            else if (GET_SLOT(page, slot)) slot++;
+            else return slot;
+        }
+
+        return -1;
+    }
+
+    /*
+    Get end of free space, that starts at provided free slot.
+    Note: Last slot in page also own page tail.
+    */
+    static int _get_free_end(page_t* page, int slot) {
+        int slot_count = SLOT_COUNT(page);
+        while (slot < slot_count && !GET_SLOT(page, slot)) slot++;
+        return slot == slot_count ? PAGE_SIZE_OF(page) : slot * page->header->slot_size;
+    }
+
+    static int _slotted_free_space(page_t* page, int offset) {
+        if (offset == -1) {
+            int count = PAGE_SIZE_OF(page) - SLOT_COUNT(page) * page->header->slot_size;
+            for (int i = 0; i < SLOT_COUNT(page); i++) count += !GET_SLOT(page, i) * page->header->slot_size;
+            return count;
+        }
+
+        int slot = offset / page->header->slot_size;
+        if (slot >= SLOT_COUNT(page)) return PAGE_SIZE_OF(page) - offset;
+        if (GET_SLOT(page, slot)) return 0;
+        return _get_free_end(page, slot) - offset;
+    }
+
+    static int _slotted_fit_free_space(page_t* page, int offset, int size) {
+        int slot = _find_free_slot(page, 0);
+        if (slot < 0) return -1;
+        if (offset == -1) return slot * page->header->slot_size;
+
+        slot = _find_free_slot(page, MAX(slot, (offset + page->header->slot_size - 1) / page->header->slot_size));
+        while (slot >= 0) {
+            int end = _get_free_end(page, slot);
+            if (end - slot * page->header->slot_size >= size) return slot * page->header->slot_size;
+            slot = _find_free_slot(page, end / page->header->slot_size);
+        }
+
+        return -2;
+    }
+
+    static int _slotted_max_free_space(page_t* page) {
+        int max_free = 0;
+        int slot = _find_free_slot(page, 0);
+        while (slot >= 0) {
+            int end = _get_free_end(page, slot);
+            max_free = MAX(max_free, end - slot * page->header->slot_size);
+            slot = _find_free_slot(page, end / page->header->slot_size);
+        }
+
+        return max_free;
+    }
+
+    /*
+    Mark slots, that intersect [start, end) range, as used.
+    */
+    static void _mark_slots(page_t* page, int start, int end) {
+        int last_slot = MIN((end - 1) / page->header->slot_size, SLOT_COUNT(page) - 1);
+        for (int i = start / page->header->slot_size; i <= last_slot; i++) SET_SLOT(page, i);
+    }
+
+    /*
+    Mark slots, that fully covered by [start, end) range, as tombstones.
+    */
+    static void _clear_slots(page_t* page, int start, int end) {
+        int last_slot = MIN(end / page->header->slot_size, SLOT_COUNT(page)) - 1;
+        for (int i = (start + page->header->slot_size - 1) / page->header->slot_size; i <= last_slot; i++) CLEAR_SLOT(page, i);
+    }
+
+#pragma endregion
+
+/*
+Page scan fallback for pages with fragmented free space (Free-extent map overflow).
+*/
+static int _scan_free_space(page_t* page, int offset) {
+    int count = 0;
+    unsigned char* plain = PGM_get_plain(page);
+    for (int i = MAX(offset, 0); i < PAGE_SIZE_OF(page); i++) {
+        if (plain[i] == PAGE_EMPTY) count++;
+        else if (offset != -1) break;
+    }
+
+    return count;
+}
+
+static int _scan_fit_free_space(page_t* page, int offset, int size) {
+    int index = 0;
+    unsigned char* plain = PGM_get_plain(page);
+    while (plain[index] != PAGE_EMPTY) {
+        if (++index >= PAGE_SIZE_OF(page)) return -1;
+    }
+
+    if (offset == -1) return index;
+    for (int i = MAX(offset, index); i < PAGE_SIZE_OF(page); i++) {
+        if (plain[i] == PAGE_EMPTY) {
+            int free_index = i;
+            for (int current_size = 0; i < PAGE_SIZE_OF(page) && plain[i] == PAGE_EMPTY; i++, current_size++) {
+                if (current_size >= size) return free_index;
+            }
+        }
+    }
+
+    return -2;
+}
+
+/*
+Update free-extent map after write to [start, end) range.
+We only rescan written range. Extents, that touch this range, merged with new runs.
+*/
+static void _update_free_map(page_t* page, int start, int end, int prev_free) {
+    page_header_t* header = page->header;
+    if (header->extent_count == PAGE_EXTENTS_INVALID) return;
+    header->free_space += _count_free(page, start, end) - prev_free;
+
+    int left = -1, right = -1;
+    for (int i = 0; i < header->extent_count;) {
+        page_extent_t* extent = &header->extents[i];
+        int extent_end = extent->offset + extent->length;
+        if ((int)extent->offset > end || extent_end < start) {
+            i++;
+            continue;
+        }
+
+        if ((int)extent->offset < start) left = extent->offset;
+        if (extent_end > end) right = extent_end;
+        for (int j = i; j < header->extent_count - 1; j++) header->extents[j] = header->extents[j + 1];
+        header->extent_count--;
+    }
+
+    int run = left;
+    unsigned char* plain = page->plain;
+    for (int i = start; i < end; i++) {
+        if (plain[i] == PAGE_EMPTY) {
+            if (run < 0) run = i;
+        }
+        else if (run >= 0) {
+            if (_add_extent(header, run, i - run) < 0) return;
+            run = -1;
+        }
+    }
+
+    if (right >= 0) _add_extent(header, run >= 0 ? run : end, right - (run >= 0 ? run : end));
+    else if (run >= 0) _add_extent(header, run, end - run);
+}
+
+/*
+Get valid free-extent map. If map invalid, it will be rebuilt with page scan.
+
+Return NULL if page has more runs of empty bytes, than PAGE_EXTENTS_COUNT.
+Return page header with valid map.
+*/
+static page_header_t* _get_free_map(page_t* page) {
+    page_header_t* header = page->header;
+    if (header->extent_count != PAGE_EXTENTS_INVALID) return header;
+
+    unsigned char* plain = PGM_get_plain(page);
+    header->extent_count = 0;
+    header->free_space   = 0;
+    for (int i = 0; i < PAGE_SIZE_OF(page);) {
+        if (plain[i] != PAGE_EMPTY) {
+            i++;
+            continue;
+        }
+
+        int run = i;
+        while (i < PAGE_SIZE_OF(page) && plain[i] == PAGE_EMPTY) i++;
+        if (_add_extent(header, run, i - run) < 0) return NULL;
+        header->free_space += i - run;
+    }
+
+    return header;
+}
+
+int PGM_get_content(page_t* __restrict page, int offset, unsigned char* __restrict buffer, size_t data_length) {
+    int end_index = MIN(PAGE_SIZE_OF(page), (int)data_length + offset);
+    if (end_index > offset) str_memcpy(buffer, PGM_get_plain(page) + offset, end_index - offset);
     return end_index - offset;
 }
 
 int PGM_insert_content(page_t* __restrict page, int offset, unsigned char* __restrict data, size_t data_length) {
-    int end_index = MIN(PAGE_CONTENT_SIZE, (int)data_length + offset);
-    for (int i = offset, j = 0; i < end_index && j < (int)data_length; i++, j++) {
-        page->content[i] = encode_hamming_15_11((unsigned short)data[j]);
+    int end_index = MIN(PAGE_SIZE_OF(page), (int)data_length + offset);
+    if (end_index > offset) {
+        int prev_free = _count_free(page, offset, end_index);
+        str_memcpy(PGM_get_plain(page) + offset, data, end_index - offset);
+        if (page->header->flags & PAGE_FLAG_SLOTTED) _mark_slots(page, offset, end_index);
+        else _update_free_map(page, offset, end_index, prev_free);
+        _mark_dirty(page, offset, end_index);
     }
 
     return end_index - offset;
@@ -20,51 +274,120 @@ int PGM_insert_content(page_t* __restrict page, int offset, unsigned char* __res
 
 int PGM_delete_content(page_t* page, int offset, size_t length) {
 #ifndef NO_DELETE_COMMAND
-    int end_index = MIN(PAGE_CONTENT_SIZE, (int)length + offset);
-    for (int i = offset; i < end_index; i++) page->content[i] = encode_hamming_15_11((unsigned short)PAGE_EMPTY);
+    int end_index = MIN(PAGE_SIZE_OF(page), (int)length + offset);
+    if (end_index > offset) {
+        int prev_free = _count_free(page, offset, end_index);
+        str_memset(PGM_get_plain(page) + offset, PAGE_EMPTY, end_index - offset);
+        if (page->header->flags & PAGE_FLAG_SLOTTED) _clear_slots(page, offset, end_index);
+        else _update_free_map(page, offset, end_index, prev_free);
+        _mark_dirty(page, offset, end_index);
+    }
+
     return end_index - offset;
 #endif
     return 1;
 }
 
 int PGM_find_content(page_t* __restrict page, int offset, unsigned char* __restrict data, size_t data_size) {
-    if (offset >= PAGE_CONTENT_SIZE) return -2;
+    if (offset >= PAGE_SIZE_OF(page)) return -2;
+    if (!data_size) return offset;
+    if (!page->is_decoded) {
+        // Page not decoded yet. Search directly in encoded content without decoding whole page.
+        int index = find_packed_memory((void*)(page->content + offset), PAGE_SIZE_OF(page) - offset, data, data_size);
+        return index < 0 ? -1 : index + offset;
+    }
 
-    int data_index = 0;
-    for (int i = offset; i < PAGE_CONTENT_SIZE - (int)data_size; i++) {
-        if (data_index >= (int)data_size) return i - data_size;
-        if (data[data_index] == decode_hamming_15_11(page->content[i])) data_index++;
-        else data_index = 0;
+    unsigned char* plain = page->plain;
+    for (int i = offset; i <= PAGE_SIZE_OF(page) - (int)data_size; i++) {
+        if (plain[i] != data[0]) continue;
+        if (!str_memcmp(plain + i + 1, data + 1, data_size - 1)) return i;
     }
 
     return -1;
 }
 
 int PGM_get_free_space(page_t* page, int offset) {
-    int count = 0;
-    for (int i = offset; i < PAGE_CONTENT_SIZE; i++) {
-        if (decode_hamming_15_11(page->content[i]) == PAGE_EMPTY) count++;
-        else if (offset != -1) break;
+    if (page->header->flags & PAGE_FLAG_SLOTTED) return _slotted_free_space(page, offset);
+    page_header_t* header = _get_free_map(page);
+    if (!header) return _scan_free_space(page, offset);
+    if (offset == -1) return header->free_space;
+
+    for (int i = 0; i < header->extent_count; i++) {
+        page_extent_t* extent = &header->extents[i];
+        if (extent->offset > (unsigned int)offset) break;
+        if (extent->offset + extent->length > (unsigned int)offset) return extent->offset + extent->length - offset;
     }
 
-    return count;
+    return 0;
 }
 
 int PGM_get_fit_free_space(page_t* page, int offset, int size) {
-    int index = 0;
-    while (decode_hamming_15_11(page->content[index]) != PAGE_EMPTY) {
-        if (++index > PAGE_CONTENT_SIZE) return -1;
-    }
+    if (page->header->flags & PAGE_FLAG_SLOTTED) return _slotted_fit_free_space(page, offset, size);
+    page_header_t* header = _get_free_map(page);
+    if (!header) return _scan_fit_free_space(page, offset, size);
+    if (!header->extent_count) return -1;
 
+    int index = header->extents[0].offset;
     if (offset == -1) return index;
-    for (int i = MAX(offset, index); i < PAGE_CONTENT_SIZE; i++) {
-        if (decode_hamming_15_11(page->content[i]) == PAGE_EMPTY) {
-            int free_index = i;
-            for (int current_size = 0; i < PAGE_CONTENT_SIZE && decode_hamming_15_11(page->content[i]) == PAGE_EMPTY; i++, current_size++) {
-                if (current_size >= size) return free_index;
-            }
-        }
+
+    // Note: Same with page scan, we return block, that have more than size empty bytes.
+    offset = MAX(offset, index);
+    for (int i = 0; i < header->extent_count; i++) {
+        page_extent_t* extent = &header->extents[i];
+        int free_index = MAX((int)extent->offset, offset);
+        if ((int)(extent->offset + extent->length) - free_index > size) return free_index;
     }
 
     return -2;
 }
+
+int PGM_get_max_free_space(page_t* page) {
+    if (page->header->flags & PAGE_FLAG_SLOTTED) return _slotted_max_free_space(page);
+    int max_free = 0;
+    page_header_t* header = _get_free_map(page);
+    if (header) {
+        for (int i = 0; i < header->extent_count; i++) max_free = MAX(max_free, (int)header->extents[i].length);
+    }
+    else {
+        unsigned char* plain = PGM_get_plain(page);
+        for (int i = 0, run = 0; i < PAGE_SIZE_OF(page); i++) {
+            run = plain[i] == PAGE_EMPTY ? run + 1 : 0;
+            max_free = MAX(max_free, run);
+        }
+    }
+
+    // Note: Same with PGM_get_fit_free_space, block should have more than size empty bytes.
+    return MAX(max_free - 1, 0);
+}
+
+unsigned char* PGM_get_plain(page_t* page) {
+    if (!page->is_decoded) {
+        unpack_memory((void*)page->content, page->plain, PAGE_SIZE_OF(page));
+        page->is_decoded = 1;
+    }
+
+    return page->plain;
+}
+
+int PGM_compact_page(page_t* page) {
+    if (!(page->header->flags & PAGE_FLAG_SLOTTED)) return -1;
+
+    int moved = 0;
+    int slot_size = page->header->slot_size;
+    unsigned char* plain = PGM_get_plain(page);
+    for (int source = 0, target = 0; source < SLOT_COUNT(page); source++) {
+        if (!GET_SLOT(page, source)) continue;
+        if (source != target) {
+            str_memcpy(plain + target * slot_size, plain + source * slot_size, slot_size);
+            str_memset(plain + source * slot_size, PAGE_EMPTY, slot_size);
+            CLEAR_SLOT(page, source);
+            SET_SLOT(page, target);
+            moved++;
+        }
+
+        target++;
+    }
+
+    if (moved) _mark_dirty(page, 0, SLOT_COUNT(page) * slot_size);
+    return moved;
+}
@@ -0,0 +1,224 @@
+#include <tabman.h>
+
+static int _is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static int _is_name_char(char c) {
+    return _is_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static unsigned char _get_opcode(char c) {
+    switch (c) {
+        case '+': return CALC_OP_ADD;
+        case '-': return CALC_OP_SUB;
+        case '*': return CALC_OP_MUL;
+        case '/': return CALC_OP_DIV;
+        case '%': return CALC_OP_MOD;
+        case '^': return CALC_OP_POW;
+        default: return CALC_OP_NUMBER;
+    }
+}
+
+/*
+Operator precedence. Same with calc module.
+*/
+static int _get_precedence(unsigned char opcode) {
+    switch (opcode) {
+        case CALC_OP_ADD:
+        case CALC_OP_SUB: return 9;
+        case CALC_OP_MUL:
+        case CALC_OP_DIV:
+        case CALC_OP_MOD: return 10;
+        case CALC_OP_POW: return 11;
+        default: return 0;
+    }
+}
+
+/*
+Find column by name in formula and save column place in text row.
+
+Return -1 if column not found.
+Return 1 if column found.
+*/
+static int _get_column_place(table_t* __restrict table, const char* __restrict name, int length, calc_instruction_t* __restrict instruction) {
+    if (length > COLUMN_NAME_SIZE) return -1;
+
+    int offset = 0;
+    for (int i = 0; i < table->header->column_count; i++) {
+        table_column_t* column = table->columns[i];
+        if (!str_strncmp(column->name, name, length) && (length == COLUMN_NAME_SIZE || !column->name[length])) {
+            instruction->opcode = CALC_OP_COLUMN;
+            instruction->offset = offset;
+            instruction->size   = column->size;
+            return 1;
+        }
+
+        offset += column->size;
+    }
+
+    return -1;
+}
+
+/*
+Compile formula with shunting-yard algorithm. Operands pushed to program directly,
+operators wait in stack. Stack depth checked here, that's why evaluation don't check it.
+
+Return -1 if formula is wrong.
+Return 1 if formula compiled.
+*/
+static int _compile_formula(table_t* __restrict table, const char* __restrict formula, calc_program_t* __restrict program) {
+    char operators[CALC_PROGRAM_SIZE] = { 0 };
+    int operators_count = 0, depth = 0, length = 0;
+    while (length < COLUMN_MODULE_SIZE && formula[length]) length++;
+
+    // Operators moved from stack to program with depth check
+    #define EMIT_OPERATOR(operator)                                                 \
+        if (--depth < 1 || program->count >= CALC_PROGRAM_SIZE) return -1;         \
+        program->code[program->count++].opcode = (operator);
+
+    program->count = 0;
+    for (int i = 0; i < length;) {
+        char c = formula[i];
+        if (c == ' ' || c == '\t') {
+            i++;
+            continue;
+        }
+
+        if (_is_name_char(c) && program->count >= CALC_PROGRAM_SIZE) return -1;
+        if (_is_digit(c)) {
+            long long value = 0;
+            while (i < length && _is_digit(formula[i])) value = value * 10 + (formula[i++] - '0');
+            program->code[program->count].opcode = CALC_OP_NUMBER;
+            program->code[program->count++].value = value;
+            depth++;
+        }
+        else if (_is_name_char(c)) {
+            int start = i;
+            while (i < length && _is_name_char(formula[i])) i++;
+            if (_get_column_place(table, formula + start, i - start, &program->code[program->count++]) != 1) return -1;
+            depth++;
+        }
+        else if (c == '(') {
+            operators[operators_count++] = c;
+            i++;
+        }
+        else if (c == ')') {
+            while (operators_count > 0 && operators[operators_count - 1] != '(') {
+                EMIT_OPERATOR(_get_opcode(operators[--operators_count]));
+            }
+
+            if (!operators_count) return -1;
+            operators_count--;
+            i++;
+        }
+        else {
+            unsigned char opcode = _get_opcode(c);
+            if (opcode == CALC_OP_NUMBER) return -1;
+
+            // Power is right associative, other operators are left associative
+            while (operators_count > 0 && operators[operators_count - 1] != '(') {
+                int top = _get_precedence(_get_opcode(operators[operators_count - 1]));
+                int current = _get_precedence(opcode);
+                if (opcode == CALC_OP_POW ? top <= current : top < current) break;
+                EMIT_OPERATOR(_get_opcode(operators[--operators_count]));
+            }
+
+            operators[operators_count++] = c;
+            i++;
+        }
+    }
+
+    while (operators_count > 0) {
+        char c = operators[--operators_count];
+        if (c == '(') return -1;
+        EMIT_OPERATOR(_get_opcode(c));
+    }
+
+    #undef EMIT_OPERATOR
+    return depth == 1 ? 1 : -1;
+}
+
+int TBM_compile_calcs(table_t* table) {
+    SOFT_FREE(table->programs);
+
+    int compiled = 0;
+    for (int i = 0; i < table->header->column_count; i++) {
+        table_column_t* column = table->columns[i];
+        if (
+            GET_COLUMN_DATA_TYPE(column->type) != COLUMN_TYPE_MODULE ||
+            str_strncmp(column->module_name, CALC_MODULE_NAME, MODULE_NAME_SIZE)
+        ) continue;
+
+        if (!table->programs) {
+            table->programs = (calc_program_t*)malloc_s(table->header->column_count * sizeof(calc_program_t));
+            if (!table->programs) return -1;
+            str_memset(table->programs, 0, table->header->column_count * sizeof(calc_program_t));
+        }
+
+        if (_compile_formula(table, column->module_querry, &table->programs[i]) != 1) {
+            print_warn("Calc formula [%.*s] can't be compiled. Column will use calc module", COLUMN_MODULE_SIZE, column->module_querry);
+            table->programs[i].count = 0;
+            continue;
+        }
+
+        compiled++;
+    }
+
+    return compiled;
+}
+
+static long long _calc_pow(long long base, long long exponent) {
+    // Same with truncated pow() for negative exponents
+    if (exponent < 0) return base == 1 ? 1 : base == -1 ? (exponent & 1 ? -1 : 1) : 0;
+
+    unsigned long long result = 1, factor = (unsigned long long)base;
+    while (exponent) {
+        if (exponent & 1) result *= factor;
+        factor *= factor;
+        exponent >>= 1;
+    }
+
+    return (long long)result;
+}
+
+int TBM_eval_calc(calc_program_t* __restrict program, unsigned char* __restrict row, long long* __restrict result) {
+    long long stack[CALC_PROGRAM_SIZE];
+    int top = 0;
+    for (int i = 0; i < program->count; i++) {
+        calc_instruction_t* instruction = &program->code[i];
+        switch (instruction->opcode) {
+            case CALC_OP_NUMBER:
+                stack[top++] = instruction->value;
+                continue;
+
+            case CALC_OP_COLUMN:
+                stack[top++] = str_atoll((char*)row + instruction->offset, instruction->size);
+                continue;
+        }
+
+        // Overflow wraps around instead of undefined behaviour
+        unsigned long long left = stack[top - 2], right = stack[--top];
+        switch (instruction->opcode) {
+            case CALC_OP_ADD: stack[top - 1] = (long long)(left + right); break;
+            case CALC_OP_SUB: stack[top - 1] = (long long)(left - right); break;
+            case CALC_OP_MUL: stack[top - 1] = (long long)(left * right); break;
+            case CALC_OP_DIV:
+            case CALC_OP_MOD:
+                if (!right) return -1;
+                if ((long long)right == -1) {
+                    stack[top - 1] = instruction->opcode == CALC_OP_DIV ? (long long)(0 - left) : 0;
+                    break;
+                }
+
+                if (instruction->opcode == CALC_OP_DIV) stack[top - 1] /= (long long)right;
+                else stack[top - 1] %= (long long)right;
+                break;
+
+            case CALC_OP_POW: stack[top - 1] = _calc_pow((long long)left, (long long)right); break;
+        }
+    }
+
+    *result = stack[0];
+    return 1;
+}
@@ -20,13 +20,22 @@ table_column_t* TBM_create_column(unsigned char type, unsigned short size, char*
 int TBM_get_column_info(table_t* table, char* column_name, table_columns_info_t* info) {
     info->offset = -1;
     info->size = -1;
+    info->index = -1;
+    info->text_offset = -1;
+    info->text_size = -1;
 
-    int offset = 0;
+    int offset = 0, text_offset = 0;
     for (int i = 0; i < table->header->column_count; i++) {
-        if (str_strcmp(table->columns[i]->name, column_name)) offset += table->columns[i]->size;
+        if (str_strcmp(table->columns[i]->name, column_name)) {
+            offset += GET_COLUMN_STORED_SIZE(table->columns[i]);
+            text_offset += table->columns[i]->size;
+        }
         else {
             info->offset = offset;
-            info->size = table->columns[i]->size;
+            info->size = GET_COLUMN_STORED_SIZE(table->columns[i]);
+            info->index = i;
+            info->text_offset = text_offset;
+            info->text_size = table->columns[i]->size;
             return 1;
         }
     }
@@ -34,20 +43,45 @@ int TBM_get_column_info(table_t* table, char* column_name, table_columns_info_t*
     return -1;
 }
 
+/*
+Check that int value fits stored size of binary column. Columns with less than 10 symbols
+stored as int and always fit it. Wider columns stored as long long, that's why value with
+19 and more digits can overflow (Same with TBM_make_zone_filter range check).
+
+Return 1 if value fits column (Range is -LLONG_MAX - LLONG_MAX).
+Return 0 if value overflows long long.
+*/
+static int _is_binary_fit(const char* value, int length) {
+    int index = 0;
+    while (index < length && value[index] == ' ') index++;
+    if (index < length && (value[index] == '-' || value[index] == '+')) index++;
+    while (index < length && value[index] == '0') index++;
+
+    int start = index;
+    while (index < length && value[index] >= '0' && value[index] <= '9') index++;
+    int digits = index - start;
+    if (digits != 19) return digits < 19;
+    return str_strncmp(value + start, "9223372036854775807", 19) <= 0;
+}
+
 int TBM_check_signature(table_t* __restrict table, unsigned char* __restrict data) {
 #ifndef DISABLE_CHECK_SIGNATURE
     unsigned char* data_pointer = data;
     for (int i = 0; i < table->header->column_count; i++) {
+        // Skipped columns moves data pointer too, that's why next columns checked with own values.
+        unsigned char* column_data = data_pointer;
+        data_pointer += table->columns[i]->size;
+
         unsigned char data_type = GET_COLUMN_DATA_TYPE(table->columns[i]->type);
         if (data_type == COLUMN_TYPE_ANY || data_type == COLUMN_TYPE_MODULE) continue;
 
         char value[COLUMN_MAX_SIZE] = { 0 };
-        str_strncpy(value, (char*)data_pointer, table->columns[i]->size);
-        data_pointer += table->columns[i]->size;
+        str_strncpy(value, (char*)column_data, table->columns[i]->size);
 
         switch (data_type) {
             case COLUMN_TYPE_INT:
                 if (!is_integer(value)) return -2;
+                if (GET_COLUMN_BINARY(table->columns[i]->type) && !_is_binary_fit(value, table->columns[i]->size)) return -2;
                 break;
 
             case COLUMN_TYPE_STRING: break;
@@ -57,3 +91,56 @@ int TBM_check_signature(table_t* __restrict table, unsigned char* __restrict dat
 #endif
     return 1;
 }
+
+int TBM_encode_row(table_t* __restrict table, unsigned char* __restrict text, unsigned char* __restrict row) {
+    for (int i = 0; i < table->header->column_count; i++) {
+        table_column_t* column = table->columns[i];
+        if (!GET_COLUMN_BINARY(column->type)) str_memcpy(row, text, column->size);
+        else {
+            long long value = str_atoll((char*)text, column->size);
+            if (GET_COLUMN_STORED_SIZE(column) == sizeof(int)) {
+                int short_value = (int)value;
+                str_memcpy(row, &short_value, sizeof(int));
+            }
+            else str_memcpy(row, &value, sizeof(long long));
+        }
+
+        row  += GET_COLUMN_STORED_SIZE(column);
+        text += column->size;
+    }
+
+    return 1;
+}
+
+int TBM_decode_row(table_t* __restrict table, unsigned char* __restrict row, unsigned char* __restrict text) {
+    // Deleted rows marked by first byte. Mark should stay in text row.
+    if (*row == PAGE_EMPTY) {
+        str_memset(text, PAGE_EMPTY, table->text_size);
+        return 1;
+    }
+
+    for (int i = 0; i < table->header->column_count; i++) {
+        table_column_t* column = table->columns[i];
+        if (!GET_COLUMN_BINARY(column->type)) str_memcpy(text, row, column->size);
+        else {
+            long long value = 0;
+            if (GET_COLUMN_STORED_SIZE(column) == sizeof(int)) {
+                int short_value = 0;
+                str_memcpy(&short_value, row, sizeof(int));
+                value = short_value;
+            }
+            else str_memcpy(&value, row, sizeof(long long));
+
+            // Value padded by zeros to column size. If value larger than column, low digits saved.
+            char buffer[32] = { 0 };
+            int length = sprintf(buffer, "%0*lld", MIN(column->size, 30), value);
+            str_memset(text, '0', column->size);
+            str_memcpy(text + MAX(column->size - length, 0), buffer + MAX(length - column->size, 0), MIN(length, column->size));
+        }
+
+        row  += GET_COLUMN_STORED_SIZE(column);
+        text += column->size;
+    }
+
+    return 1;
+}
@@ -1,13 +1,58 @@
 #include <tabman.h>
 
-table_t* TBM_create_table(char* __restrict name, table_column_t** __restrict columns, int col_count) {
+/*
+First table header (TABLE_BASE_MAGIC). Tables of this layout have default page size,
+murmur3 checksum and one byte directory count.
+*/
+typedef struct {
+    unsigned char magic;
+    char name[TABLE_NAME_SIZE];
+    unsigned char access;
+    unsigned char column_count;
+    unsigned int row_count;
+    unsigned char dir_count;
+    checksum_t checksum;
+} __attribute__((packed)) table_base_header_t;
+
+/*
+Convert first header to current layout. Checksum dropped, that's why migrated table
+will be saved with new layout at next save.
+*/
+static int _migrate_base_header(decoded_t* encoded_header, table_header_t* header) {
+    table_base_header_t base;
+    unpack_memory(encoded_header, (byte_t*)&base, sizeof(table_base_header_t));
+
+    str_memset(header, 0, sizeof(table_header_t));
+    header->magic         = TABLE_MAGIC;
+    str_memcpy(header->name, base.name, TABLE_NAME_SIZE);
+    header->access        = base.access;
+    header->column_count  = base.column_count;
+    header->row_count     = base.row_count;
+    header->dir_count     = base.dir_count;
+    header->page_size     = PAGE_CONTENT_SIZE;
+    header->checksum_type = CHECKSUM_MURMUR3;
+    return sizeof(table_base_header_t) * sizeof(decoded_t);
+}
+
+table_t* TBM_create_table(
+    char* __restrict name, table_column_t** __restrict columns, int col_count, unsigned char page_flags, unsigned int page_size
+) {
 #ifndef NO_CREATE_COMMAND
-    int row_size = 0;
+    int row_size = 0, text_size = 0;
     for (int i = 0; i < col_count; i++) {
-        row_size += columns[i]->size;
+        // Binary bytes can look like free space (PAGE_EMPTY) in page scan and like deleted row mark in first column.
+        // That's why binary columns work only in slotted tables and not at row start.
+        if (GET_COLUMN_BINARY(columns[i]->type) && (!i || !(page_flags & PAGE_FLAG_SLOTTED))) {
+            print_warn("Column [%.*s] stored as text. Binary int needs slotted table and not first column.", COLUMN_NAME_SIZE, columns[i]->name);
+            columns[i]->type = SET_COLUMN_BINARY(columns[i]->type, 0);
+        }
+
+        row_size  += GET_COLUMN_STORED_SIZE(columns[i]);
+        text_size += columns[i]->size;
     }
 
-    if (row_size >= PAGE_CONTENT_SIZE) return NULL;
+    if (page_size < PAGE_MIN_SIZE || page_size > PAGE_MAX_SIZE) return NULL;
+    if (row_size >= (int)page_size) return NULL;
     table_t* table = (table_t*)malloc_s(sizeof(table_t));
     table_header_t* header = (table_header_t*)malloc_s(sizeof(table_header_t));
     if (!table || !header) {
@@ -22,12 +67,17 @@ table_t* TBM_create_table(char* __restrict name, table_column_t** __restrict col
     header->magic  = TABLE_MAGIC;
     str_strncpy(header->name, name, TABLE_NAME_SIZE);
     header->column_count = col_count;
+    header->page_flags   = page_flags;
+    header->page_size    = page_size;
+    header->checksum_type = DBMS_CHECKSUM;
 
     table->columns  = columns;
-    table->row_size = row_size;
+    table->row_size  = row_size;
+    table->text_size = text_size;
     
     table->lock = NULL_LOCK;
     table->header = header;
+    TBM_compile_calcs(table);
     return table;
 #endif
     return NULL;
@@ -72,7 +122,7 @@ int TBM_save_table(table_t* table) {
                 offset += sizeof(table_column_t) * sizeof(decoded_t);
             }
 
-            for (int i = 0; i < table->header->dir_count; i++) {
+            for (unsigned int i = 0; i < table->header->dir_count; i++) {
                 decoded_t encoded_directory_name[sizeof(table_header_t)] = { 0 };
                 pack_memory((byte_t*)table->dir_names[i], (decoded_t*)encoded_directory_name, DIRECTORY_NAME_SIZE);
                 if (status == 1 && NIFAT32_write_buffer2content(
@@ -114,11 +164,21 @@ table_t* TBM_load_table(char* name) {
             NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_header, sizeof(table_header_t) * sizeof(decoded_t));
             unpack_memory((decoded_t*)encoded_header, (unsigned char*)header, sizeof(table_header_t));
             offset += sizeof(table_header_t) * sizeof(decoded_t);
+            if (header->magic == TABLE_BASE_MAGIC) {
+                print_warn("Table [%s] has first header layout. Migrating...", load_path);
+                offset = _migrate_base_header(encoded_header, header);
+            }
+
             if (header->magic != TABLE_MAGIC) {
                 print_error("Table file wrong magic for [%s]", load_path);
                 SOFT_FREE(header);
                 NIFAT32_close_content(ci);
             } 
+            else if (header->page_size < PAGE_MIN_SIZE || header->page_size > PAGE_MAX_SIZE) {
+                print_error("Table file wrong page size for [%s]", load_path);
+                SOFT_FREE(header);
+                NIFAT32_close_content(ci);
+            }
             else {
                 // Read columns from file.
                 table_t* table = (table_t*)malloc_s(sizeof(table_t));
@@ -126,7 +186,8 @@ table_t* TBM_load_table(char* name) {
                 if (!table || !columns) {
                     SOFT_FREE(header);
                     SOFT_FREE(table);
-                    ARRAY_SOFT_FREE(columns, header->column_count);
+                    SOFT_FREE(columns);
+                    NIFAT32_close_content(ci);
                 } 
                 else {
                     str_memset(table, 0, sizeof(table_t));
@@ -141,16 +202,23 @@ table_t* TBM_load_table(char* name) {
                         str_memset(columns[i], 0, sizeof(table_column_t));
                         encoded_t encoded_column[sizeof(table_column_t)] = { 0 };
                         NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_column, sizeof(table_column_t) * sizeof(encoded_t));
-                        unpack_memory((encoded_t*)encoded_header, (byte_t*)columns[i], sizeof(table_column_t));
+                        unpack_memory((encoded_t*)encoded_column, (byte_t*)columns[i], sizeof(table_column_t));
                         offset += sizeof(table_column_t) * sizeof(encoded_t);
                     }
 
-                    for (int i = 0; i < header->column_count; i++) {
-                        table->row_size += columns[i]->size;
+                    for (int i = 0; i < header->column_count && !table_load_break; i++) {
+                        table->row_size  += GET_COLUMN_STORED_SIZE(columns[i]);
+                        table->text_size += columns[i]->size;
                     }
 
                     // Read directory names from file, that linked to this directory.
-                    for (int i = 0; i < header->dir_count; i++) {
+                    table->header = header;
+                    if (!table_load_break && TBM_reserve_dirs(table, header->dir_count) < 0) {
+                        table_load_break = 1;
+                        header->dir_count = 0;
+                    }
+
+                    for (unsigned int i = 0; i < header->dir_count; i++) {
                         encoded_t encoded_directory_name[DIRECTORY_NAME_SIZE] = { 0 };
                         NIFAT32_read_content2buffer(ci, offset, (buffer_t)encoded_directory_name, DIRECTORY_NAME_SIZE * sizeof(encoded_t));
                         unpack_memory((encoded_t*)encoded_directory_name, (byte_t*)table->dir_names[i], DIRECTORY_NAME_SIZE);
@@ -162,33 +230,57 @@ table_t* TBM_load_table(char* name) {
                     table->columns = columns;
                     table->lock = NULL_LOCK;
                     table->header = header;
-                    CHC_add_entry(
-                        table, table->header->name, TABLE_BASE_PATH, TABLE_CACHE, 
-                        (void*)TBM_free_table, (void*)TBM_save_table
-                    );
-
                     loaded_table = table;
+
+                    // Table added to GCT only after successful load. Otherwise GCT will keep freed table.
+                    if (!table_load_break) {
+                        TBM_compile_calcs(table);
+                        CHC_add_entry(
+                            table, table->header->name, TABLE_BASE_PATH, TABLE_CACHE, 
+                            (void*)TBM_free_table, (void*)TBM_save_table
+                        );
+                    }
                 }
             }
         }
     }
 
     if (table_load_break) {
-        SOFT_FREE(loaded_table->header);
-        ARRAY_SOFT_FREE(loaded_table->columns, loaded_table->header->column_count);
-        SOFT_FREE(loaded_table);
+        TBM_free_table(loaded_table);
         return NULL;
     }
 
     return loaded_table;
 }
 
+int TBM_reserve_dirs(table_t* table, unsigned int count) {
+    if (count > (unsigned int)TABLE_MAX_DIRECTORIES((int)table->header->page_size)) {
+        print_error("Table [%.*s] reach size limit [%u directories]", TABLE_NAME_SIZE, table->header->name, count);
+        return -2;
+    }
+
+    if (count <= table->dir_capacity) return 1;
+    unsigned int capacity = ((count + TABLE_DIRECTORIES_STEP - 1) / TABLE_DIRECTORIES_STEP) * TABLE_DIRECTORIES_STEP;
+    char (*dir_names)[DIRECTORY_NAME_SIZE] = (char (*)[DIRECTORY_NAME_SIZE])malloc_s(capacity * DIRECTORY_NAME_SIZE);
+    if (!dir_names) return -1;
+
+    str_memset(dir_names, 0, capacity * DIRECTORY_NAME_SIZE);
+    if (table->dir_names) {
+        str_memcpy(dir_names, table->dir_names, table->header->dir_count * DIRECTORY_NAME_SIZE);
+        free_s(table->dir_names);
+    }
+
+    table->dir_names    = dir_names;
+    table->dir_capacity = capacity;
+    return 1;
+}
+
 int TBM_delete_table(table_t* table, int full) {
 #ifndef NO_DELETE_COMMAND
     if (!table) return -1;
     if (THR_require_write(&table->lock, get_thread_num())) {
         if (full) {
-            for (int i = 0; i < table->header->dir_count; i++) {
+            for (unsigned int i = 0; i < table->header->dir_count; i++) {
                 directory_t* directory = DRM_load_directory(table->dir_names[i]);
                 if (!directory) continue;
                 DRM_delete_directory(directory, full);
@@ -215,6 +307,8 @@ int TBM_flush_table(table_t* table) {
 int TBM_free_table(table_t* table) {
     if (!table) return -1;
     ARRAY_SOFT_FREE(table->columns, table->header->column_count);
+    SOFT_FREE(table->programs);
+    SOFT_FREE(table->dir_names);
     SOFT_FREE(table->header);
     SOFT_FREE(table);
     return 1;
@@ -225,15 +319,21 @@ unsigned int TBM_get_checksum(table_t* table) {
     unsigned int prev_checksum = table->header->checksum;
     table->header->checksum = 0;
 
+    int algorithm = table->header->checksum_type;
     unsigned int _checksum = 0;
-    if (table->header) _checksum = murmur3_x86_32((const unsigned char*)table->header, sizeof(table_header_t), 0);
+    if (table->header) _checksum = checksum_memory(algorithm, (const unsigned char*)table->header, sizeof(table_header_t), 0);
     if (table->columns) {
         for (unsigned short i = 0; i < table->header->column_count; i++) {
-            if (table->columns[i]) _checksum = murmur3_x86_32((const unsigned char*)table->columns[i], sizeof(table_column_t), 0);
+            if (table->columns[i]) _checksum = checksum_memory(algorithm, (const unsigned char*)table->columns[i], sizeof(table_column_t), _checksum);
         }
     }
 
     table->header->checksum = prev_checksum;
-    _checksum = murmur3_x86_32((const unsigned char*)table->dir_names, sizeof(table->dir_names), 0);
+    if (table->dir_names) {
+        _checksum = checksum_memory(
+            algorithm, (const unsigned char*)table->dir_names, table->header->dir_count * DIRECTORY_NAME_SIZE, _checksum
+        );
+    }
+
     return _checksum;
 }
@@ -1,19 +1,20 @@
 #include <tabman.h>
 
 static int _link_dir2table(table_t* __restrict table, directory_t* __restrict directory) {
+    if (TBM_reserve_dirs(table, table->header->dir_count + 1) < 0) return -1;
     str_strncpy(table->dir_names[table->header->dir_count++], directory->header->name, DIRECTORY_NAME_SIZE);
     return 1;
 }
 
 static int _unlink_dir_from_table(table_t* table, const char* dir_name) {
-    for (int i = 0; i < table->header->dir_count; i++) {
+    for (unsigned int i = 0; i < table->header->dir_count; i++) {
         if (str_strncmp(table->dir_names[i], dir_name, DIRECTORY_NAME_SIZE) == 0) {
-            for (int j = i; j < table->header->dir_count - 1; j++) {
-                str_memset(table->dir_names[j], table->dir_names[j + 1], DIRECTORY_NAME_SIZE);
+            for (unsigned int j = i; j < table->header->dir_count - 1; j++) {
+                str_memcpy(table->dir_names[j], table->dir_names[j + 1], DIRECTORY_NAME_SIZE);
             }
 
             table->header->dir_count--;
-            table->append_offset = MAX(table->append_offset - 1, 0);
+            if (table->append_offset > 0) table->append_offset--;
             return 1;
         }
     }
@@ -21,6 +22,18 @@ static int _unlink_dir_from_table(table_t* table, const char* dir_name) {
     return 0;
 }
 
+static int _delete_directory(table_t* __restrict table, directory_t* __restrict directory) {
+    char dir_path[DEFAULT_PATH_SIZE] = { 0 };
+    get_load_path(directory->header->name, DIRECTORY_NAME_SIZE, dir_path, DIRECTORY_BASE_PATH, DIRECTORY_EXTENSION);
+    int del_res = rmdir(directory->header->name);
+    _unlink_dir_from_table(table, directory->header->name);
+    if (CHC_flush_entry(directory, DIRECTORY_CACHE) == -2) DRM_flush_directory(directory);
+    ci_t ci = NIFAT32_open_content(NO_RCI, dir_path, DF_MODE);
+    del_res = ci >= 0 ? NIFAT32_delete_content(ci) : 0;
+    print_debug("Directory [%s] was deleted with result [%i]", dir_path, del_res);
+    return 1;
+}
+
 #pragma region [CRUD]
 
 int TBM_append_content(table_t* __restrict table, unsigned char* __restrict data, size_t data_size) {
@@ -28,24 +41,33 @@ int TBM_append_content(table_t* __restrict table, unsigned char* __restrict data
     int size4append = (int)data_size;
 
     // Iterate existed directories. Maybe we can store data here?
-    for (int i = table->append_offset; i < table->header->dir_count; i++) { // O(n)
+    for (unsigned int i = table->append_offset; i < table->header->dir_count; i++) { // O(n)
         // Load directory to memory
         directory_t* directory = DRM_load_directory(table->dir_names[i]);
         if (!directory) continue;
-        if (THR_release_write(&directory->lock, get_thread_num())) {
+        if (THR_require_write(&directory->lock, get_thread_num())) {
             int result = DRM_append_content(directory, data_pointer, size4append);
+            table->last_append = i * DIRECTORY_OFFSET(table->header->page_size) + directory->last_append;
             THR_release_write(&directory->lock, get_thread_num());
             DRM_flush_directory(directory);
             if (result < 0) return result - 10;
             else if (result == 0 || result == 1 || result == 2) {
                 return 1;
             }
+
+            // Directory full. Table can have a lot of directories, that's why we skip it in next appends.
+            // Note: Delete moves append offset back.
+            if (table->append_offset == i) table->append_offset = i + 1;
+            continue;
         }
 
         DRM_flush_directory(directory);
     }
 
-    if (table->header->dir_count + 1 > DIRECTORIES_PER_TABLE) return -1;
+    // Reserve place in directory map before directory creation.
+    int reserve_result = TBM_reserve_dirs(table, table->header->dir_count + 1);
+    if (reserve_result == -2) return -6;
+    else if (reserve_result < 0) return -1;
 
     // Create new empty directory and append data.
     // If we overfill directory by data, save size of data,
@@ -53,6 +75,12 @@ int TBM_append_content(table_t* __restrict table, unsigned char* __restrict data
     directory_t* new_directory = DRM_create_empty_directory();
     if (new_directory == NULL) return -1;
 
+    new_directory->header->page_flags = table->header->page_flags;
+    new_directory->header->slot_size  = table->row_size;
+    new_directory->header->page_size  = table->header->page_size;
+    TBM_set_zones(table, new_directory);
+    TBM_set_blooms(table, new_directory);
+
     table->append_offset = table->header->dir_count;
     int append_result = DRM_append_content(new_directory, data_pointer, size4append);
     if (append_result < 0) {
@@ -60,6 +88,7 @@ int TBM_append_content(table_t* __restrict table, unsigned char* __restrict data
         return append_result - 10;
     }
 
+    table->last_append = table->append_offset * DIRECTORY_OFFSET(table->header->page_size) + new_directory->last_append;
     _link_dir2table(table, new_directory);
 
     // Save directory to DDT
@@ -72,22 +101,89 @@ int TBM_append_content(table_t* __restrict table, unsigned char* __restrict data
     return 1;
 }
 
+int TBM_append_rows(table_t* __restrict table, unsigned char* __restrict data, int count, int* offsets) {
+    int appended = 0;
+    int directory_offset = DIRECTORY_OFFSET(table->header->page_size);
+    for (unsigned int i = table->append_offset; i < table->header->dir_count && appended < count; i++) {
+        directory_t* directory = DRM_load_directory(table->dir_names[i]);
+        if (!directory) continue;
+        if (THR_require_write(&directory->lock, get_thread_num())) {
+            int result = DRM_append_rows(
+                directory, data + appended * table->row_size, table->row_size, count - appended, offsets ? offsets + appended : NULL
+            );
+
+            if (result > 0) table->last_append = i * directory_offset + directory->last_append;
+            THR_release_write(&directory->lock, get_thread_num());
+            DRM_flush_directory(directory);
+            if (result < 0) return appended ? appended : result - 10;
+
+            if (offsets) for (int j = appended; j < appended + result; j++) offsets[j] += i * directory_offset;
+            appended += result;
+            if (appended >= count) break;
+
+            // Directory full. Check TBM_append_content.
+            if (table->append_offset == i) table->append_offset = i + 1;
+            continue;
+        }
+
+        DRM_flush_directory(directory);
+    }
+
+    while (appended < count) {
+        int reserve_result = TBM_reserve_dirs(table, table->header->dir_count + 1);
+        if (reserve_result < 0) return appended ? appended : (reserve_result == -2 ? -6 : -1);
+        directory_t* new_directory = DRM_create_empty_directory();
+        if (new_directory == NULL) return appended ? appended : -1;
+
+        new_directory->header->page_flags = table->header->page_flags;
+        new_directory->header->slot_size  = table->row_size;
+        new_directory->header->page_size  = table->header->page_size;
+        TBM_set_zones(table, new_directory);
+        TBM_set_blooms(table, new_directory);
+
+        int result = DRM_append_rows(
+            new_directory, data + appended * table->row_size, table->row_size, count - appended, offsets ? offsets + appended : NULL
+        );
+
+        if (result <= 0) {
+            DRM_free_directory(new_directory);
+            return appended ? appended : (result < 0 ? result - 10 : -1);
+        }
+
+        table->append_offset = table->header->dir_count;
+        table->last_append = table->append_offset * directory_offset + new_directory->last_append;
+        if (offsets) for (int j = appended; j < appended + result; j++) offsets[j] += table->append_offset * directory_offset;
+        appended += result;
+
+        _link_dir2table(table, new_directory);
+        CHC_add_entry(
+            new_directory, new_directory->header->name, DIRECTORY_BASE_PATH, DIRECTORY_CACHE, 
+            (void*)DRM_free_directory, (void*)DRM_save_directory
+        );
+
+        DRM_flush_directory(new_directory);
+    }
+
+    return appended;
+}
+
 int TBM_get_content(table_t* __restrict table, int offset,  unsigned char* __restrict buffer, size_t size) {
     int status = 0;
     int content2get_size = (int)size;
     unsigned char* output_content_pointer = buffer;
 
     // Iterate from all directories in table
-    int start_directory  = offset / (DIRECTORY_OFFSET);
-    int directory_offset = offset % (DIRECTORY_OFFSET);
-    for (int i = start_directory; i < table->header->dir_count && content2get_size > 0; i++) {
+    int page_size        = (int)table->header->page_size;
+    int start_directory  = offset / DIRECTORY_OFFSET(page_size);
+    int directory_offset = offset % DIRECTORY_OFFSET(page_size);
+    for (int i = start_directory; i < (int)table->header->dir_count && content2get_size > 0; i++) {
         // Load directory to memory
         directory_t* directory = DRM_load_directory(table->dir_names[i]);
         if (!directory) continue;
         if (THR_require_read(&directory->lock)) {
             // Get data from directory
             // After getting data, copy it to allocated output
-            int current_size = MIN(directory->header->page_count * PAGE_CONTENT_SIZE, content2get_size);
+            int current_size = MIN(directory->header->page_count * page_size, content2get_size);
             if (DRM_get_content(directory, directory_offset, output_content_pointer, current_size)) {
                 // Set offset to 0, because we go to next directory
                 // Update size of getcontent
@@ -98,7 +194,7 @@ int TBM_get_content(table_t* __restrict table, int offset,  unsigned char* __res
                 status = 1;
             }
             else {
-                directory_offset -= directory->header->page_count * PAGE_CONTENT_SIZE;
+                directory_offset -= directory->header->page_count * page_size;
             }
 
             THR_release_read(&directory->lock);
@@ -114,31 +210,41 @@ int TBM_insert_content(table_t* __restrict table, int offset, unsigned char* __r
 #ifndef NO_UPDATE_COMMAND
     unsigned char* data_pointer = data;
     int size4insert = (int)data_size;
+    int written     = 0;
 
-    int current_index = offset / (DIRECTORY_OFFSET);
-    int page_offset = offset % (DIRECTORY_OFFSET);
-    for (int i = current_index; i < table->header->dir_count && size4insert > 0; i++) {
+    int page_size     = (int)table->header->page_size;
+    int current_index = offset / DIRECTORY_OFFSET(page_size);
+    int page_offset   = offset % DIRECTORY_OFFSET(page_size);
+    for (int i = current_index; i < (int)table->header->dir_count && size4insert > 0; i++) {
         // Load directory to memory
         directory_t* directory = DRM_load_directory(table->dir_names[i]);
         if (!directory) return -1;
-        if (THR_release_write(&directory->lock, get_thread_num())) {
-            int result = DRM_insert_content(directory, page_offset, data_pointer, size4insert);
-            THR_release_write(&directory->lock, get_thread_num());
 
-            if (result == -1) return -1;
-            else if (result == 1 || result == 2) size4insert = 0;
-            else {
-                data_pointer += size4insert - result;
-                size4insert = result;
-            }
+        // Insert don't create pages, that's why content outside of existed pages can't be written.
+        int directory_size = directory->header->page_count * page_size;
+        if (page_offset >= directory_size) {
+            DRM_flush_directory(directory);
+            break;
+        }
 
-            page_offset = 0;
+        int result = -1;
+        if (THR_require_write(&directory->lock, get_thread_num())) {
+            result = DRM_insert_content(directory, page_offset, data_pointer, size4insert);
+            THR_release_write(&directory->lock, get_thread_num());
         }
 
         DRM_flush_directory(directory);
+        if (result < 0) return -1;
+
+        int current_size = MIN(size4insert, directory_size - page_offset);
+        data_pointer += current_size;
+        size4insert  -= current_size;
+        written      += current_size;
+        page_offset = 0;
     }
 
-    return 1;
+    if (!written) return -3;
+    return size4insert > 0 ? 2 : 1;
 #endif
     return -2;
 }
@@ -147,10 +253,10 @@ int TBM_delete_content(table_t* table, int offset, size_t size) {
 #ifndef NO_DELETE_COMMAND
     int size4delete = (int)size;
 
-    int current_index = offset / (DIRECTORY_OFFSET);
-    int page_offset   = offset % (DIRECTORY_OFFSET);
+    int current_index = offset / DIRECTORY_OFFSET((int)table->header->page_size);
+    int page_offset   = offset % DIRECTORY_OFFSET((int)table->header->page_size);
     int deleted_data  = 0;
-    for (int i = current_index; i < table->header->dir_count && size4delete > 0; i++) {
+    for (int i = current_index; i < (int)table->header->dir_count && size4delete > 0; i++) {
         // Load directory to memory
         directory_t* directory = DRM_load_directory(table->dir_names[i]);
         if (!directory) return -1;
@@ -181,21 +287,16 @@ int TBM_cleanup_dirs(table_t* table) {
     char** temp_names = copy_array2array((char**)table->dir_names, DIRECTORY_NAME_SIZE, temp_count, DIRECTORY_NAME_SIZE);
     if (!temp_names) return -1;
 
-    #pragma omp parallel for schedule(dynamic, 4)
+    // Directories loaded and deleted through GCT, that isn't thread safe, that's why cleanup is serial.
+    int changed = 0;
     for (int i = 0; i < temp_count; i++) {
-        char dir_path[DEFAULT_PATH_SIZE] = { 0 };
-        get_load_path(temp_names[i], DIRECTORY_NAME_SIZE, dir_path, DIRECTORY_BASE_PATH, DIRECTORY_EXTENSION);
-
         directory_t* directory = DRM_load_directory(temp_names[i]);
         if (!directory) continue;
         if (THR_require_write(&directory->lock, get_thread_num())) {
-            DRM_cleanup_pages(directory);
+            int result = DRM_cleanup_pages(directory);
+            if (result > 0) changed += result;
             if (!directory->header->page_count) {
-                int del_res = rmdir(directory->header->name);
-                _unlink_dir_from_table(table, directory->header->name);
-                if (CHC_flush_entry(directory, DIRECTORY_CACHE) == -2) DRM_flush_directory(directory);
-                del_res = remove(dir_path);
-                print_debug("Directory [%s] was deleted with result [%i]", temp_names[i], del_res);
+                _delete_directory(table, directory);
                 continue;
             }
             else {
@@ -207,138 +308,376 @@ int TBM_cleanup_dirs(table_t* table) {
     }
 
     ARRAY_SOFT_FREE(temp_names, temp_count);
-    return 1;
+    return changed;
+#endif
+    return -2;
+}
+
+int TBM_compact_table(table_t* table, int max_pages) {
+#ifndef NO_DELETE_COMMAND
+    int processed = 0;
+
+    // Merge sparse pages inside directories.
+    for (int i = 0; i < (int)table->header->dir_count && processed < max_pages; i++) {
+        directory_t* directory = DRM_load_directory(table->dir_names[i]);
+        if (!directory) continue;
+        if (THR_require_write(&directory->lock, get_thread_num())) {
+            int result = DRM_compact_pages(directory, directory, table->row_size, max_pages - processed);
+            if (result > 0) processed += result;
+            THR_release_write(&directory->lock, get_thread_num());
+        }
+
+        DRM_flush_directory(directory);
+    }
+
+    // Move rows from last directory to free rows in first directories.
+    int dst_index = 0;
+    while (processed < max_pages && dst_index < (int)table->header->dir_count - 1) {
+        directory_t* dst = DRM_load_directory(table->dir_names[dst_index]);
+        if (!dst) break;
+
+        directory_t* src = DRM_load_directory(table->dir_names[table->header->dir_count - 1]);
+        if (!src) {
+            DRM_flush_directory(dst);
+            break;
+        }
+
+        int result = -1;
+        if (THR_require_write(&dst->lock, get_thread_num())) {
+            if (THR_require_write(&src->lock, get_thread_num())) {
+                result = DRM_compact_pages(dst, src, table->row_size, max_pages - processed);
+                THR_release_write(&src->lock, get_thread_num());
+            }
+
+            THR_release_write(&dst->lock, get_thread_num());
+        }
+
+        DRM_flush_directory(dst);
+        if (result < 0) {
+            DRM_flush_directory(src);
+            break;
+        }
+
+        processed += result;
+        if (!src->header->page_count) _delete_directory(table, src);
+        else {
+            // Source directory not empty, that's why destination directory is full.
+            DRM_flush_directory(src);
+            dst_index++;
+        }
+    }
+
+    table->append_offset = 0;
+    return processed;
 #endif
     return -2;
 }
 
 int TBM_find_content(table_t* __restrict table, int offset, unsigned char* __restrict data, size_t data_size) {
-    unsigned char* data_pointer = data;
-    size_t temp_data_size = data_size;
     int target_global_index = -1;
+    int page_size        = (int)table->header->page_size;
+    int start_directory  = offset / DIRECTORY_OFFSET(page_size);
+    int directory_offset = offset % DIRECTORY_OFFSET(page_size);
+
+    // Window for entries, that cross directory boundary: previous directory tail and next directory head.
+    int tail_size   = 0;
+    int tail_offset = 0;
+    unsigned char* window = NULL;
+    if (data_size > 1) {
+        window = (unsigned char*)malloc_s(2 * (data_size - 1));
+        if (!window) return -2;
+    }
 
-    int start_directory  = offset / (DIRECTORY_OFFSET);
-    int directory_offset = offset % (DIRECTORY_OFFSET);
-    for (int i = start_directory; i < table->header->dir_count && temp_data_size > 0; i++) {
-        // We load current page to memory
+    for (int i = start_directory; i < (int)table->header->dir_count && target_global_index == -1; i++) {
         directory_t* directory = DRM_load_directory(table->dir_names[i]);
-        if (!directory) return -2;
-        // We search part of data in this directory, save index and unload directory.
-        int current_size = MIN((directory->header->page_count * PAGE_CONTENT_SIZE) - directory_offset, (int)temp_data_size);
+        if (!directory) {
+            target_global_index = -2;
+            break;
+        }
+
+        int directory_size = directory->header->page_count * page_size;
         if (THR_require_read(&directory->lock)) {
-            int result = DRM_find_content(directory, directory_offset, data_pointer, current_size);
-            THR_release_read(&directory->lock);
+            if (tail_size > 0) {
+                int head_size = MIN((int)data_size - 1, directory_size);
+                if (head_size > 0 && DRM_get_content(directory, 0, window + tail_size, head_size)) {
+                    int result = str_memfind(window, tail_size + head_size, data, data_size);
+                    if (result >= 0) target_global_index = tail_offset + result;
+                }
+            }
 
-            // If TGI is -1, we know that we start seacrhing from start.
-            // Save current TGI of find part of data.
-            if (target_global_index == -1) target_global_index = result + i * DIRECTORY_OFFSET;
-            if (result == -1) {
-                // We don`t find any entry of data part.
-                // This indicates, that we don`t find any data.
-                // Restore size4search and datapointer, we go to start
-                temp_data_size = data_size;
-                data_pointer = data;
-                target_global_index = -1;
-            } 
-            else {
-                // Move pointer to next position
-                temp_data_size -= current_size;
-                data_pointer += current_size;
+            if (target_global_index == -1) {
+                int result = DRM_find_content(directory, directory_offset, data, data_size);
+                if (result >= 0) target_global_index = result + i * DIRECTORY_OFFSET(page_size);
+                else target_global_index = result;
+            }
+
+            // Save directory tail for next directory.
+            tail_size = 0;
+            if (target_global_index == -1 && window) {
+                int tail_start = MAX(directory_offset, directory_size - ((int)data_size - 1));
+                if (tail_start < directory_size && DRM_get_content(directory, tail_start, window, directory_size - tail_start)) {
+                    tail_size   = directory_size - tail_start;
+                    tail_offset = tail_start + i * DIRECTORY_OFFSET(page_size);
+                }
             }
 
-            directory_offset = 0;
+            THR_release_read(&directory->lock);
         }
-        
+
+        directory_offset = 0;
         DRM_flush_directory(directory);
     }
 
+    SOFT_FREE(window);
     return target_global_index;
 }
 
+/*
+Column place in source and destination text rows. Built once before migration.
+*/
+typedef struct {
+    int src_offset;
+    int dst_offset;
+    int size;
+} migrate_column_t;
+
+/*
+Convert rows of source page to destination rows. Deleted rows and free space skipped.
+Columns copied in text form, because binary column can be text column in other table.
+
+Return count of converted rows.
+*/
+static int _migrate_page(
+    table_t* __restrict src, table_t* __restrict dst, migrate_column_t* __restrict map, int map_size,
+    unsigned char* __restrict content, unsigned char* __restrict texts, unsigned char* __restrict rows
+) {
+    unsigned char* src_text = texts;
+    unsigned char* dst_text = texts + src->text_size;
+
+    int count = 0;
+    int rows_per_page = (int)src->header->page_size / src->row_size;
+    for (int i = 0; i < rows_per_page; i++) {
+        unsigned char* row = content + i * src->row_size;
+        if (*row == PAGE_EMPTY) continue;
+
+        TBM_decode_row(src, row, src_text);
+        str_memset(dst_text, '0', dst->text_size);
+        for (int j = 0; j < map_size; j++) str_memcpy(dst_text + map[j].dst_offset, src_text + map[j].src_offset, map[j].size);
+        TBM_encode_row(dst, dst_text, rows + count++ * dst->row_size);
+    }
+
+    return count;
+}
+
 int TBM_migrate_table(table_t* __restrict src, table_t* __restrict dst, char* __restrict querry[], size_t querry_size) {
 #ifndef NO_MIGRATE_COMMAND
-    if (THR_require_read(&src->lock) && THR_require_write(&dst->lock, get_thread_num())) {
-        int offset = 0;
-        
-        unsigned char* data = (unsigned char*)" ";
-        while (*data) {
-            SOFT_FREE(data);
-            data = (unsigned char*)malloc_s(src->row_size);
-            if (!data) return -2;
+    migrate_column_t* map = (migrate_column_t*)malloc_s((querry_size / 2 + 1) * sizeof(migrate_column_t));
+    if (!map) return -2;
+
+    int map_size = 0;
+    for (size_t i = 0; i + 1 < querry_size; i += 2) {
+        table_columns_info_t fquerry;
+        table_columns_info_t squerry;
+        TBM_get_column_info(dst, querry[i + 1], &fquerry);
+        TBM_get_column_info(src, querry[i], &squerry);
+        if (fquerry.index < 0 || squerry.index < 0) continue;
+
+        map[map_size].src_offset = squerry.text_offset;
+        map[map_size].dst_offset = fquerry.text_offset;
+        map[map_size++].size     = MIN(fquerry.text_size, squerry.text_size);
+    }
+
+    int status = -1;
+    if (!THR_require_read(&src->lock)) {
+        free_s(map);
+        return -1;
+    }
 
-            TBM_get_content(src, offset, data, src->row_size);
-            unsigned char* new_row = (unsigned char*)malloc_s(dst->row_size);
-            if (!new_row || !data) {
-                SOFT_FREE(new_row);
-                SOFT_FREE(data);
+    if (THR_require_write(&dst->lock, get_thread_num())) {
+        status = 1;
+        int page_size = (int)src->header->page_size;
+        int rows_per_page = page_size / src->row_size;
+
+        // Pages loaded from directory on one thread (Page loading works with GCT), and converted in parallel.
+        // Buffers hold one directory, that's why memory usage don't depend on table size.
+        unsigned char* contents = (unsigned char*)malloc_s(PAGES_PER_DIRECTORY * page_size);
+        unsigned char* rows     = (unsigned char*)malloc_s(PAGES_PER_DIRECTORY * rows_per_page * dst->row_size);
+        int* counts = (int*)malloc_s(PAGES_PER_DIRECTORY * sizeof(int));
+        if (!contents || !rows || !counts) status = -2;
+
+        for (unsigned int i = 0; i < src->header->dir_count && status == 1; i++) {
+            directory_t* directory = DRM_load_directory(src->dir_names[i]);
+            if (!directory) continue;
+            if (THR_require_read(&directory->lock)) {
+                int page_count = directory->header->page_count;
+                for (int page = 0; page < page_count; page++) {
+                    unsigned char* content = contents + page * page_size;
+                    str_memset(content, PAGE_EMPTY, page_size);
+                    DRM_get_content(directory, page * page_size, content, page_size);
+                }
 
-                THR_release_read(&src->lock);
-                THR_release_write(&dst->lock, get_thread_num());
+                THR_release_read(&directory->lock);
 
-                return -2;
-            }
+                #pragma omp parallel
+                {
+                    unsigned char* texts = (unsigned char*)malloc_s(src->text_size + dst->text_size);
 
-            str_memset(new_row, '0', dst->row_size);
-            for (size_t i = 0; i < querry_size; i += 2) {
-                table_columns_info_t fquerry;
-                table_columns_info_t squerry;
-                TBM_get_column_info(dst, querry[i + 1], &fquerry);
-                TBM_get_column_info(src, querry[i], &squerry);
-                str_memset(new_row + fquerry.offset, data + squerry.offset, squerry.size);
-            }
+                    #pragma omp for schedule(static, 1)
+                    for (int page = 0; page < page_count; page++) {
+                        counts[page] = -1;
+                        if (texts) {
+                            counts[page] = _migrate_page(
+                                src, dst, map, map_size, contents + page * page_size, texts, rows + page * rows_per_page * dst->row_size
+                            );
+                        }
+                    }
 
-            TBM_append_content(dst, new_row, dst->row_size);
+                    SOFT_FREE(texts);
+                }
 
-            SOFT_FREE(new_row);
-            offset += src->row_size;
+                // Rows appended to destination in page order.
+                for (int page = 0; page < page_count && status == 1; page++) {
+                    if (counts[page] < 0) status = -2;
+                    else if (counts[page] > 0) {
+                        int appended = TBM_append_rows(dst, rows + page * rows_per_page * dst->row_size, counts[page], NULL);
+                        if (appended > 0) dst->header->row_count += appended;
+                        if (appended != counts[page]) status = -3;
+                    }
+                }
+            }
+
+            DRM_flush_directory(directory);
         }
 
-        SOFT_FREE(data);
-        THR_release_read(&src->lock);
+        SOFT_FREE(contents);
+        SOFT_FREE(rows);
+        SOFT_FREE(counts);
         THR_release_write(&dst->lock, get_thread_num());
-        return 1;
     }
-    else return -1;
+
+    THR_release_read(&src->lock);
+    free_s(map);
+    return status;
 #endif
     return 1;
 }
 
+int TBM_has_modules(table_t* table, unsigned char type) {
+    for (int i = 0; i < table->header->column_count; i++) {
+        if (
+            GET_COLUMN_DATA_TYPE(table->columns[i]->type) == COLUMN_TYPE_MODULE &&
+            (table->columns[i]->module_params == type || table->columns[i]->module_params == COLUMN_MODULE_BOTH)
+        ) return 1;
+    }
+
+    return 0;
+}
+
 int TBM_invoke_modules(table_t* __restrict table, unsigned char* __restrict data, unsigned char type) {
+    return TBM_invoke_modules_rows(table, data, 1, type, NULL);
+}
+
+/*
+Build module querry for row. Column names in querry replaced by column values.
+
+Return NULL if something goes wrong.
+Return allocated querry.
+*/
+static char* _build_module_querry(table_t* __restrict table, table_column_t* __restrict module, unsigned char* __restrict data) {
+    char* output_querry = (char*)malloc_s(COLUMN_MODULE_SIZE + 1);
+    if (!output_querry) return NULL;
+    str_strncpy(output_querry, module->module_querry, COLUMN_MODULE_SIZE);
+    output_querry[COLUMN_MODULE_SIZE] = 0;
+
+    int content_offset = 0;
+    for (int j = 0; j < table->header->column_count; j++) {
+        unsigned char* content_pointer = data + content_offset;
+        char* content_part = (char*)malloc_s(table->columns[j]->size + 1);
+        if (!content_part) {
+            free_s(output_querry);
+            return NULL;
+        }
+
+        str_strncpy(content_part, (char*)content_pointer, table->columns[j]->size);
+        content_part[table->columns[j]->size] = 0;
+        content_offset += table->columns[j]->size;
+
+        char* next_output_querry = strrep(output_querry, table->columns[j]->name, content_part);
+        free_s(content_part);
+        if (!next_output_querry) continue;
+        free_s(output_querry);
+
+        output_querry = (char*)next_output_querry;
+    }
+
+    return output_querry;
+}
+
+int TBM_invoke_modules_rows(
+    table_t* __restrict table, unsigned char* __restrict data, int count, unsigned char type, unsigned char* __restrict columns
+) {
+    if (count <= 0) return 1;
+    char** querries = NULL;
+    unsigned char** places = NULL;
+
     int module_offset = 0;
     for (int i = 0; i < table->header->column_count; i++) {
-        if (GET_COLUMN_DATA_TYPE(table->columns[i]->type) == COLUMN_TYPE_MODULE) {
-            if (table->columns[i]->module_params == type || table->columns[i]->module_params == COLUMN_MODULE_BOTH) {
-                char* formula = table->columns[i]->module_querry;
-                char* output_querry = (char*)malloc_s(COLUMN_MODULE_SIZE);
-                if (!output_querry) return -1;
-                str_strncpy(output_querry, formula, COLUMN_MODULE_SIZE);
-
-                int content_offset = 0;
-                for (int j = 0; j < table->header->column_count; j++) {
-                    unsigned char* content_pointer = data + content_offset;
-                    char* content_part = (char*)malloc_s(table->columns[j]->size + 1);
-                    if (!content_part) {
-                        free_s(output_querry);
-                        return -2;
-                    }
-
-                    str_strncpy(content_part, (char*)content_pointer, table->columns[j]->size);
-                    char* next_output_querry = strrep(output_querry, table->columns[j]->name, content_part);
+        table_column_t* column = table->columns[i];
+        if (
+            GET_COLUMN_DATA_TYPE(column->type) == COLUMN_TYPE_MODULE && 
+            (column->module_params == type || column->module_params == COLUMN_MODULE_BOTH) &&
+            (!columns || columns[i])
+        ) {
+            // Compiled calc column evaluated in place. Failed evaluation gives empty value, same with module.
+            if (table->programs && table->programs[i].count) {
+                for (int j = 0; j < count; j++) {
+                    unsigned char* place = data + j * table->text_size + module_offset;
+                    long long value = 0;
+                    int result = TBM_eval_calc(&table->programs[i], data + j * table->text_size, &value);
+
+                    char answer[32] = { 0 };
+                    int answer_size = result == 1 ? sprintf(answer, "%lld", value) : 0;
+                    str_memset(place, ' ', column->size);
+                    if (answer_size > column->size) print_warn("Calc answer trunced [%i > %i]", answer_size, column->size);
+                    str_memcpy(place + MAX(column->size - answer_size, 0), answer, MIN(answer_size, column->size));
+                }
 
-                    free_s(content_part);
-                    if (!next_output_querry) continue;
-                    free_s(output_querry);
+                module_offset += column->size;
+                continue;
+            }
 
-                    output_querry = (char*)next_output_querry;
-                    content_offset += table->columns[j]->size;
+            if (!querries) {
+                querries = (char**)malloc_s(count * sizeof(char*));
+                places = (unsigned char**)malloc_s(count * sizeof(unsigned char*));
+                if (!querries || !places) {
+                    SOFT_FREE(querries);
+                    SOFT_FREE(places);
+                    return -1;
                 }
+            }
 
-                MDL_launch_module(table->columns[i]->module_name, output_querry, data + module_offset, table->columns[i]->size);
+            // Querries of all rows built before launch, same with per row invoke
+            int built = 0;
+            for (; built < count; built++) {
+                unsigned char* row = data + built * table->text_size;
+                querries[built] = _build_module_querry(table, column, row);
+                places[built] = row + module_offset;
+                if (!querries[built]) break;
+            }
+
+            if (built == count) MDL_launch_batch(column->module_name, querries, places, count, column->size);
+            for (int j = 0; j < built; j++) free_s(querries[j]);
+            if (built != count) {
+                free_s(querries);
+                free_s(places);
+                return -2;
             }
         }
 
-        module_offset += table->columns[i]->size;
+        module_offset += column->size;
     }
 
+    SOFT_FREE(querries);
+    SOFT_FREE(places);
     return 1;
 }
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include <tabman.h>
+
+/*
+Get zone type of column. Text int columns with 10 and more digits don't fit int compare,
+that's why they compared as strings.
+
+Return -1 if column can't have zone (Module column).
+Return zone type.
+*/
+static int _get_zone_type(table_column_t* column) {
+    unsigned char data_type = GET_COLUMN_DATA_TYPE(column->type);
+    if (data_type == COLUMN_TYPE_MODULE) return -1;
+    if (GET_COLUMN_BINARY(column->type)) return GET_COLUMN_STORED_SIZE(column) == sizeof(int) ? ZONE_TYPE_INT32 : ZONE_TYPE_INT64;
+    if (data_type == COLUMN_TYPE_INT && column->size < 10) return ZONE_TYPE_NUMBER;
+    return ZONE_TYPE_STRING;
+}
+
+/*
+Select zone columns of table. Int columns selected first (Ranges of ints used by "<" and ">"),
+then string columns.
+
+Return count of zone columns.
+*/
+static int _get_zone_columns(table_t* __restrict table, int* __restrict indexes, directory_zone_column_t* __restrict zones) {
+    int count = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        int offset = 0;
+        for (int i = 0; i < table->header->column_count && count < DIRECTORY_ZONE_COUNT; i++) {
+            table_column_t* column = table->columns[i];
+            int type = _get_zone_type(column);
+            if (type >= 0 && (type == ZONE_TYPE_STRING) == pass) {
+                indexes[count] = i;
+                zones[count].offset = offset;
+                zones[count].size   = GET_COLUMN_STORED_SIZE(column);
+                zones[count].type   = type;
+                count++;
+            }
+
+            offset += GET_COLUMN_STORED_SIZE(column);
+        }
+    }
+
+    return count;
+}
+
+/*
+Select Bloom columns of table (Columns with COLUMN_INDEX_BLOOM).
+
+Return count of Bloom columns.
+*/
+static int _get_bloom_columns(table_t* __restrict table, int* __restrict indexes, directory_zone_column_t* __restrict blooms) {
+    int count = 0, offset = 0;
+    for (int i = 0; i < table->header->column_count && count < DIRECTORY_BLOOM_COUNT; i++) {
+        table_column_t* column = table->columns[i];
+        int type = _get_zone_type(column);
+        if (type >= 0 && GET_COLUMN_INDEX(column->type) == COLUMN_INDEX_BLOOM) {
+            indexes[count] = i;
+            blooms[count].offset = offset;
+            blooms[count].size   = GET_COLUMN_STORED_SIZE(column);
+            blooms[count].type   = type;
+            count++;
+        }
+
+        offset += GET_COLUMN_STORED_SIZE(column);
+    }
+
+    return count;
+}
+
+int TBM_set_zones(table_t* __restrict table, directory_t* __restrict directory) {
+    int indexes[DIRECTORY_ZONE_COUNT] = { 0 };
+    directory->header->zone_count = _get_zone_columns(table, indexes, directory->header->zone_columns);
+    for (int i = 0; i < PAGES_PER_DIRECTORY; i++) {
+        for (int j = 0; j < DIRECTORY_ZONE_COUNT; j++) {
+            directory->page_zones[i][j].min = ZONE_KEY_MAX;
+            directory->page_zones[i][j].max = ZONE_KEY_MIN;
+        }
+    }
+
+    return directory->header->zone_count;
+}
+
+int TBM_make_zone_filter(table_t* __restrict table, int column, unsigned char operation, char* __restrict value, zone_filter_t* __restrict filter) {
+    if (!value) return -1;
+
+    int indexes[DIRECTORY_ZONE_COUNT] = { 0 };
+    directory_zone_column_t zones[DIRECTORY_ZONE_COUNT];
+    int count = _get_zone_columns(table, indexes, zones);
+    for (int i = 0; i < count; i++) {
+        if (indexes[i] != column) continue;
+
+        int length = str_strlen(value);
+        filter->zone      = i;
+        filter->column    = zones[i];
+        filter->operation = operation;
+        switch (zones[i].type) {
+            case ZONE_TYPE_STRING:
+                // Strings compared as numbers by "==", "<" and ">" (Check kentry).
+                if (operation != ZONE_MATCH) return -1;
+                filter->key = DRM_make_zone_key(ZONE_TYPE_STRING, (unsigned char*)value, length);
+                return 1;
+
+            case ZONE_TYPE_NUMBER:
+                // Text ints compared as int, that's why value outside of int range can't use zone.
+                filter->key = str_atoll(value, length);
+                if (operation != ZONE_MATCH && (filter->key < INT_MIN || filter->key > INT_MAX)) return -1;
+                return 1;
+
+            default:
+                filter->key = str_atoll(value, length);
+                return 1;
+        }
+    }
+
+    return -1;
+}
+
+int TBM_set_blooms(table_t* __restrict table, directory_t* __restrict directory) {
+    int indexes[DIRECTORY_BLOOM_COUNT] = { 0 };
+    directory_zone_column_t blooms[DIRECTORY_BLOOM_COUNT];
+    int count = _get_bloom_columns(table, indexes, blooms);
+    return DRM_set_blooms(directory, blooms, count, table->header->page_size / table->row_size);
+}
+
+int TBM_make_bloom_filter(
+    table_t* __restrict table, int column, unsigned char operation, unsigned char* __restrict value, int size, zone_filter_t* __restrict filter
+) {
+    if (!value) return -1;
+
+    int indexes[DIRECTORY_BLOOM_COUNT] = { 0 };
+    directory_zone_column_t blooms[DIRECTORY_BLOOM_COUNT];
+    int count = _get_bloom_columns(table, indexes, blooms);
+    for (int i = 0; i < count; i++) {
+        if (indexes[i] != column) continue;
+
+        // Strings compared as numbers by "==" (Check kentry).
+        if (operation != ZONE_MATCH && (operation != ZONE_EQUALS || blooms[i].type == ZONE_TYPE_STRING)) return -1;
+        if (blooms[i].type == ZONE_TYPE_NUMBER && operation == ZONE_EQUALS) {
+            long long number = str_atoll((char*)value, size);
+            if (number < INT_MIN || number > INT_MAX) return -1;
+        }
+
+        filter->zone      = i;
+        filter->column    = blooms[i];
+        filter->operation = ZONE_BLOOM;
+        filter->key       = DRM_make_bloom_key(blooms[i].type, value, size);
+        return 1;
+    }
+
+    return -1;
+}
+
+/*
+Check if zone range excludes filter.
+*/
+static int _is_excluded(directory_zone_t* zone, zone_filter_t* filter) {
+    if (zone->min > zone->max) return 1;
+    switch (filter->operation) {
+        case ZONE_LESS: return zone->min >= filter->key;
+        case ZONE_MORE: return zone->max <= filter->key;
+        default: return filter->key < zone->min || filter->key > zone->max;
+    }
+}
+
+/*
+Check if rows of directory page (Or whole directory, if page is -1) can't match filters.
+Directory zone should have same column with filter, otherwise filter ignored.
+Bloom filters checked only for pages.
+*/
+static int _is_page_excluded(directory_t* __restrict directory, int page, zone_filter_t* __restrict filters, int count) {
+    for (int i = 0; i < count; i++) {
+        zone_filter_t* filter = &filters[i];
+        int is_bloom = filter->operation == ZONE_BLOOM;
+        if (is_bloom && page < 0) continue;
+        if (filter->zone >= (is_bloom ? directory->header->bloom_count : directory->header->zone_count)) continue;
+
+        directory_zone_column_t* column = is_bloom ? &directory->header->bloom_columns[filter->zone] : &directory->header->zone_columns[filter->zone];
+        if (
+            column->offset != filter->column.offset || column->size != filter->column.size ||
+            column->type != filter->column.type
+        ) continue;
+
+        if (is_bloom) {
+            if (!DRM_check_bloom(directory, page, filter->zone, filter->key)) return 1;
+            continue;
+        }
+
+        directory_zone_t zone;
+        if (DRM_get_zone(directory, page, filter->zone, &zone) == 1 && _is_excluded(&zone, filter)) return 1;
+    }
+
+    return 0;
+}
+
+int TBM_skip_pages(table_t* __restrict table, int page, zone_filter_t* __restrict filters, int count) {
+    if (count <= 0 || page < 0) return 0;
+
+    int skipped = 0;
+    while (1) {
+        int directory_index = (page + skipped) / PAGES_PER_DIRECTORY;
+        int local_page = (page + skipped) % PAGES_PER_DIRECTORY;
+
+        // Page placed in next directory, if directory don't have this page (Same with TBM_get_content).
+        directory_t* directory = NULL;
+        while (directory_index < (int)table->header->dir_count) {
+            directory = DRM_load_directory(table->dir_names[directory_index]);
+            if (!directory) return skipped;
+            if (local_page < directory->header->page_count) break;
+
+            local_page -= directory->header->page_count;
+            DRM_flush_directory(directory);
+            directory = NULL;
+            directory_index++;
+        }
+
+        if (!directory) return skipped;
+
+        int skip = 0;
+        int page_count = directory->header->page_count;
+        if (THR_require_read(&directory->lock)) {
+            if (_is_page_excluded(directory, -1, filters, count)) skip = page_count - local_page;
+            else {
+                while (local_page + skip < page_count && _is_page_excluded(directory, local_page + skip, filters, count)) skip++;
+            }
+
+            THR_release_read(&directory->lock);
+        }
+
+        DRM_flush_directory(directory);
+        skipped += skip;
+        if (local_page + skip < page_count) return skipped;
+    }
+}
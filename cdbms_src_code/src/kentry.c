@@ -18,14 +18,14 @@ static int _compare_data(char* expression, char* fdata, size_t fdata_size, char*
     char* temp_fdata = (char*)malloc_s(fdata_size + 1);
     if (!temp_fdata) return 0;
 
-    str_memset(temp_fdata, fdata, fdata_size);
+    str_memcpy(temp_fdata, fdata, fdata_size);
     temp_fdata[fdata_size] = 0;
     char* mv_fdata = temp_fdata + strspn_s(temp_fdata, " ");
     
     char* temp_sdata = (char*)malloc_s(sdata_size + 1);
     if (!temp_sdata) return 0;
 
-    str_memset(temp_sdata, sdata, sdata_size);
+    str_memcpy(temp_sdata, sdata, sdata_size);
     temp_sdata[sdata_size] = 0;
     char* mv_sdata = temp_sdata + strspn_s(temp_sdata, " ");
 
@@ -46,19 +46,126 @@ static int _compare_data(char* expression, char* fdata, size_t fdata_size, char*
     return comparison;
 }
 
-static int _create_expression(table_t* table, char* commands[], int current_command, int argc, expression_t* expression) {
+/*
+Get value of hex symbol.
+
+Return -1 if symbol isn't hex.
+Return value of symbol (0 - 15).
+*/
+static int _hex_value(char symbol) {
+    if (symbol >= '0' && symbol <= '9') return symbol - '0';
+    if (symbol >= 'a' && symbol <= 'f') return symbol - 'a' + 10;
+    if (symbol >= 'A' && symbol <= 'F') return symbol - 'A' + 10;
+    return -1;
+}
+
+/*
+Decode hex string (Two symbols per byte) to buffer. Hex form used for rows with bytes,
+that can't be passed in command argument (Zero bytes).
+
+Return -1 if string has odd length or not hex symbol.
+Return count of decoded bytes.
+*/
+static int _decode_hex(char* __restrict source, unsigned char* __restrict destination) {
+    int length = str_strlen(source);
+    if (length % 2) return -1;
+    for (int i = 0; i < length; i += 2) {
+        int high = _hex_value(source[i]);
+        int low  = _hex_value(source[i + 1]);
+        if (high < 0 || low < 0) return -1;
+        destination[i / 2] = (unsigned char)((high << 4) | low);
+    }
+
+    return length / 2;
+}
+
+static int _compare_number(char* expression, long long first, long long second) {
+    if (!str_strcmp(expression, EQUALS) || !str_strcmp(expression, STR_EQUALS)) return first == second;
+    else if (!str_strcmp(expression, NEQUALS) || !str_strcmp(expression, STR_NEQUALS)) return first != second;
+    else if (!str_strcmp(expression, LESS_THAN)) return first < second;
+    else if (!str_strcmp(expression, MORE_THAN)) return first > second;
+    return 0;
+}
+
+/*
+Add column to projection map. Module column flagged for POSTLOAD invoke.
+
+Return -1 if column not found or projection is full.
+Return 1 if column added.
+*/
+static int _add_projection_column(table_t* table, char* name, projection_t* projection) {
+    table_columns_info_t col_info;
+    if (TBM_get_column_info(table, name, &col_info) != 1 || projection->count >= MAX_PROJECTION) {
+        print_warn("Column [%s] can't be projected in table [%.*s]", name, TABLE_NAME_SIZE, table->header->name);
+        return -1;
+    }
+
+    projection->offsets[projection->count] = col_info.text_offset;
+    projection->sizes[projection->count++] = col_info.text_size;
+    projection->size += col_info.text_size;
+    if (GET_COLUMN_DATA_TYPE(table->columns[col_info.index]->type) == COLUMN_TYPE_MODULE) projection->modules[col_info.index] = 1;
+    return 1;
+}
+
+/*
+Flag module columns, that used by flagged module columns. Module querry gets values of previous
+columns (Check TBM_invoke_modules_rows), that's why previous module columns from querry invoked too.
+*/
+static void _link_projection_modules(table_t* table, projection_t* projection) {
+    for (int i = table->header->column_count - 1; i >= 0; i--) {
+        if (!projection->modules[i]) continue;
+
+        table_column_t* module = table->columns[i];
+        int querry_size = 0;
+        while (querry_size < COLUMN_MODULE_SIZE && module->module_querry[querry_size]) querry_size++;
+        for (int j = 0; j < i; j++) {
+            table_column_t* column = table->columns[j];
+            if (GET_COLUMN_DATA_TYPE(column->type) != COLUMN_TYPE_MODULE) continue;
+
+            int name_size = 0;
+            while (name_size < COLUMN_NAME_SIZE && column->name[name_size]) name_size++;
+            if (name_size && str_memfind(module->module_querry, querry_size, column->name, name_size) >= 0) projection->modules[j] = 1;
+        }
+    }
+
+    for (int i = 0; i < table->header->column_count; i++) {
+        unsigned char params = table->columns[i]->module_params;
+        if (projection->modules[i] && (params == COLUMN_MODULE_POSTLOAD || params == COLUMN_MODULE_BOTH)) projection->has_modules = 1;
+    }
+}
+
+/*
+Create expression from command. Projection clause (columns ( a b )) parsed only if projection provided,
+otherwise clause skipped.
+*/
+static int _create_expression(
+    table_t* table, char* commands[], int current_command, int argc, expression_t* expression, projection_t* projection
+) {
     expression->condition_count = 0;
     expression->operator_count = 0;
     expression->limit = -1;
     expression->offset = 0;
+    expression->needs_text = 0;
+    expression->projection = NULL;
+    if (projection) str_memset(projection, 0, sizeof(projection_t));
 
     while (1) {
         char* operator = SAFE_GET_VALUE_PRE_INC(commands, argc, current_command);
         if (!operator) break;
         if (str_strcmp(operator, COLUMN) == 0) {
-            TBM_get_column_info(table, SAFE_GET_VALUE_PRE_INC(commands, argc, current_command), &expression->conditions[expression->condition_count].col_info);
-            expression->conditions[expression->condition_count].expression = SAFE_GET_VALUE_PRE_INC(commands, argc, current_command);
-            expression->conditions[expression->condition_count].value = SAFE_GET_VALUE_PRE_INC(commands, argc, current_command);
+            condition_t* condition = &expression->conditions[expression->condition_count];
+            TBM_get_column_info(table, SAFE_GET_VALUE_PRE_INC(commands, argc, current_command), &condition->col_info);
+            condition->expression = SAFE_GET_VALUE_PRE_INC(commands, argc, current_command);
+            condition->value = SAFE_GET_VALUE_PRE_INC(commands, argc, current_command);
+            condition->is_binary = 0;
+            if (condition->col_info.index >= 0) {
+                unsigned char type = table->columns[condition->col_info.index]->type;
+                condition->is_binary = GET_COLUMN_BINARY(type);
+                if (GET_COLUMN_DATA_TYPE(type) == COLUMN_TYPE_MODULE) expression->needs_text = 1;
+            }
+
+            // Value parsed once, not at every row
+            if (condition->is_binary && condition->value) condition->number = str_atoll(condition->value, str_strlen(condition->value));
             expression->condition_count++;
         } 
         else if (str_strcmp(operator, OR) == 0 || str_strcmp(operator, AND) == 0) {
@@ -70,20 +177,55 @@ static int _create_expression(table_t* table, char* commands[], int current_comm
         else if (str_strcmp(operator, LIMIT) == 0) {
             expression->limit = atoi_s(SAFE_GET_VALUE_PRE_INC_S(commands, argc, current_command));
         }
+        else if (str_strcmp(operator, COLUMNS) == 0) {
+            char* name = SAFE_GET_VALUE_PRE_INC(commands, argc, current_command);
+            if (!name || *name != OPEN_BRACKET) break;
+            while ((name = SAFE_GET_VALUE_PRE_INC(commands, argc, current_command)) && *name != CLOSE_BRACKET) {
+                if (projection) _add_projection_column(table, name, projection);
+            }
+
+            if (projection && projection->count) expression->projection = projection;
+        }
         else break;
     }  
     
+    if (expression->projection) _link_projection_modules(table, expression->projection);
     return 1;
 }
 
-static int _evaluate_expression(unsigned char* row_data, expression_t* expression) {
+/*
+Evaluate expression for row. Binary int columns compared as numbers in stored row,
+module columns compared in text row, other columns have same data in both rows.
+*/
+static int _evaluate_expression(table_t* table, unsigned char* row_data, unsigned char* text_data, expression_t* expression) {
     int results[MAX_STATEMENTS] = { 0 };
-    #pragma omp parallel for schedule(dynamic, 2)
     for (int i = 0; i < expression->condition_count; i++) {
-        results[i] = _compare_data(
-            expression->conditions[i].expression, (char*)(row_data + expression->conditions[i].col_info.offset), 
-            expression->conditions[i].col_info.size, expression->conditions[i].value, str_strlen(expression->conditions[i].value)
-        );
+        condition_t* condition = &expression->conditions[i];
+        if (condition->is_binary) {
+            long long value = 0;
+            if (condition->col_info.size == sizeof(int)) {
+                int short_value = 0;
+                str_memcpy(&short_value, row_data + condition->col_info.offset, sizeof(int));
+                value = short_value;
+            }
+            else str_memcpy(&value, row_data + condition->col_info.offset, sizeof(long long));
+            results[i] = _compare_number(condition->expression, value, condition->number);
+        }
+        else if (
+            text_data && condition->col_info.index >= 0 && 
+            GET_COLUMN_DATA_TYPE(table->columns[condition->col_info.index]->type) == COLUMN_TYPE_MODULE
+        ) {
+            results[i] = _compare_data(
+                condition->expression, (char*)(text_data + condition->col_info.text_offset), 
+                condition->col_info.text_size, condition->value, str_strlen(condition->value)
+            );
+        }
+        else {
+            results[i] = _compare_data(
+                condition->expression, (char*)(row_data + condition->col_info.offset), 
+                condition->col_info.size, condition->value, str_strlen(condition->value)
+            );
+        }
     }
 
     int match = results[0];
@@ -118,7 +260,212 @@ static int __get_logic(
     int data_start = answer->answer_size;
     answer->answer_size += data_size;
     answer->answer_body = (unsigned char*)realloc_s(answer->answer_body, answer->answer_size);
-    str_memset(answer->answer_body + data_start, data, data_size);
+    str_memcpy(answer->answer_body + data_start, data, data_size);
+    return 1;
+}
+
+/*
+Find candidate rows for expression with column index. Index used only for expressions without "or",
+that's why every matched row contains in candidate rows.
+Note: Free rows after use.
+
+Params:
+- table - Pointer to table.
+- exp - Expression.
+- rows - Pointer to rows array.
+
+Return -1 if expression can't use index.
+Return count of candidate rows.
+*/
+static int _find_indexed_rows(table_t* table, expression_t* exp, int** rows) {
+    for (int i = 0; i < exp->operator_count; i++) {
+        if (!str_strcmp(exp->operators[i], OR)) return -1;
+    }
+
+    for (int i = 0; i < exp->condition_count; i++) {
+        condition_t* condition = &exp->conditions[i];
+        if (condition->col_info.index < 0 || !condition->expression || !condition->value) continue;
+        if (GET_COLUMN_INDEX(table->columns[condition->col_info.index]->type) != COLUMN_INDEX_BTREE) continue;
+
+        int text_compare = 0;
+        int operation = INDEX_EQUALS;
+        if (!str_strcmp(condition->expression, STR_EQUALS)) text_compare = 1;
+        else if (!str_strcmp(condition->expression, LESS_THAN)) operation = INDEX_LESS;
+        else if (!str_strcmp(condition->expression, MORE_THAN)) operation = INDEX_MORE;
+        else if (str_strcmp(condition->expression, EQUALS)) continue;
+
+        index_t* index = IND_load_index(table, condition->col_info.index);
+        if (!index) continue;
+
+        // Binary int columns compare eq as numbers, that's why number key works for eq too.
+        int numeric = index->header->key_type == INDEX_KEY_INT || index->header->key_type == INDEX_KEY_LONG;
+        if (text_compare ? !(index->header->key_type == INDEX_KEY_BYTES || (numeric && index->is_binary)) : !numeric) {
+            IND_flush_index(index);
+            continue;
+        }
+
+        int count = -1;
+        unsigned char* key = (unsigned char*)malloc_s(index->header->key_size);
+        if (key) {
+            // Value larger than column can't be equals to column value.
+            if (IND_make_key(index, (unsigned char*)condition->value, str_strlen(condition->value), key) != 1) count = 0;
+            else count = IND_find_rows(index, operation, key, rows);
+            free_s(key);
+        }
+
+        IND_flush_index(index);
+        if (count >= 0) return count;
+    }
+
+    return -1;
+}
+
+/*
+Make zone filters for expression conditions. Filters used only for expressions without "or",
+that's why page can be skipped, if one of conditions can't match rows of page.
+Equals conditions on Bloom columns get Bloom filter too (Filters array should have 2 * MAX_STATEMENTS size).
+
+Return count of filters.
+*/
+static int _make_zone_filters(table_t* table, expression_t* exp, zone_filter_t* filters) {
+    for (int i = 0; i < exp->operator_count; i++) {
+        if (!str_strcmp(exp->operators[i], OR)) return 0;
+    }
+
+    int count = 0;
+    for (int i = 0; i < exp->condition_count; i++) {
+        condition_t* condition = &exp->conditions[i];
+        if (condition->col_info.index < 0 || !condition->expression || !condition->value) continue;
+
+        unsigned char operation = ZONE_EQUALS;
+        if (!str_strcmp(condition->expression, STR_EQUALS)) operation = ZONE_MATCH;
+        else if (!str_strcmp(condition->expression, LESS_THAN)) operation = ZONE_LESS;
+        else if (!str_strcmp(condition->expression, MORE_THAN)) operation = ZONE_MORE;
+        else if (str_strcmp(condition->expression, EQUALS)) continue;
+
+        if (TBM_make_zone_filter(table, condition->col_info.index, operation, condition->value, &filters[count]) == 1) count++;
+        if (operation != ZONE_MATCH && operation != ZONE_EQUALS) continue;
+
+        // Bloom key made from stored value, binary columns store int32 / int64.
+        int bloom = -1;
+        if (condition->is_binary) {
+            int short_value = (int)condition->number;
+            if (condition->col_info.size == sizeof(int)) {
+                bloom = TBM_make_bloom_filter(
+                    table, condition->col_info.index, ZONE_EQUALS, (unsigned char*)&short_value, sizeof(int), &filters[count]
+                );
+            }
+            else {
+                bloom = TBM_make_bloom_filter(
+                    table, condition->col_info.index, ZONE_EQUALS, (unsigned char*)&condition->number, sizeof(long long), &filters[count]
+                );
+            }
+        }
+        else {
+            bloom = TBM_make_bloom_filter(
+                table, condition->col_info.index, operation, (unsigned char*)condition->value, str_strlen(condition->value), &filters[count]
+            );
+        }
+
+        if (bloom == 1) count++;
+    }
+
+    return count;
+}
+
+/*
+Process text row with logic. Projection provided only by get command, that's why projected
+byte ranges copied to answer directly (Same with __get_logic).
+*/
+static int _process_text(
+    database_t* database, table_t* table, kernel_answer_t* answer, projection_t* projection, int index, unsigned char* text_data,
+    int (*logic)(database_t*, char*, int, unsigned char*, size_t, kernel_answer_t*)
+) {
+    if (!projection) return logic(database, table->header->name, index, text_data, table->text_size, answer);
+
+    int data_start = answer->answer_size;
+    answer->answer_size += projection->size;
+    answer->answer_body = (unsigned char*)realloc_s(answer->answer_body, answer->answer_size);
+    for (int i = 0; i < projection->count; i++) {
+        str_memcpy(answer->answer_body + data_start, text_data + projection->offsets[i], projection->sizes[i]);
+        data_start += projection->sizes[i];
+    }
+
+    return 1;
+}
+
+/*
+Invoke POSTLOAD modules for batch rows and process them with logic.
+With projection only modules of projected columns invoked.
+*/
+static void _flush_batch(
+    database_t* database, table_t* table, kernel_answer_t* answer, projection_t* projection, row_batch_t* batch,
+    int (*logic)(database_t*, char*, int, unsigned char*, size_t, kernel_answer_t*)
+) {
+    TBM_invoke_modules_rows(table, batch->rows, batch->count, COLUMN_MODULE_POSTLOAD, projection ? projection->modules : NULL);
+    for (int i = 0; i < batch->count; i++) {
+        _process_text(database, table, answer, projection, batch->indexes[i], batch->rows + i * table->text_size, logic);
+    }
+
+    batch->count = 0;
+}
+
+/*
+Process one table row with expression. If batch provided, matched row saved to batch,
+and logic invoked after modules (Check _flush_batch).
+
+Return 0 if limit reached.
+Return 1 if processing should continue.
+*/
+static int _process_row(
+    database_t* database, table_t* table, kernel_answer_t* answer, expression_t* exp, int index, int* processed_rows,
+    row_batch_t* batch, int (*logic)(database_t*, char*, int, unsigned char*, size_t, kernel_answer_t*)
+) {
+    // Stored row and text row placed in one buffer. Text row decoded only if needed.
+    unsigned char* row_data = (unsigned char*)malloc_s(table->row_size + table->text_size);
+    if (!row_data) return -1;
+
+    int get_result = DB_read_row(database, table->header->name, index, row_data, table->row_size);
+    if (!get_result) {
+        free_s(row_data);
+        return -1;
+    }
+
+    if (*row_data != PAGE_EMPTY) {
+        int decoded = 0;
+        unsigned char* text_data = row_data + table->row_size;
+        if (exp->needs_text) {
+            TBM_decode_row(table, row_data, text_data);
+            TBM_invoke_modules(table, text_data, COLUMN_MODULE_POSTLOAD);
+            decoded = 1;
+        }
+
+        if (_evaluate_expression(table, row_data, decoded ? text_data : NULL, exp)) {
+            if (exp->limit != -1 && (*processed_rows)++ >= exp->limit) {
+                free_s(row_data);
+                return 0;
+            }
+
+            if (batch && !decoded) {
+                TBM_decode_row(table, row_data, batch->rows + batch->count * table->text_size);
+                batch->indexes[batch->count++] = index;
+                if (batch->count >= MODULE_BATCH_SIZE) _flush_batch(database, table, answer, exp->projection, batch, logic);
+                free_s(row_data);
+                return 1;
+            }
+
+            if (!decoded) {
+                TBM_decode_row(table, row_data, text_data);
+                TBM_invoke_modules_rows(
+                    table, text_data, 1, COLUMN_MODULE_POSTLOAD, exp->projection ? exp->projection->modules : NULL
+                );
+            }
+
+            _process_text(database, table, answer, exp->projection, index, text_data, logic);
+        }
+    }
+
+    free_s(row_data);
     return 1;
 }
 
@@ -126,33 +473,56 @@ static int _process_table(
     database_t* database, table_t* table, kernel_answer_t* answer, expression_t* exp, 
     int (*logic)(database_t*, char*, int, unsigned char*, size_t, kernel_answer_t*)
 ) {
-    int index = exp->offset;
     int processed_rows = 0;
-    while (1) {
-        unsigned char* row_data = (unsigned char*)malloc_s(table->row_size);
-        if (!row_data) return -1;
 
-        int get_result = DB_get_row(database, table->header->name, index, row_data, table->row_size);
-        if (!get_result) {
-            free_s(row_data);
-            break;
+    // Rows with POSTLOAD modules collected to batch, that's why module launched once per batch.
+    // Projection without module columns don't need modules.
+    row_batch_t batch = { .count = 0, .rows = NULL };
+    if (
+        !exp->needs_text && TBM_has_modules(table, COLUMN_MODULE_POSTLOAD) &&
+        (!exp->projection || exp->projection->has_modules)
+    ) {
+        batch.rows = (unsigned char*)malloc_s(MODULE_BATCH_SIZE * table->text_size);
+    }
+
+    row_batch_t* current_batch = batch.rows ? &batch : NULL;
+
+    // Indexed column in expression. Check only rows from index.
+    int* rows = NULL;
+    int count = _find_indexed_rows(table, exp, &rows);
+    if (count >= 0) {
+        for (int i = 0; i < count; i++) {
+            if (rows[i] < exp->offset) continue;
+            if (!_process_row(database, table, answer, exp, rows[i], &processed_rows, current_batch, logic)) break;
         }
-        
-        if (*row_data != PAGE_EMPTY) {
-            if (_evaluate_expression(row_data, exp)) {
-                if (exp->limit != -1 && processed_rows++ >= exp->limit) {
-                    free_s(row_data);
-                    break;
-                }
-                
-                logic(database, table->header->name, index, row_data, table->row_size, answer);
+
+        SOFT_FREE(rows);
+    }
+    else {
+        // Pages, where rows can't match expression, skipped by zone maps and Bloom filters without load.
+        zone_filter_t filters[MAX_STATEMENTS * 2];
+        int filters_count = _make_zone_filters(table, exp, filters);
+        int rows_per_page = table->header->page_size / table->row_size;
+
+        int index = exp->offset, checked_page = -1, skipped_pages = 0;
+        while (1) {
+            int page = index / rows_per_page;
+            if (filters_count && page != checked_page) {
+                int skip = TBM_skip_pages(table, page, filters, filters_count);
+                if (skip > 0) index = (page + skip) * rows_per_page;
+                checked_page = page + skip;
+                skipped_pages += skip;
             }
+
+            if (_process_row(database, table, answer, exp, index, &processed_rows, current_batch, logic) <= 0) break;
+            index++;
         }
-        
-        index++;
-        free_s(row_data);
+
+        if (skipped_pages) print_debug("Zone maps and Bloom filters skipped [%i] pages of table [%.*s]", skipped_pages, TABLE_NAME_SIZE, table->header->name);
     }
 
+    if (current_batch && batch.count) _flush_batch(database, table, answer, exp->projection, current_batch, logic);
+    SOFT_FREE(batch.rows);
     return 1;
 }
 
@@ -182,7 +552,7 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
 
     /* Save commands into RAM. */
     char* commands[MAX_COMMANDS] = { NULL };
-    for (int i = current_start; i < argc; i++) {
+    for (int i = current_start; i < argc && i - current_start < MAX_COMMANDS; i++) {
         commands[i - current_start] = argv[i];
     }
 
@@ -208,6 +578,28 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
         else if (!str_strcmp(command, ROLLBACK)) {
             answer->answer_code = DB_rollback(&_connection);
         }
+        /*
+        Handle compaction command. Merge sparse pages of table in bounded steps.
+        Command syntax: compact <table_name> <page_count>
+        */
+#ifndef NO_DELETE_COMMAND
+        else if (!str_strcmp(command, COMPACT)) {
+            table_t* table = _get_table(database, SAFE_GET_VALUE_PRE_INC_S(commands, argc, command_index));
+            if (!table) return answer;
+
+            int max_pages = atoi_s(SAFE_GET_VALUE_PRE_INC_S(commands, argc, command_index));
+            if (max_pages <= 0) max_pages = TABLE_COMPACTION_STEP;
+            if (THR_require_write(&table->lock, get_thread_num())) {
+                // Compaction moves rows, that's why indexes rebuilt after it.
+                int result = TBM_compact_table(table, max_pages);
+                if (result > 0) DB_rebuild_indexes(table);
+                answer->answer_code = result > 0;
+                THR_release_write(&table->lock, get_thread_num());
+            }
+
+            TBM_flush_table(table);
+        }
+#endif
         /*
         Handle info command about cdbms kernel version.
         Command syntax: version
@@ -240,6 +632,7 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
                     table_t* dst_table = _get_table(database, dst_table_name);
                     if (!src_table || !dst_table) return answer;
                     TBM_migrate_table(src_table, dst_table, nav_stack, nav_stack_index);
+                    DB_rebuild_indexes(dst_table);
 
                     TBM_flush_table(src_table);
                     TBM_flush_table(dst_table);
@@ -274,7 +667,8 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
             }
             /*
             Handle table creation.
-            Command syntax: create table <name> columns ( name size <int/str/"<module>=args,<mpre/mpost/both>"/any> <is_primary/np> <auto_increment/na> )
+            Command syntax: create table <name> columns ( name size <int/bint/str/"<module>=args,<mpre/mpost/both>"/any> <is_primary/np> <auto_increment/na> ) options ( <slotted> <compress> )
+            Note: Options are optional.
             Errors:
             - Return -1 if table already exists in database.
             */
@@ -308,6 +702,7 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
                             char* column_data_type = column_stack[j + 2];
                             unsigned char data_type = COLUMN_TYPE_MODULE;
                             if (str_strcmp(column_data_type, TYPE_INT) == 0) data_type = COLUMN_TYPE_INT;
+                            else if (str_strcmp(column_data_type, TYPE_BIN_INT) == 0) data_type = COLUMN_TYPE_INT;
                             else if (str_strcmp(column_data_type, TYPE_ANY) == 0) data_type = COLUMN_TYPE_ANY;
                             else if (str_strcmp(column_data_type, TYPE_STRING) == 0) data_type = COLUMN_TYPE_STRING;
 
@@ -323,6 +718,16 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
                                 CREATE_COLUMN_TYPE_BYTE(primary_status, data_type, increment_status), atoi_s(column_stack[j + 1]), column_stack[j]
                             );
 
+                            // Binary int column stored as int32 / int64 (Check TBM_encode_row)
+                            if (str_strcmp(column_data_type, TYPE_BIN_INT) == 0) {
+                                columns[k]->type = SET_COLUMN_BINARY(columns[k]->type, COLUMN_BINARY_INT);
+                            }
+
+                            // Primary column get hash index for uniqueness check without table scan
+                            if (primary_status == COLUMN_PRIMARY && data_type != COLUMN_TYPE_MODULE) {
+                                columns[k]->type = SET_COLUMN_INDEX(columns[k]->type, COLUMN_INDEX_HASH);
+                            }
+
                             if (data_type == COLUMN_TYPE_MODULE) {
                                 char* equals_pos = strchr_s(column_data_type, '=');
                                 char* comma_pos  = strchr_s(column_data_type, ',');
@@ -345,13 +750,48 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
                     }
                 }
 
-                table_t* new_table = TBM_create_table(table_name, columns, column_count);
+                unsigned char page_flags = 0;
+                unsigned int page_size   = PAGE_CONTENT_SIZE;
+                char* option = SAFE_GET_VALUE_PRE_INC(commands, argc, command_index);
+                if (option && !str_strcmp(option, OPTIONS)) {
+                    option = SAFE_GET_VALUE_PRE_INC(commands, argc, command_index);
+                    if (option && *option == OPEN_BRACKET) {
+                        while ((option = (SAFE_GET_VALUE_PRE_INC(commands, argc, command_index))) && *option != CLOSE_BRACKET) {
+                            if (!str_strcmp(option, OPTION_SLOTTED)) page_flags |= PAGE_FLAG_SLOTTED;
+                            else if (!str_strcmp(option, OPTION_COMPRESS)) page_flags |= PAGE_FLAG_COMPRESSED;
+                            else if (!str_strcmp(option, OPTION_PAGE_SIZE)) {
+                                char* size = SAFE_GET_VALUE_PRE_INC(commands, argc, command_index);
+                                if (!size || *size == CLOSE_BRACKET) break;
+                                page_size = (unsigned int)atoi_s(size);
+                            }
+                            else if (!str_strcmp(option, OPTION_BLOOM)) {
+                                char* name = SAFE_GET_VALUE_PRE_INC(commands, argc, command_index);
+                                if (!name || *name == CLOSE_BRACKET) break;
+
+                                // Bloom filter only for not indexed columns, that stored in pages.
+                                for (int k = 0; k < column_count; k++) {
+                                    if (
+                                        str_strncmp(columns[k]->name, name, COLUMN_NAME_SIZE) ||
+                                        GET_COLUMN_DATA_TYPE(columns[k]->type) == COLUMN_TYPE_MODULE ||
+                                        GET_COLUMN_INDEX(columns[k]->type) != COLUMN_NO_INDEX
+                                    ) continue;
+
+                                    columns[k]->type = SET_COLUMN_INDEX(columns[k]->type, COLUMN_INDEX_BLOOM);
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                table_t* new_table = TBM_create_table(table_name, columns, column_count, page_flags, page_size);
                 if (!new_table) {
                     answer->answer_code = 6;
                     ARRAY_SOFT_FREE(columns, column_count);
                     return answer;
                 }
 
+                DB_rebuild_indexes(new_table);
                 DB_link_table2database(database, new_table);
                 CHC_add_entry(new_table, new_table->header->name, TABLE_BASE_PATH, TABLE_CACHE, (void*)TBM_free_table, (void*)TBM_save_table);
                 print_log("Table [%s] create success!", new_table->header->name);
@@ -360,6 +800,23 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
                 answer->answer_code = 1;
                 TBM_flush_table(new_table);
             }
+            /*
+            Handle index creation.
+            Command syntax: create index <table_name> <column_name>
+            Note: Index used by get, update and delete commands with by_exp option.
+            Errors:
+            - Return -4 if table not found.
+            - Return -2 if column not found.
+            - Return -1 if index can't be created (Module columns can't be indexed).
+            */
+            else if (!str_strcmp(SAFE_GET_VALUE_S(commands, argc, command_index), INDEX)) {
+                char* table_name = SAFE_GET_VALUE_PRE_INC(commands, argc, command_index);
+                char* column_name = SAFE_GET_VALUE_PRE_INC(commands, argc, command_index);
+                if (!table_name || !column_name) return answer;
+
+                answer->answer_code = DB_create_index(database, table_name, column_name);
+                answer->answer_size = -1;
+            }
         }
 #endif
         /*
@@ -385,6 +842,52 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
                     answer->answer_code = result;
                 }
             }
+            /*
+            Command syntax: append rows <table_name> values <data> <data> ...
+            Command syntax: append rows <table_name> hex <hex_data> <hex_data> ...
+            Note: Every value contains one or more rows without separators. Value size should be multiple of row size.
+            Note 2: Values are C strings, that's why they can't contain zero bytes. Rows with any bytes
+                    should be sent in hex form (Two hex symbols per byte).
+            Note 3: Command can't have more than MAX_COMMANDS arguments. Send many rows in one value.
+            Errors:
+            - Return -4 error if table not found.
+            - Return -5 error if value size not multiple of row size, or hex value is broken.
+            Return count of appended rows (Rows with not uniqe primary value skipped).
+            */
+            else if (!str_strcmp(SAFE_GET_VALUE_S(commands, argc, command_index), ROWS)) {
+                char* table_name = SAFE_GET_VALUE_PRE_INC(commands, argc, command_index);
+                char* data_format = SAFE_GET_VALUE_PRE_INC_S(commands, argc, command_index);
+                int is_hex = !str_strcmp(data_format, HEX);
+                if (is_hex || !str_strcmp(data_format, VALUES)) {
+                    int first_value = command_index + 1;
+                    size_t data_size = 0;
+                    for (int i = first_value; i < MAX_COMMANDS && commands[i]; i++) {
+                        data_size += is_hex ? str_strlen(commands[i]) / 2 : str_strlen(commands[i]);
+                    }
+
+                    unsigned char* data = (unsigned char*)malloc_s(data_size + 1);
+                    if (!data) return answer;
+
+                    int result = 0;
+                    size_t data_offset = 0;
+                    for (int i = first_value; i < MAX_COMMANDS && commands[i] && result >= 0; i++) {
+                        int value_size = str_strlen(commands[i]);
+                        if (!is_hex) str_memcpy(data + data_offset, commands[i], value_size);
+                        else if ((value_size = _decode_hex(commands[i], data + data_offset)) < 0) result = -5;
+                        data_offset += MAX(value_size, 0);
+                    }
+
+                    if (result >= 0) result = DB_append_rows(database, table_name, data, data_size);
+                    if (result >= 0) { print_log("[%i] rows successfully added to [%s] database!", result, database->header->name); }
+                    else {
+                        print_error("Error code: %i, Params: [%s] [%s]", result, database->header->name, table_name);
+                    }
+
+                    free_s(data);
+                    answer->answer_size = -1;
+                    answer->answer_code = result;
+                }
+            }
         }
         /*
         Handle get command.
@@ -410,27 +913,28 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
                 command_index++;
                 if (!str_strcmp(SAFE_GET_VALUE_S(commands, argc, command_index), BY_INDEX)) {
                     int index = atoi_s(SAFE_GET_VALUE_PRE_INC_S(commands, argc, command_index));
-                    answer->answer_body = (unsigned char*)malloc_s(table->row_size);
+                    answer->answer_body = (unsigned char*)malloc_s(table->text_size);
                     if (!answer->answer_body) {
                         return answer;
                     }
 
-                    if (!DB_get_row(database, table_name, index, answer->answer_body, table->row_size)) {
+                    if (!DB_get_row(database, table_name, index, answer->answer_body, table->text_size)) {
                         print_error("Something goes wrong! Params: [%.*s] [%s] [%i] [%i]", DATABASE_NAME_SIZE, database->header->name, table_name, index, access);
                         answer->answer_code = 8;
                         return answer;
                     }
 
-                    answer->answer_size = table->row_size;
+                    answer->answer_size = table->text_size;
                     answer->answer_code = (char)index;
                 }
                 /*
-                Note: will get line of rows, that equals expression.
-                Command syntax: get row table <table_name> by_exp column <column_name> <</>/!=/=/eq/neq> <value> <or/and> ... limit <limit>
+                Note: will get line of rows, that equals expression. Columns clause limits answer to projected columns.
+                Command syntax: get row table <table_name> by_exp column <column_name> <</>/!=/=/eq/neq> <value> <or/and> ... limit <limit> columns ( <column_name> ... )
                 */
                 else if (!str_strcmp(SAFE_GET_VALUE_S(commands, argc, command_index), BY_EXPRESSION)) {      
                     expression_t exp;
-                    _create_expression(table, commands, command_index, argc, &exp);
+                    projection_t projection;
+                    _create_expression(table, commands, command_index, argc, &exp, &projection);
                     _process_table(database, table, answer, &exp, __get_logic);
                 }
 
@@ -467,7 +971,7 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
                     if (!table) return answer;
                                         
                     expression_t exp;
-                    _create_expression(table, commands, command_index, argc, &exp);
+                    _create_expression(table, commands, command_index, argc, &exp, NULL);
                     _process_table(database, table, answer, &exp, __insert_logic);
                 }
             }
@@ -529,7 +1033,7 @@ kernel_answer_t* kernel_process_command(int argc, char* argv[]) {
                     if (!table) return answer;
                     
                     expression_t exp;
-                    _create_expression(table, commands, command_index, argc, &exp);
+                    _create_expression(table, commands, command_index, argc, &exp, NULL);
                     _process_table(database, table, answer, &exp, __delete_logic);
                 }
             }
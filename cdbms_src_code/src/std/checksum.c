@@ -48,4 +48,219 @@ checksum_t murmur3_x86_32(const unsigned char* key, unsigned int len, unsigned i
     h1 ^= len;
     h1 = _fmix32(h1);
     return h1;
-}
\ No newline at end of file
+}
+
+#if !defined(NO_CHECKSUM_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define CHECKSUM_X86_SIMD
+    #include <cpuid.h>
+    #include <immintrin.h>
+#endif
+
+static inline unsigned int _read32(const unsigned char* p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static inline unsigned long long _read64(const unsigned char* p) {
+    return (unsigned long long)_read32(p) | ((unsigned long long)_read32(p + 4) << 32);
+}
+
+static inline unsigned long long _rotl64(unsigned long long x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+#pragma region [CRC32C]
+
+    #define CRC32C_POLY 0x82F63B78
+
+    static unsigned int _crc32c_table[256];
+    static int _crc32c_path = -1;
+
+    static void _crc32c_init_table() {
+        for (unsigned int i = 0; i < 256; i++) {
+            unsigned int crc = i;
+            for (int j = 0; j < 8; j++) crc = (crc >> 1) ^ (CRC32C_POLY & (0 - (crc & 1)));
+            _crc32c_table[i] = crc;
+        }
+    }
+
+    static unsigned int _crc32c_scalar(unsigned int crc, const unsigned char* key, unsigned int len) {
+        for (unsigned int i = 0; i < len; i++) crc = (crc >> 8) ^ _crc32c_table[(crc ^ key[i]) & 0xFF];
+        return crc;
+    }
+
+#ifdef CHECKSUM_X86_SIMD
+
+    __attribute__((target("sse4.2")))
+    static unsigned int _crc32c_sse42(unsigned int crc, const unsigned char* key, unsigned int len) {
+        unsigned int i = 0;
+    #ifdef __x86_64__
+        unsigned long long crc64 = crc;
+        for (; i + 8 <= len; i += 8) crc64 = _mm_crc32_u64(crc64, _read64(key + i));
+        crc = (unsigned int)crc64;
+    #endif
+        for (; i + 4 <= len; i += 4) crc = _mm_crc32_u32(crc, _read32(key + i));
+        for (; i < len; i++) crc = _mm_crc32_u8(crc, key[i]);
+        return crc;
+    }
+
+    static int _crc32c_detect() {
+        unsigned int a = 0, b = 0, c = 0, d = 0;
+        if (!__get_cpuid(1, &a, &b, &c, &d)) return 0;
+        return (c & bit_SSE4_2) ? 1 : 0;
+    }
+
+#else
+
+    static int _crc32c_detect() {
+        return 0;
+    }
+
+#endif
+
+    checksum_t crc32c(const unsigned char* key, unsigned int len, unsigned int seed) {
+        if (_crc32c_path < 0) {
+            _crc32c_init_table();
+            _crc32c_path = _crc32c_detect();
+        }
+
+        unsigned int crc = ~seed;
+    #ifdef CHECKSUM_X86_SIMD
+        if (_crc32c_path) return ~_crc32c_sse42(crc, key, len);
+    #endif
+        return ~_crc32c_scalar(crc, key, len);
+    }
+
+#pragma endregion
+
+#pragma region [xxHash]
+
+    #define XXH_PRIME32_1 0x9E3779B1U
+    #define XXH_PRIME32_2 0x85EBCA77U
+    #define XXH_PRIME32_3 0xC2B2AE3DU
+    #define XXH_PRIME32_4 0x27D4EB2FU
+    #define XXH_PRIME32_5 0x165667B1U
+
+    #define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+    #define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+    #define XXH_PRIME64_3 0x165667B19E3779F9ULL
+    #define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+    #define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+    static inline unsigned int _xxh32_round(unsigned int acc, unsigned int input) {
+        acc += input * XXH_PRIME32_2;
+        acc  = _rotl32(acc, 13);
+        return acc * XXH_PRIME32_1;
+    }
+
+    checksum_t xxhash32(const unsigned char* key, unsigned int len, unsigned int seed) {
+        const unsigned char* p   = key;
+        const unsigned char* end = key + len;
+        unsigned int h32;
+
+        if (len >= 16) {
+            unsigned int v1 = seed + XXH_PRIME32_1 + XXH_PRIME32_2;
+            unsigned int v2 = seed + XXH_PRIME32_2;
+            unsigned int v3 = seed;
+            unsigned int v4 = seed - XXH_PRIME32_1;
+            for (; p + 16 <= end; p += 16) {
+                v1 = _xxh32_round(v1, _read32(p));
+                v2 = _xxh32_round(v2, _read32(p + 4));
+                v3 = _xxh32_round(v3, _read32(p + 8));
+                v4 = _xxh32_round(v4, _read32(p + 12));
+            }
+
+            h32 = _rotl32(v1, 1) + _rotl32(v2, 7) + _rotl32(v3, 12) + _rotl32(v4, 18);
+        }
+        else {
+            h32 = seed + XXH_PRIME32_5;
+        }
+
+        h32 += len;
+        for (; p + 4 <= end; p += 4) h32 = _rotl32(h32 + _read32(p) * XXH_PRIME32_3, 17) * XXH_PRIME32_4;
+        for (; p < end; p++) h32 = _rotl32(h32 + (*p) * XXH_PRIME32_5, 11) * XXH_PRIME32_1;
+
+        h32 ^= h32 >> 15;
+        h32 *= XXH_PRIME32_2;
+        h32 ^= h32 >> 13;
+        h32 *= XXH_PRIME32_3;
+        h32 ^= h32 >> 16;
+        return h32;
+    }
+
+    static inline unsigned long long _xxh64_round(unsigned long long acc, unsigned long long input) {
+        acc += input * XXH_PRIME64_2;
+        acc  = _rotl64(acc, 31);
+        return acc * XXH_PRIME64_1;
+    }
+
+    static inline unsigned long long _xxh64_merge(unsigned long long acc, unsigned long long val) {
+        acc ^= _xxh64_round(0, val);
+        return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+
+    unsigned long long xxhash64(const unsigned char* key, unsigned int len, unsigned long long seed) {
+        const unsigned char* p   = key;
+        const unsigned char* end = key + len;
+        unsigned long long h64;
+
+        if (len >= 32) {
+            unsigned long long v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+            unsigned long long v2 = seed + XXH_PRIME64_2;
+            unsigned long long v3 = seed;
+            unsigned long long v4 = seed - XXH_PRIME64_1;
+            for (; p + 32 <= end; p += 32) {
+                v1 = _xxh64_round(v1, _read64(p));
+                v2 = _xxh64_round(v2, _read64(p + 8));
+                v3 = _xxh64_round(v3, _read64(p + 16));
+                v4 = _xxh64_round(v4, _read64(p + 24));
+            }
+
+            h64 = _rotl64(v1, 1) + _rotl64(v2, 7) + _rotl64(v3, 12) + _rotl64(v4, 18);
+            h64 = _xxh64_merge(h64, v1);
+            h64 = _xxh64_merge(h64, v2);
+            h64 = _xxh64_merge(h64, v3);
+            h64 = _xxh64_merge(h64, v4);
+        }
+        else {
+            h64 = seed + XXH_PRIME64_5;
+        }
+
+        h64 += len;
+        for (; p + 8 <= end; p += 8) h64 = _rotl64(h64 ^ _xxh64_round(0, _read64(p)), 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        if (p + 4 <= end) {
+            h64 = _rotl64(h64 ^ ((unsigned long long)_read32(p) * XXH_PRIME64_1), 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+            p += 4;
+        }
+
+        for (; p < end; p++) h64 = _rotl64(h64 ^ ((*p) * XXH_PRIME64_5), 11) * XXH_PRIME64_1;
+
+        h64 ^= h64 >> 33;
+        h64 *= XXH_PRIME64_2;
+        h64 ^= h64 >> 29;
+        h64 *= XXH_PRIME64_3;
+        h64 ^= h64 >> 32;
+        return h64;
+    }
+
+#pragma endregion
+
+static int _algorithm = CHECKSUM_MURMUR3;
+
+int checksum_select(int algorithm) {
+    if (algorithm < 0 || algorithm >= CHECKSUM_COUNT) return -1;
+    _algorithm = algorithm;
+    return _algorithm;
+}
+
+checksum_t checksum_memory(int algorithm, const unsigned char* key, unsigned int len, unsigned int seed) {
+    if (algorithm == CHECKSUM_SELECTED) algorithm = _algorithm;
+    switch (algorithm) {
+        case CHECKSUM_CRC32C:   return crc32c(key, len, seed);
+        case CHECKSUM_XXHASH32: return xxhash32(key, len, seed);
+        case CHECKSUM_XXHASH64: {
+            unsigned long long h64 = xxhash64(key, len, seed);
+            return (checksum_t)(h64 ^ (h64 >> 32));
+        }
+        default: return murmur3_x86_32(key, len, seed);
+    }
+}
@@ -0,0 +1,119 @@
+#include <compress.h>
+
+#define MIN_NIBBLE(x) ((x) < 0xF ? (x) : 0xF)
+
+static inline unsigned int _read32(const unsigned char* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static inline unsigned int _hash(unsigned int sequence) {
+    return (sequence * 2654435761U) >> (32 - COMPRESS_HASH_BITS);
+}
+
+/*
+Write length extension. Value 15 in token nibble say, that length continues in next bytes.
+*/
+static inline int _write_length(unsigned char** op, unsigned char* oend, int length) {
+    for (; length >= 0xFF; length -= 0xFF) {
+        if (*op >= oend) return -1;
+        *(*op)++ = 0xFF;
+    }
+
+    if (*op >= oend) return -1;
+    *(*op)++ = (unsigned char)length;
+    return 1;
+}
+
+static inline int _read_length(const unsigned char** ip, const unsigned char* iend, int* length) {
+    unsigned char value = 0xFF;
+    while (value == 0xFF) {
+        if (*ip >= iend) return -1;
+        value = *(*ip)++;
+        *length += value;
+    }
+
+    return 1;
+}
+
+static int _write_sequence(
+    unsigned char** op, unsigned char* oend, const unsigned char* literals, int literals_count, int offset, int match_length
+) {
+    if (*op >= oend) return -1;
+    unsigned char* token = (*op)++;
+    *token = (unsigned char)(MIN_NIBBLE(literals_count) << 4);
+    if (literals_count >= 0xF && _write_length(op, oend, literals_count - 0xF) < 0) return -1;
+    if (oend - *op < literals_count) return -1;
+    for (int i = 0; i < literals_count; i++) *(*op)++ = literals[i];
+    if (!match_length) return 1;
+
+    if (oend - *op < 2) return -1;
+    *(*op)++ = (unsigned char)(offset & 0xFF);
+    *(*op)++ = (unsigned char)(offset >> 8);
+
+    match_length -= COMPRESS_MIN_MATCH;
+    *token |= MIN_NIBBLE(match_length);
+    if (match_length >= 0xF && _write_length(op, oend, match_length - 0xF) < 0) return -1;
+    return 1;
+}
+
+int compress_memory(const unsigned char* src, int l, unsigned char* dst, int capacity) {
+    unsigned int table[1 << COMPRESS_HASH_BITS] = { 0 };
+    const unsigned char* anchor = src;
+    unsigned char* op   = dst;
+    unsigned char* oend = dst + capacity;
+
+    int i = 0;
+    while (i + COMPRESS_MIN_MATCH <= l) {
+        unsigned int sequence = _read32(src + i);
+        unsigned int hash = _hash(sequence);
+        int candidate = (int)table[hash] - 1;
+        table[hash] = (unsigned int)(i + 1);
+
+        // Position stored with +1, that's why 0 in table is empty entry.
+        if (candidate < 0 || i - candidate > COMPRESS_MAX_OFFSET || _read32(src + candidate) != sequence) {
+            i++;
+            continue;
+        }
+
+        int match_length = COMPRESS_MIN_MATCH;
+        while (i + match_length < l && src[candidate + match_length] == src[i + match_length]) match_length++;
+        if (_write_sequence(&op, oend, anchor, (int)(src + i - anchor), i - candidate, match_length) < 0) return -1;
+
+        i += match_length;
+        anchor = src + i;
+    }
+
+    if (_write_sequence(&op, oend, anchor, (int)(src + l - anchor), 0, 0) < 0) return -1;
+    return (int)(op - dst);
+}
+
+int decompress_memory(const unsigned char* src, int l, unsigned char* dst, int capacity) {
+    const unsigned char* ip   = src;
+    const unsigned char* iend = src + l;
+    unsigned char* op = dst;
+    unsigned char* oend = dst + capacity;
+
+    while (ip < iend) {
+        unsigned char token = *ip++;
+        int literals_count = token >> 4;
+        if (literals_count == 0xF && _read_length(&ip, iend, &literals_count) < 0) return -1;
+        if (iend - ip < literals_count || oend - op < literals_count) return -1;
+        for (int i = 0; i < literals_count; i++) *op++ = *ip++;
+        if (ip >= iend) break;
+
+        if (iend - ip < 2) return -1;
+        int offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        int match_length = token & 0xF;
+        if (match_length == 0xF && _read_length(&ip, iend, &match_length) < 0) return -1;
+        match_length += COMPRESS_MIN_MATCH;
+
+        // Note: Match can overlap output (Offset less than length). We copy byte by byte for RLE.
+        if (!offset || op - dst < offset || oend - op < match_length) return -1;
+        const unsigned char* match = op - offset;
+        for (int i = 0; i < match_length; i++) *op++ = match[i];
+    }
+
+    return (int)(op - dst);
+}
@@ -40,7 +40,16 @@ int NIFAT32_init(nifat32_params* params) {
 
     bootstruct.extended_section.checksum = murmur3_x86_32((buffer_t)&bootstruct.extended_section, sizeof(nifat32_ext32_bootsector_t), 0);
     bootstruct.checksum = murmur3_x86_32((buffer_t)&bootstruct, sizeof(nifat32_bootsector_t), 0);
-    if (bootstruct.checksum != bcheck || bootstruct.extended_section.checksum != exbcheck) {
+    if (bootstruct.checksum != bcheck && !bootstruct.checksum_type) {
+        /* Old images don't have checksum_type field in bootsector checksum */
+        bootstruct.checksum = 0;
+        bootstruct.checksum = murmur3_x86_32((buffer_t)&bootstruct, sizeof(nifat32_bootsector_t) - sizeof(bootstruct.checksum_type), 0);
+    }
+
+    if (
+        bootstruct.checksum != bcheck || bootstruct.extended_section.checksum != exbcheck || 
+        bootstruct.checksum_type >= CHECKSUM_COUNT
+    ) {
         print_error(
             "Checksum check error! [bootstruct=%u != %u] or [ext_bootstruct=%u != %u]. Moving to reserved sector!", 
             bootstruct.checksum, bcheck, bootstruct.extended_section.checksum, exbcheck
@@ -59,11 +68,14 @@ int NIFAT32_init(nifat32_params* params) {
     _fs_data.fat_count      = bootstruct.table_count;
     _fs_data.total_sectors  = bootstruct.total_sectors_32;
     _fs_data.fat_size       = bootstruct.extended_section.table_size_32;
+    _fs_data.checksum_type  = bootstruct.checksum_type;
+    checksum_select(_fs_data.checksum_type);
 
     print_info("| NIFAT32 image load! Base information:");
     print_info("| Sectors per cluster: %i", bootstruct.sectors_per_cluster);
     print_info("| Bytes per sector:    %u", bootstruct.bytes_per_sector);
     print_info("| Reserved sectors:    %u", bootstruct.reserved_sector_count);
+    print_info("| Checksum type:       %u", bootstruct.checksum_type);
 
     int root_dir_sectors = ((bootstruct.root_entry_count * 32) + (bootstruct.bytes_per_sector - 1)) / bootstruct.bytes_per_sector;
     int data_sectors = _fs_data.total_sectors - (bootstruct.reserved_sector_count + (bootstruct.table_count * _fs_data.fat_size) + root_dir_sectors);
@@ -140,6 +152,7 @@ int NIFAT32_repair_bootsectors() {
     bs.reserved_sector_count = _fs_data.sectors_padd;
     bs.table_count           = _fs_data.fat_count;
     bs.total_sectors_32      = _fs_data.total_sectors;
+    bs.checksum_type         = _fs_data.checksum_type;
 
     nifat32_ext32_bootsector_t ext = { .boot_signature = 0x5A, .drive_number = 0x8, .volume_id = 0x1234 };
 
@@ -535,7 +548,7 @@ static int _deepcopy_handler(entry_info_t* info, directory_entry_t* entry, void*
     
     entry->dca = hca;
     entry->checksum = 0;
-    entry->checksum = murmur3_x86_32((const_buffer_t)entry, sizeof(directory_entry_t), 0);
+    entry->checksum = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)entry, sizeof(directory_entry_t), 0);
     if ((entry->attributes & FILE_DIRECTORY) == FILE_DIRECTORY) entry_iterate(hca, _deepcopy_handler, ctx, &_fs_data);
     return 0;
 }
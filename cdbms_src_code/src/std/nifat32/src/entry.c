@@ -3,7 +3,7 @@
 static int _validate_entry(directory_entry_t* entry) {
     checksum_t entry_checksum = entry->checksum;
     entry->checksum = 0;
-    if (murmur3_x86_32((buffer_t)entry, sizeof(directory_entry_t), 0) != entry_checksum) return 0;
+    if (checksum_memory(CHECKSUM_SELECTED, (buffer_t)entry, sizeof(directory_entry_t), 0) != entry_checksum) return 0;
     else entry->checksum = entry_checksum;
     return 1;
 }
@@ -77,7 +77,7 @@ static int _index_handler(entry_info_t* info, directory_entry_t* entry, void* ct
         return 0;
     }
 
-    checksum_t entry_hash = murmur3_x86_32((const_buffer_t)entry->file_name, sizeof(entry->file_name), 0);
+    checksum_t entry_hash = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)entry->file_name, sizeof(entry->file_name), 0);
     *context = ecache_insert(*context, entry_hash, (entry->attributes & FILE_DIRECTORY) != FILE_DIRECTORY, entry->dca);
     return 0;
 }
@@ -114,7 +114,7 @@ int entry_search(
 ) {
     print_debug("entry_search(name=%s, ca=%u, cache=%s)", name, ca, cache != NO_ECACHE ? "YES" : "NO");
     if (cache != NO_ECACHE) {
-        checksum_t entry_hash = murmur3_x86_32((const_buffer_t)name, 11, 0);
+        checksum_t entry_hash = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)name, 11, 0);
         ecache_t* cached_entry = ecache_find(cache, entry_hash);
         if (cached_entry) {
             if (meta) create_entry(name, IS_ECACHE_DIR(cached_entry), cached_entry->ca, 0, meta);
@@ -122,7 +122,7 @@ int entry_search(
         }
     }
 
-    entry_ctx_t ctx = { .meta = meta, .name = name, .name_hash = murmur3_x86_32((const_buffer_t)name, 11, 0) };
+    entry_ctx_t ctx = { .meta = meta, .name = name, .name_hash = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)name, 11, 0) };
     return entry_iterate(ca, _search_handler, (void*)&ctx, fi);
 }
 
@@ -136,9 +136,9 @@ static int _edit_handler(entry_info_t* info, directory_entry_t* entry, void* ctx
     context->ji = journal_add_operation(EDIT_OP, info->ca, info->offset, (unsqueezed_entry_t*)context->meta, context->fi);
     if (context->index != NO_ECACHE) {
         checksum_t src, dst;
-        src = murmur3_x86_32((const_buffer_t)context->name, 11, 0);
+        src = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)context->name, 11, 0);
         ecache_delete(context->index, src);
-        dst = murmur3_x86_32((const_buffer_t)entry->file_name, sizeof(entry->file_name), 0);
+        dst = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)entry->file_name, sizeof(entry->file_name), 0);
         ecache_insert(context->index, dst, (entry->attributes & FILE_DIRECTORY) != FILE_DIRECTORY, entry->dca);
     }
 
@@ -155,7 +155,7 @@ int entry_edit(
     entry_ctx_t context = { 
         .meta = (directory_entry_t*)meta, 
         .name = name, 
-        .name_hash = murmur3_x86_32((const_buffer_t)name, 11, 0), 
+        .name_hash = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)name, 11, 0), 
         .index = cache, .fi = fi 
     };
 
@@ -191,7 +191,7 @@ int entry_add(cluster_addr_t ca, ecache_t* __restrict cache, directory_entry_t*
                 str_memcpy(entry, meta, sizeof(directory_entry_t));
                 if (i + 1 < entries_per_cluster) (entry + 1)->file_name[0] = ENTRY_END;
                 if (cache != NO_ECACHE) {
-                    checksum_t entry_hash = murmur3_x86_32((const_buffer_t)meta->file_name, sizeof(meta->file_name), 0);
+                    checksum_t entry_hash = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)meta->file_name, sizeof(meta->file_name), 0);
                     ecache_insert(cache, entry_hash, (entry->attributes & FILE_DIRECTORY) != FILE_DIRECTORY, meta->dca);
                 }
 
@@ -292,9 +292,9 @@ static int _remove_handler(entry_info_t* info, directory_entry_t* entry, void* c
 
     if (context->index != NO_ECACHE) {
         checksum_t src, dst;
-        src = murmur3_x86_32((const_buffer_t)context->name, 11, 0);
+        src = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)context->name, 11, 0);
         ecache_delete(context->index, src);
-        dst = murmur3_x86_32((const_buffer_t)entry->file_name, sizeof(entry->file_name), 0);
+        dst = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)entry->file_name, sizeof(entry->file_name), 0);
         ecache_insert(context->index, dst, (entry->attributes & FILE_DIRECTORY) != FILE_DIRECTORY, entry->dca);
     }
 
@@ -339,8 +339,8 @@ int create_entry(
     }
 
     str_memcpy(entry->file_name, fullname, 11);
-    entry->name_hash = murmur3_x86_32((const_buffer_t)entry->file_name, sizeof(entry->file_name), 0);
-    entry->checksum  = murmur3_x86_32((const_buffer_t)entry, sizeof(directory_entry_t), 0);
+    entry->name_hash = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)entry->file_name, sizeof(entry->file_name), 0);
+    entry->checksum  = checksum_memory(CHECKSUM_SELECTED, (const_buffer_t)entry, sizeof(directory_entry_t), 0);
     print_debug("_create_entry=%.11s, is_dir=%i, fca=%u", entry->file_name, is_dir, first_cluster);
     return 1; 
 }
@@ -36,6 +36,18 @@ int str_memcmp(const void* firstPointer, const void* secondPointer, unsigned int
     return 0;
 }
 
+int str_memfind(const void* source, unsigned int source_size, const void* data, unsigned int data_size) {
+    const unsigned char* u8Source = (const unsigned char*)source;
+    const unsigned char* u8Data   = (const unsigned char*)data;
+    if (!data_size) return 0;
+    for (unsigned int i = 0; i + data_size <= source_size; i++) {
+        if (u8Source[i] != u8Data[0]) continue;
+        if (!str_memcmp(u8Source + i + 1, u8Data + 1, data_size - 1)) return (int)i;
+    }
+
+    return -1;
+}
+
 char* str_strncpy(char* dst, const char* src, int n) {
     int i = 0;
     while (i < n && src[i]) {
@@ -117,4 +129,12 @@ int str_uppercase(char* str) {
     return 1;
 }
 
+long long str_atoll(const char* str, int length) {
+    int i = 0, sign = 1;
+    while (i < length && str[i] == ' ') i++;
+    if (i < length && (str[i] == '-' || str[i] == '+')) sign = str[i++] == '-' ? -1 : 1;
 
+    long long value = 0;
+    for (; i < length && str[i] >= '0' && str[i] <= '9'; i++) value = value * 10 + (str[i] - '0');
+    return sign * value;
+}
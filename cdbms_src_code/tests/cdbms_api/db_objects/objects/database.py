@@ -10,10 +10,11 @@ class Database(DBobject):
         self.name: str = name
         self._tables: list[Table] = []
 
-    def add_table(self, table_name: str, access: str, **kwargs) -> Table:
+    def add_table(self, table_name: str, access: str, options: list[str] | None = None, **kwargs) -> Table:
         table: Table = Table(table_name=table_name, access=access, connection=self._connection, **kwargs)
+        table_options: str = f' options ( {" ".join(options)} )' if options else ''
         self._execute_querry(
-            f'{self.name} create table {table_name} {access} columns ( {" ".join([x.body for x in table.get_columns()])} )\0'
+            f'{self.name} create table {table_name} {access} columns ( {" ".join([x.body for x in table.get_columns()])} ){table_options}\0'
         )
 
         table._database = self.name
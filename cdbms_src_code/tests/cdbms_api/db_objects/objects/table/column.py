@@ -4,6 +4,7 @@ from enum import Enum
 
 class ColumnDataType(Enum):
     INT = 'int'
+    BINT = 'bint'
     STR = 'str'
     ANY = 'any'
     FLT = 'dob'
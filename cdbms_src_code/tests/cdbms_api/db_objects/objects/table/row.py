@@ -39,7 +39,7 @@ class Row:
             offset += column.size
 
             value = column_data.decode('utf-8').strip()
-            if column.data_type == ColumnDataType.INT:
+            if column.data_type in [ ColumnDataType.INT, ColumnDataType.BINT ]:
                 value = int(column_data.decode('utf-8').strip())
             elif column.data_type == ColumnDataType.FLT:
                 value = float(column_data.decode('utf-8').strip())
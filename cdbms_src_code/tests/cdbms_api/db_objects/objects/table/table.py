@@ -13,7 +13,7 @@ class LogicOperator(Enum):
     AND = "and"
 
 class Expressions(Enum):
-    EQUALS = "="
+    EQUALS = "=="
     NOT_EQUALS = "!="
     STR_EQUALS = "eq"
     STR_NOT_EQUALS = "neq"
@@ -48,6 +48,7 @@ class Table(DBobject):
         querry: str = self._generate_querry(**kwargs)
         return_code = self._execute_querry(f'{self._database} append row {self.name} values "{querry}"\0')
         if isinstance(return_code, int):
+            return_code = return_code - 256 if return_code > 127 else return_code
             if return_code == -20:
                 raise ValueError("Primary check failed!")
             elif return_code == -14:
@@ -62,7 +63,29 @@ class Table(DBobject):
             return 1
         else:
             return -1
-        
+
+    def append_rows(self, rows: list[dict], is_hex: bool = False) -> int:
+        querry: str = ''.join([self._generate_querry(**row) for row in rows])
+        if is_hex:
+            querry = querry.encode('utf-8').hex()
+
+        return_code = self._execute_querry(
+            f'{self._database} append rows {self.name} {"hex" if is_hex else "values"} "{querry}"\0'
+        )
+
+        if isinstance(return_code, int):
+            return_code = return_code - 256 if return_code > 127 else return_code
+            if return_code == -5:
+                raise ValueError("Rows size error!")
+            elif return_code == -4:
+                raise ValueError("Table not found!")
+            elif return_code < 0:
+                raise ValueError(f"Append rows error! Code: {return_code}")
+
+            return return_code
+        else:
+            return -1
+
     def get_row_by_index(self, index: int):
         row_body: bytes | int | None = self._execute_querry(querry=f'{self._database} get row {self.name} by_index {index}\0', is_code=False)
         if not isinstance(row_body, bytes):
@@ -72,13 +95,21 @@ class Table(DBobject):
         row: Row = Row(data=row_body)
         return row.parse_bytes_to_object(self._columns)
 
-    def get_row_by_expression(self, expression: list[Statement | LogicOperator], offset: int = -1, limit: int = -1) -> list | None:
+    def get_row_by_expression(
+        self, expression: list[Statement | LogicOperator], offset: int = -1, limit: int = -1, columns: list[str] | None = None
+    ) -> list | None:
         stmt = Table._generate_stmt(base=f"{self._database} get row {self.name} by_exp", params=expression)        
         if offset != -1:
             stmt += f" offset {offset}"
         
         if limit != -1:
             stmt += f" limit {limit}"
+
+        # Answer contains only projected columns in projection order
+        row_columns: list = self._columns
+        if columns:
+            stmt += f" columns ( {' '.join(columns)} )"
+            row_columns = [ column for name in columns for column in self._columns if column.name == name ]
         
         row_body: bytes | int | None = self._execute_querry(
             querry=f"{stmt}\0", is_code=False
@@ -87,7 +118,7 @@ class Table(DBobject):
         if not isinstance(row_body, bytes):
             return None
 
-        column_sizes: list | None = self._split_row_params()
+        column_sizes: list | None = self._split_row_params(row_columns)
         if column_sizes is None:
             return None
 
@@ -97,7 +128,7 @@ class Table(DBobject):
         output: list = []
         for x in range(rows):
             row: Row = Row(data=row_body[x * row_size:(x + 1) * row_size])
-            output.append(row.parse_bytes_to_object(self._columns))
+            output.append(row.parse_bytes_to_object(row_columns))
 
         return output
 
@@ -137,13 +168,23 @@ class Table(DBobject):
                 
         return querry
 
-    def _split_row_params(self) -> list | None:
+    def _split_row_params(self, columns: list | None = None) -> list | None:
         column_sizes: list = []
-        for column in self._columns:
+        for column in columns if columns is not None else self._columns:
             column_sizes.append(column.size)
 
         return column_sizes
 
+# endregion
+
+# region [Maintenance]
+
+    def create_index(self, column_name: str) -> bytes | int | None:
+        return self._execute_querry(f'{self._database} create index {self.name} {column_name}\0')
+
+    def compact(self, pages: int = 16) -> bytes | int | None:
+        return self._execute_querry(f'{self._database} compact {self.name} {pages}\0')
+
 # endregion
 
     def link_to_table(self, master_column: str, slave_table: Table, slave_column: str, args: list[str]) -> bytes | int | None:
@@ -0,0 +1,75 @@
+import time
+import argparse
+
+from cdbms_api.connection import Connection
+from cdbms_api.db_objects.objects.table.table import Table
+from cdbms_api.db_objects.objects.database import Database
+from cdbms_api.db_objects.objects.manager import DatabaseManager
+from cdbms_api.db_objects.objects.table.column import Column, ColumnDataType, ColumnType
+from cdbms_api.db_objects.objects.table.table import Expressions, Statement
+
+
+PAGE_SIZES: list[int] = [ 1024, 2048, 4096, 8192, 16384, 32768, 65536 ]
+
+
+def _create_table(database: Database, page_size: int, wide: bool) -> Table:
+    """
+    Create telemetry like table (Tiny rows) or table with wide rows.
+    Every table in sweep has own page size (options ( page_size <size> )).
+    """
+    name_size: int = 512 if wide else 8
+    return database.add_table(
+        table_name=f'{"w" if wide else "t"}{page_size}', access='same', options=[ 'page_size', str(page_size) ],
+        uid=Column('uid', ColumnDataType.INT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 8),
+        name=Column('name', ColumnDataType.STR, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], name_size),
+        weight=Column('weight', ColumnDataType.INT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 4)
+    )
+
+
+def _sweep(database: Database, rows: int, wide: bool) -> None:
+    print(f'\n[Benchmark] {"Wide" if wide else "Tiny"} rows, {rows} rows per table')
+    print(f'{"page_size":>10} | {"insert rows/s":>14} | {"scan rows/s":>14} | {"scan time":>10}')
+    for page_size in PAGE_SIZES:
+        table: Table = _create_table(database=database, page_size=page_size, wide=wide)
+
+        start_time: float = time.perf_counter()
+        for i in range(rows):
+            table.append_row(uid=i, name='Porosenok', weight=i % 250)
+
+        insert_time: float = time.perf_counter() - start_time
+        database.sync()
+
+        # Scan whole table. Last row is only one, that satisfy expression.
+        start_time = time.perf_counter()
+        found: list | None = table.get_row_by_expression(
+            expression=[ Statement(column_name="uid", expression=Expressions.EQUALS, value=rows - 1) ], limit=1
+        )
+
+        scan_time: float = time.perf_counter() - start_time
+        assert found is not None and len(found) == 1 and found[0].uid == rows - 1, f"Scan failed for page size {page_size}"
+        print(
+            f'{page_size:>10} | {rows / max(insert_time, 1e-9):>14.1f} | '
+            f'{rows / max(scan_time, 1e-9):>14.1f} | {scan_time:>9.4f}s'
+        )
+
+        database.remove_table(table)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Page size sweep benchmark (Insert and scan throughput).")
+    parser.add_argument("--addr", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=7777)
+    parser.add_argument("--rows", type=int, default=10000)
+    args = parser.parse_args()
+
+    connection: Connection = Connection(base_addr=args.addr, port=args.port, username='root', password='root')
+    manager: DatabaseManager = DatabaseManager(connection=connection)
+    database: Database = manager.create_database('pgbench')
+
+    try:
+        _sweep(database=database, rows=args.rows, wide=False)
+        _sweep(database=database, rows=args.rows, wide=True)
+    except AssertionError as ex:
+        print("Benchmark failed! Text:", str(ex))
+    except KeyboardInterrupt:
+        print("\nBenchmark stopped.")
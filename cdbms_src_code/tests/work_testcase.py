@@ -140,6 +140,40 @@ def _global_test() -> None:
 
     # endregion
 
+    # region [INDEX]
+
+    print('\n[Test] Index creation and lookup test...')
+    start_time = time.perf_counter()
+    assert table.create_index('huid') == 1, "Index for huid wasn't created"
+    assert table.create_index('name') == 1, "Index for name wasn't created"
+    create_time = time.perf_counter() - start_time
+    print(f'[Time] Index creation time [huid, name]: {create_time:.6f} sec.')
+
+    start_time = time.perf_counter()
+    rows: list = _by_exp_str_test(
+        expression=[
+            Statement(column_name="huid", expression=Expressions.EQUALS, value=random_index)
+        ]
+    )
+
+    retrieve_time = time.perf_counter() - start_time
+    print(f'[Time] Get time [by_exp huid = {random_index} (Index)]: {retrieve_time:.6f} sec. | Count: {len(rows)}')
+    assert len(rows) == 1, f"Index lookup count is not 1 | count: {len(rows)}/1"
+    assert rows[0].huid == random_index and rows[0].name == "Porosenok", "Index lookup data incorrect"
+
+    rows: list = _by_exp_str_test(
+        expression=[
+            Statement(column_name="huid", expression=Expressions.MORE_THEN, value=ROWS - 1),
+            LogicOperator.AND,
+            Statement(column_name="name", expression=Expressions.STR_EQUALS, value="SecondTest"),
+        ]
+    )
+
+    assert len(rows) == 1 and rows[0].huid == ROWS + 1, f"Index range lookup incorrect | count: {len(rows)}/1"
+    _test_data_test()
+
+    # endregion
+
     # region [UPDATE]
 
     print('\n[Test] Update row by expression test...')
@@ -224,6 +258,325 @@ def _global_test() -> None:
 
     # endregion
 
+    # region [INDEX AFTER CHANGES]
+
+    print('\n[Test] Index lookup after update, delete, append and compaction test...')
+    rows: list = _by_exp_str_test(
+        expression=[
+            Statement(column_name="huid", expression=Expressions.EQUALS, value=7)
+        ]
+    )
+
+    assert len(rows) == 1 and rows[0].name == "Kitty", f"Index wasn't updated by append | count: {len(rows)}/1"
+    rows: list = _by_exp_str_test(
+        expression=[
+            Statement(column_name="name", expression=Expressions.STR_EQUALS, value="Porosenok")
+        ]
+    )
+
+    assert len(rows) == 0, "Index wasn't updated by update / delete"
+
+    start_time = time.perf_counter()
+    table.compact(pages=64)
+    compact_time = time.perf_counter() - start_time
+    print(f'[Time] Compaction time [64 pages]: {compact_time:.6f} sec.')
+
+    rows: list = _by_exp_str_test(
+        expression=[
+            Statement(column_name="huid", expression=Expressions.EQUALS, value=0)
+        ]
+    )
+
+    assert len(rows) == 2, f"Index wasn't rebuilt after compaction | count: {len(rows)}/2"
+    for i in rows:
+        assert i.name in [ 'FirstTest', 'Kitty' ], "Wrong data after compaction"
+
+    rows: list = _by_exp_str_test(
+        expression=[
+            Statement(column_name="name", expression=Expressions.STR_EQUALS, value="Kitty")
+        ], limit=55
+    )
+
+    assert len(rows) == 50, f"Rows lost after compaction: {len(rows)}/50"
+    database.sync()
+    _test_data_test()
+
+    # endregion
+
+    # region [APPEND ROWS]
+
+    print('\n[Test] Batch append, primary check in batch and hex rows test...')
+    BATCH_ROWS: int = 1000
+    BATCH_SIZE: int = 100 # Answer code is signed char, that's why batch should be less then 128 rows
+    cows: Table = database.add_table(
+        table_name='cows', access='same',
+        uid=Column('uid', ColumnDataType.INT, [ColumnType.PRIMARY, ColumnType.WHITOUT_AUTO], 8),
+        name=Column('name', ColumnDataType.STR, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 16),
+        weight=Column('weight', ColumnDataType.INT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 4)
+    )
+
+    start_time = time.perf_counter()
+    for i in range(BATCH_ROWS):
+        cows.append_row(uid=i, name='Burenka', weight=random.randint(100, 250))
+
+    single_time = time.perf_counter() - start_time
+    print(f'[Time] Single append time [{BATCH_ROWS} rows]: {single_time:.4f} sec.')
+
+    start_time = time.perf_counter()
+    appended: int = 0
+    for i in range(BATCH_ROWS, 2 * BATCH_ROWS, BATCH_SIZE):
+        appended += cows.append_rows([
+            { 'uid': x, 'name': 'Zorka', 'weight': random.randint(100, 250) } for x in range(i, i + BATCH_SIZE)
+        ])
+
+    batch_time = time.perf_counter() - start_time
+    print(f'[Time] Batch append time [{BATCH_ROWS} rows]: {batch_time:.4f} sec. | Speedup: {single_time / batch_time:.2f}x (Target 10x)')
+    assert appended == BATCH_ROWS, f"Batch rows wasn't append: {appended}/{BATCH_ROWS}"
+    assert single_time / batch_time >= 10, f"Batch append slower then target: {single_time / batch_time:.2f}x/10x"
+
+    rows: list = _by_exp_str_test(
+        expression=[
+            Statement(column_name="uid", expression=Expressions.MORE_THEN, value=BATCH_ROWS - 3),
+            LogicOperator.AND,
+            Statement(column_name="uid", expression=Expressions.LESS_THEN, value=BATCH_ROWS + 2)
+        ]
+    )
+
+    assert len(rows) == 4, f"Batch rows order incorrect | count: {len(rows)}/4"
+    for i in rows:
+        assert i.name == ('Burenka' if i.uid < BATCH_ROWS else 'Zorka'), "Wrong data after batch append"
+
+    appended = cows.append_rows([
+        { 'uid': 3000, 'name': 'Dup', 'weight': 1 },
+        { 'uid': 3001, 'name': 'Dup', 'weight': 2 },
+        { 'uid': 3001, 'name': 'Dup', 'weight': 3 },
+        { 'uid': 5, 'name': 'Dup', 'weight': 4 },
+        { 'uid': 3002, 'name': 'Dup', 'weight': 5 }
+    ])
+
+    assert appended == 3, f"Not unique primary rows wasn't skipped: {appended}/3"
+    rows: list = _by_exp_str_test(
+        expression=[
+            Statement(column_name="name", expression=Expressions.STR_EQUALS, value="Dup")
+        ], limit=10
+    )
+
+    assert len(rows) == 3, f"Wrong rows count after primary check: {len(rows)}/3"
+    assert sorted([ i.weight for i in rows ]) == [ 1, 2, 5 ], "First row with primary value should stay"
+
+    appended = cows.append_rows([
+        { 'uid': 4000 + x, 'name': 'Hex', 'weight': x } for x in range(10)
+    ], is_hex=True)
+
+    assert appended == 10, f"Hex rows wasn't append: {appended}/10"
+    rows: list = _by_exp_str_test(
+        expression=[
+            Statement(column_name="name", expression=Expressions.STR_EQUALS, value="Hex")
+        ], limit=15
+    )
+
+    assert len(rows) == 10, f"Wrong hex rows count: {len(rows)}/10"
+    for i in rows:
+        assert i.uid == 4000 + i.weight, "Wrong data after hex append"
+
+    database.sync()
+    _test_data_test()
+
+    # endregion
+
+    # region [BINARY INT]
+
+    print('\n[Test] Binary int round-trip, overflow and downgrade to text test...')
+    OVERFLOW_VALUE: int = 99999999999999999999
+    goats: Table = database.add_table(
+        table_name='goats', access='same', options=['slotted'],
+        uid=Column('uid', ColumnDataType.BINT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 20),
+        weight=Column('weight', ColumnDataType.BINT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 8),
+        big=Column('big', ColumnDataType.BINT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 20),
+        name=Column('name', ColumnDataType.STR, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 8)
+    )
+
+    start_time = time.perf_counter()
+    goats.append_row(uid=1, weight=7, big=123456789012345, name='Binary')
+    row_body = goats._execute_querry(querry=f'{database.name} get row goats by_index 0\0', is_code=False)
+    retrieve_time = time.perf_counter() - start_time
+    print(f'[Time] Binary int append and get time: {retrieve_time:.6f} sec.')
+    assert row_body == f'{1:020}{7:08}{123456789012345:020}{"Binary":>8}'.encode('utf-8'), f"Binary int round-trip incorrect: {row_body}"
+
+    try:
+        goats.append_row(uid=2, weight=1, big=OVERFLOW_VALUE, name='Overflow')
+        assert False, "Overflow value wasn't rejected"
+    except ValueError as ex:
+        assert 'Expected int' in str(ex), f"Overflow value rejected with wrong code: {str(ex)}"
+
+    # First column stored as text, that's why it takes any int with column size.
+    goats.append_row(uid=OVERFLOW_VALUE, weight=99999999, big=1, name='First')
+    rows: list = goats.get_row_by_expression(
+        expression=[
+            Statement(column_name="name", expression=Expressions.STR_NOT_EQUALS, value="Binary")
+        ], limit=5
+    )
+
+    assert len(rows) == 1 and rows[0].name == 'First', f"Overflow row was saved | count: {len(rows)}/1"
+    assert rows[0].uid == OVERFLOW_VALUE and rows[0].weight == 99999999, "First column wasn't stored as text"
+
+    sheeps: Table = database.add_table(
+        table_name='sheeps', access='same',
+        uid=Column('uid', ColumnDataType.INT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 8),
+        big=Column('big', ColumnDataType.BINT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 20)
+    )
+
+    sheeps.append_row(uid=1, big=OVERFLOW_VALUE)
+    row_body = sheeps._execute_querry(querry=f'{database.name} get row sheeps by_index 0\0', is_code=False)
+    assert row_body == f'{1:08}{OVERFLOW_VALUE:020}'.encode('utf-8'), f"Binary int in not slotted table wasn't stored as text: {row_body}"
+
+    database.sync()
+    _test_data_test()
+
+    # endregion
+
+    # region [PROJECTION]
+
+    print('\n[Test] Columns projection and POSTLOAD modules test...')
+    horses: Table = database.add_table(
+        table_name='horses', access='same',
+        uid=Column('uid', ColumnDataType.INT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 8),
+        weight=Column('weight', ColumnDataType.INT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 4),
+        double=Column('double', ColumnDataType.NONE.module('calc=weight*2,mpost'), [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 8),
+        quad=Column('quad', ColumnDataType.ANY.module('calc=double*2,mpost'), [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 8),
+        name=Column('name', ColumnDataType.STR, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 16)
+    )
+
+    appended: int = horses.append_rows([
+        { 'uid': x, 'weight': 100 + x, 'name': 'Horse' } for x in range(50)
+    ])
+
+    assert appended == 50, f"Horses wasn't append: {appended}/50"
+    horses_expression: list = [
+        Statement(column_name="uid", expression=Expressions.LESS_THEN, value=50)
+    ]
+
+    start_time = time.perf_counter()
+    rows: list = horses.get_row_by_expression(expression=horses_expression, limit=50)
+    retrieve_time = time.perf_counter() - start_time
+    print(f'[Time] Get time [by_exp uid < 50 (All columns)]: {retrieve_time:.6f} sec. | Count: {len(rows)}')
+    assert len(rows) == 50, f"Wrong horses count: {len(rows)}/50"
+    for i in rows:
+        assert int(i.double) == i.weight * 2 and int(i.quad) == i.weight * 4, "POSTLOAD modules wasn't invoked"
+
+    start_time = time.perf_counter()
+    rows: list = horses.get_row_by_expression(expression=horses_expression, limit=50, columns=['name', 'uid'])
+    retrieve_time = time.perf_counter() - start_time
+    print(f'[Time] Get time [by_exp uid < 50 columns ( name uid ) (Without modules)]: {retrieve_time:.6f} sec. | Count: {len(rows)}')
+    assert len(rows) == 50, f"Wrong projected horses count: {len(rows)}/50"
+    for i in rows:
+        assert i.name == 'Horse' and 0 <= i.uid < 50, "Projected columns order incorrect"
+        assert not hasattr(i, 'weight') and not hasattr(i, 'double'), "Not projected columns in answer"
+
+    row_body = horses._execute_querry(
+        querry=f'{database.name} get row horses by_exp column uid < 50 limit 50 columns ( name uid )\0', is_code=False
+    )
+
+    assert len(row_body) == 50 * (16 + 8), f"Projected answer size incorrect: {len(row_body)}/{50 * (16 + 8)}"
+
+    # Module column, used in projected module querry, invoked too. Not projected modules don't change answer.
+    rows: list = horses.get_row_by_expression(expression=horses_expression, limit=50, columns=['quad', 'uid'])
+    assert len(rows) == 50, f"Wrong projected modules count: {len(rows)}/50"
+    for i in rows:
+        assert int(i.quad) == (100 + i.uid) * 4, "POSTLOAD module of projected column incorrect"
+
+    rows: list = horses.get_row_by_expression(expression=horses_expression, limit=50, columns=['double', 'name'])
+    for i in rows:
+        assert i.name == 'Horse' and int(i.double) >= 200 and not hasattr(i, 'quad'), "POSTLOAD module of projected column incorrect"
+
+    database.sync()
+    _test_data_test()
+
+    # endregion
+
+    # region [ZONE MAPS]
+
+    print('\n[Test] Zone maps skipping over append-ordered data test...')
+    ZONE_ROWS: int = 600
+    ducks: Table = database.add_table(
+        table_name='ducks', access='same', options=['page_size', '1024'],
+        ts=Column('ts', ColumnDataType.INT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 8),
+        name=Column('name', ColumnDataType.STR, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 8),
+        weight=Column('weight', ColumnDataType.INT, [ColumnType.NOT_PRIMARY, ColumnType.WHITOUT_AUTO], 4)
+    )
+
+    for i in range(0, ZONE_ROWS, 100):
+        ducks.append_rows([
+            { 'ts': x, 'name': f'Duck{x // 100}', 'weight': random.randint(100, 250) } for x in range(i, i + 100)
+        ])
+
+    def _full_scan() -> dict:
+        """
+        Get all rows without zone maps (neq can't skip pages). Offset is row index, that's why
+        windows overlap after delete, and rows merged by ts.
+        """
+        output: dict = {}
+        for offset in range(0, ZONE_ROWS, 100):
+            rows: list | None = ducks.get_row_by_expression(
+                expression=[
+                    Statement(column_name="name", expression=Expressions.STR_NOT_EQUALS, value="None")
+                ], offset=offset, limit=100
+            )
+
+            for i in rows or []:
+                output[i.ts] = (i.ts, i.name, i.weight)
+
+        return output
+
+    def _zone_maps_test() -> None:
+        start_time = time.perf_counter()
+        full: dict = _full_scan()
+        retrieve_time = time.perf_counter() - start_time
+        print(f'[Time] Full scan time [{len(full)} rows]: {retrieve_time:.6f} sec.')
+
+        cases: list = [
+            ([ Statement(column_name="ts", expression=Expressions.LESS_THEN, value=120) ], lambda x: x[0] < 120),
+            ([ Statement(column_name="ts", expression=Expressions.MORE_THEN, value=480) ], lambda x: x[0] > 480),
+            ([ Statement(column_name="ts", expression=Expressions.EQUALS, value=333) ], lambda x: x[0] == 333),
+            ([ Statement(column_name="name", expression=Expressions.STR_EQUALS, value="Duck3") ], lambda x: x[1] == 'Duck3'),
+            (
+                [
+                    Statement(column_name="ts", expression=Expressions.MORE_THEN, value=250),
+                    LogicOperator.AND,
+                    Statement(column_name="ts", expression=Expressions.LESS_THEN, value=350)
+                ], lambda x: 250 < x[0] < 350
+            )
+        ]
+
+        for expression, check in cases:
+            start_time = time.perf_counter()
+            rows: list | None = ducks.get_row_by_expression(expression=expression, limit=150)
+            retrieve_time = time.perf_counter() - start_time
+
+            expected: list = sorted([ x for x in full.values() if check(x) ])
+            rows = sorted([ (i.ts, i.name, i.weight) for i in rows or [] ])
+            print(f'[Time] Get time [by_exp {Table._generate_stmt(base="", params=expression).strip()}]: {retrieve_time:.6f} sec. | Count: {len(rows)}')
+            assert rows == expected, f"Zone maps result differs from full scan | count: {len(rows)}/{len(expected)}"
+
+    _zone_maps_test()
+
+    ducks.delete_row_by_expression(
+        expression=[
+            Statement(column_name="ts", expression=Expressions.MORE_THEN, value=300),
+            LogicOperator.AND,
+            Statement(column_name="ts", expression=Expressions.LESS_THEN, value=400)
+        ]
+    )
+
+    assert len(_full_scan()) == ZONE_ROWS - 99, "Rows wasn't deleted"
+    _zone_maps_test()
+
+    database.sync()
+    _zone_maps_test()
+    _test_data_test()
+
+    # endregion
+
     connection.close_connection()
     print('\nTest Complete\nIf you see this message, be sure, all functions in CDBMS works correct!\n')
     retrieve_time = time.perf_counter() - start_test_time
@@ -281,7 +634,7 @@ if __name__ == "__main__":
                 print("Unhundled exception! Text: ", str(ex))
             finally:
                 pass
-                _delete_files("/Users/nikolaj/Documents/Repositories/CordellDBMS.EXMPL/builds", ["db", "pg", "dr", "tb"])
+                _delete_files("/Users/nikolaj/Documents/Repositories/CordellDBMS.EXMPL/builds", ["db", "pg", "dr", "tb", "ix"])
             
             input("\nPress any key to continue...")
     except KeyboardInterrupt:
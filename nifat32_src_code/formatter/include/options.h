@@ -12,6 +12,7 @@
 #define FAT_COUNT_OPT        "--fc"
 #define BS_BACKUPS_OPT       "--bsbc"        /* Bootsector backups count */
 #define JOURNALS_BACKUPS_OPT "--jc"
+#define CHECKSUM_OPT         "--checksum"    /* murmur3 / crc32c / xxhash32 / xxhash64 */
 
 typedef struct {
     char* save_path;
@@ -22,6 +23,7 @@ typedef struct {
     int   bsbc;   // bootsector count
     int   jc;     // journals count
     int   ec;     // errors count (error storage)
+    int   cs;     // checksum algorithm for entries
 } opt_t;
 
 int process_input(int argc, char* argv[], opt_t* opt);
@@ -18,7 +18,8 @@ static opt_t opt = {
     .fc     = FAT_COUNT,
     .bsbc   = BS_BACKUPS,
     .jc     = JOURNALS_BACKUPS,
-    .ec     = ERRORS_COUNT
+    .ec     = ERRORS_COUNT,
+    .cs     = CHECKSUM_MURMUR3
 };
 
 int main(int argc, char* argv[]) {
@@ -160,57 +161,6 @@ static uint32_t _calculate_fat_size(uint32_t total_sectors) {
         return (void*)dst;
     }
 
-    
-    static inline unsigned int _rotl32(unsigned int x, char r) {
-        return (x << r) | (x >> (32 - r));
-    }
-
-    static inline unsigned int _fmix32(unsigned int h) {
-        h ^= h >> 16;
-        h *= 0x85ebca6b;
-        h ^= h >> 13;
-        h *= 0xc2b2ae35;
-        h ^= h >> 16;
-        return h;
-    }
-
-    unsigned int _murmur3_x86_32(const unsigned char* key, unsigned int len, unsigned int seed) {
-        const unsigned int c1 = 0xcc9e2d51;
-        const unsigned int c2 = 0x1b873593;
-
-        const int nblocks = len / 4;
-        unsigned int h1 = seed;
-
-        const unsigned int* blocks = (const unsigned int *)(key);
-        for (int i = 0; i < nblocks; i++) {
-            unsigned int k1 = blocks[i];
-
-            k1 *= c1;
-            k1 = _rotl32(k1, 15);
-            k1 *= c2;
-
-            h1 ^= k1;
-            h1 = _rotl32(h1, 13);
-            h1 = h1 * 5 + 0xe6546b64;
-        }
-
-        const unsigned char* tail = (const unsigned char*)(key + nblocks * 4);
-        unsigned int k1 = 0;
-        switch (len & 3) {
-            case 3: k1 ^= tail[2] << 16;
-            case 2: k1 ^= tail[1] << 8;
-            case 1: k1 ^= tail[0];
-                    k1 *= c1;
-                    k1 = _rotl32(k1, 15);
-                    k1 *= c2;
-                    h1 ^= k1;
-        }
-
-        h1 ^= len;
-        h1 = _fmix32(h1);
-        return h1;
-    }
-
 #pragma endregion
 
 static int _write_bs(int fd, uint32_t total_sectors, uint32_t fat_size) {
@@ -241,11 +191,13 @@ static int _write_bs(int fd, uint32_t total_sectors, uint32_t fat_size) {
     memcpy(ext.volume_label, "ROOT_LABEL ", 11);
     memcpy(ext.fat_type_label, "NIFAT32 ", 8);
     ext.checksum = 0;
-    ext.checksum = _murmur3_x86_32((uint8_t*)&ext, sizeof(ext), 0);
+    ext.checksum = murmur3_x86_32((uint8_t*)&ext, sizeof(ext), 0);
 
+    // Bootsector always protected by murmur3. Selected algorithm used for entries.
     memcpy(&bs.extended_section, &ext, sizeof(ext));
+    bs.checksum_type = opt.cs;
     bs.checksum = 0;
-    bs.checksum = _murmur3_x86_32((uint8_t*)&bs, sizeof(bs), 0);
+    bs.checksum = murmur3_x86_32((uint8_t*)&bs, sizeof(bs), 0);
     fprintf(stdout, "Bootstruct checksum: %u, ext. section: %u\n", bs.checksum, ext.checksum);
 
     int encoded_size = sizeof(encoded_t) * sizeof(nifat32_bootsector_t);
@@ -417,11 +369,11 @@ static int _copy_files_to_fs(
             }
 
             _to_83_name(entry->d_name, (char*)root_dir[entry_count].file_name);
-            root_dir[entry_count].name_hash  = _murmur3_x86_32(root_dir[entry_count].file_name, sizeof(root_dir[entry_count].file_name), 0);
+            root_dir[entry_count].name_hash  = checksum_memory(opt.cs, root_dir[entry_count].file_name, sizeof(root_dir[entry_count].file_name), 0);
             root_dir[entry_count].attributes = 0x10;
             root_dir[entry_count].cluster    = start_cluster;
             root_dir[entry_count].file_size  = 0;
-            root_dir[entry_count].checksum   = _murmur3_x86_32((uint8_t*)&root_dir[entry_count], sizeof(root_dir[entry_count]), 0);
+            root_dir[entry_count].checksum   = checksum_memory(opt.cs, (uint8_t*)&root_dir[entry_count], sizeof(root_dir[entry_count]), 0);
             fprintf(stdout, "%s checksum: %u\n", entry->d_name, root_dir[entry_count].checksum);
             entry_count++;
         }
@@ -442,24 +394,24 @@ static int _copy_files_to_fs(
             fclose(src_file);
 
             _to_83_name(entry->d_name, (char*)root_dir[entry_count].file_name);
-            root_dir[entry_count].name_hash  = _murmur3_x86_32(root_dir[entry_count].file_name, strlen((char*)root_dir[entry_count].file_name), 0);
+            root_dir[entry_count].name_hash  = checksum_memory(opt.cs, root_dir[entry_count].file_name, strlen((char*)root_dir[entry_count].file_name), 0);
             root_dir[entry_count].attributes = 0x20;
             root_dir[entry_count].cluster    = start_cluster;
             root_dir[entry_count].file_size  = file_size;
             root_dir[entry_count].checksum   = 0;
-            root_dir[entry_count].checksum   = _murmur3_x86_32((uint8_t*)&root_dir[entry_count], sizeof(root_dir[entry_count]), 0);
+            root_dir[entry_count].checksum   = checksum_memory(opt.cs, (uint8_t*)&root_dir[entry_count], sizeof(root_dir[entry_count]), 0);
             fprintf(stdout, "%s checksum: %u\n", entry->d_name, root_dir[entry_count].checksum);
             entry_count++;
         }
     }
 
     root_dir[entry_count].file_name[0] = ENTRY_END;
-    root_dir[entry_count].name_hash  = _murmur3_x86_32((uint8_t*)root_dir[entry_count].file_name, sizeof(root_dir[entry_count].file_name), 0);
+    root_dir[entry_count].name_hash  = checksum_memory(opt.cs, (uint8_t*)root_dir[entry_count].file_name, sizeof(root_dir[entry_count].file_name), 0);
     root_dir[entry_count].attributes = 0;
     root_dir[entry_count].cluster    = 0;
     root_dir[entry_count].file_size  = 0;
     root_dir[entry_count].checksum   = 0;
-    root_dir[entry_count].checksum   = _murmur3_x86_32((uint8_t*)&root_dir[entry_count], sizeof(root_dir[entry_count]), 0);
+    root_dir[entry_count].checksum   = checksum_memory(opt.cs, (uint8_t*)&root_dir[entry_count], sizeof(root_dir[entry_count]), 0);
     fprintf(stdout, "END checksum: %u\n", root_dir[entry_count].checksum);
     entry_count++;
 
@@ -492,27 +444,27 @@ static int _create_directory(
 
             directory_entry_t entries[3] = { 0 };
             _to_83_name(".", (char*)entries[0].file_name);
-            entries[0].name_hash  = _murmur3_x86_32(entries[0].file_name, sizeof(entries[0].file_name), 0);
+            entries[0].name_hash  = checksum_memory(opt.cs, entries[0].file_name, sizeof(entries[0].file_name), 0);
             entries[0].attributes = 0x10;
             entries[0].cluster    = i;
             entries[0].checksum   = 0;
-            entries[0].checksum   = _murmur3_x86_32((uint8_t*)&entries[0], sizeof(entries[0]), 0);
+            entries[0].checksum   = checksum_memory(opt.cs, (uint8_t*)&entries[0], sizeof(entries[0]), 0);
             fprintf(stdout, ". checksum: %u\n", entries[0].checksum);
 
             _to_83_name("..", (char*)entries[1].file_name);
-            entries[1].name_hash  = _murmur3_x86_32(entries[1].file_name, sizeof(entries[1].file_name), 0);
+            entries[1].name_hash  = checksum_memory(opt.cs, entries[1].file_name, sizeof(entries[1].file_name), 0);
             entries[1].attributes = 0x10;
             entries[1].cluster    = 0;
             entries[1].checksum   = 0;
-            entries[1].checksum   = _murmur3_x86_32((uint8_t*)&entries[1], sizeof(entries[1]), 0);
+            entries[1].checksum   = checksum_memory(opt.cs, (uint8_t*)&entries[1], sizeof(entries[1]), 0);
             fprintf(stdout, ".. checksum: %u\n", entries[1].checksum);
 
             entries[2].file_name[0] = ENTRY_END;
-            entries[2].name_hash  = _murmur3_x86_32(entries[2].file_name, sizeof(entries[2].file_name), 0);
+            entries[2].name_hash  = checksum_memory(opt.cs, entries[2].file_name, sizeof(entries[2].file_name), 0);
             entries[2].attributes = 0x10;
             entries[2].cluster    = 0;
             entries[2].checksum   = 0;
-            entries[2].checksum   = _murmur3_x86_32((uint8_t*)&entries[2], sizeof(entries[2]), 0);
+            entries[2].checksum   = checksum_memory(opt.cs, (uint8_t*)&entries[2], sizeof(entries[2]), 0);
             fprintf(stdout, "END checksum: %u\n", entries[1].checksum);
 
             encoded_t* root_dirs = (encoded_t*)malloc(sizeof(entries) * sizeof(encoded_t));
@@ -11,6 +11,7 @@
 #include <ctype.h>
 #include <stdint.h>
 #include "include/options.h"
+#include "../include/checksum.h"
 
 #define GET_BIT(b, i) ((b >> i) & 1)
 #define SET_BIT(n, i, v) (v ? (n | (1 << i)) : (n & ~(1 << i)))
@@ -83,6 +84,7 @@ typedef struct {
     unsigned int   total_sectors_32;
     nifat32_ext32_bootsector_t extended_section;
     unsigned int checksum;
+    unsigned char checksum_type;
 } __attribute__((packed)) nifat32_bootsector_t;
 
 /* from http://wiki.osdev.org/FAT */
@@ -1,4 +1,13 @@
 #include "../include/options.h"
+#include "../../include/checksum.h"
+
+static int _get_checksum_type(const char* name) {
+    if (!strcmp(name, "murmur3"))  return CHECKSUM_MURMUR3;
+    if (!strcmp(name, "crc32c"))   return CHECKSUM_CRC32C;
+    if (!strcmp(name, "xxhash32")) return CHECKSUM_XXHASH32;
+    if (!strcmp(name, "xxhash64")) return CHECKSUM_XXHASH64;
+    return -1;
+}
 
 int process_input(int argc, char* argv[], opt_t* opt) {
     for (int i = 1; i < argc; i++) {
@@ -51,6 +60,11 @@ int process_input(int argc, char* argv[], opt_t* opt) {
                 return 0;
             }
         }
+        else if (!strcmp(argv[i], CHECKSUM_OPT)) {
+            if (i + 1 < argc && (opt->cs = _get_checksum_type(argv[++i])) >= 0) continue;
+            fprintf(stderr, "Error: checksum (murmur3 / crc32c / xxhash32 / xxhash64) required after %s\n", CHECKSUM_OPT);
+            return 0;
+        }
     }
 
     return 1;
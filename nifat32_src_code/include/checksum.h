@@ -5,9 +5,61 @@ extern "C" {
 #endif
 
 typedef unsigned int checksum_t;
+
+// Checksum algorithms. Algorithm recorded in NIFAT32 bootsector and in DBMS headers.
+// Murmur3 is default algorithm, and it kept for compatibility with old images.
+// Note: Hardware CRC32C available only on x86 with SSE4.2 (Disable it with NO_CHECKSUM_SIMD flag).
+#define CHECKSUM_SELECTED   -1
+#define CHECKSUM_MURMUR3    0x00
+#define CHECKSUM_CRC32C     0x01
+#define CHECKSUM_XXHASH32   0x02
+#define CHECKSUM_XXHASH64   0x03
+#define CHECKSUM_COUNT      0x04
+
 checksum_t murmur3_x86_32(const unsigned char* key, unsigned int len, unsigned int seed);
 
+/*
+CRC32C (Castagnoli) checksum. Uses SSE4.2 crc32 instruction, if CPU supports it.
+
+Params:
+- key - Data for hashing.
+- len - Data size.
+- seed - Initial CRC value.
+
+Return checksum.
+*/
+checksum_t crc32c(const unsigned char* key, unsigned int len, unsigned int seed);
+
+checksum_t xxhash32(const unsigned char* key, unsigned int len, unsigned int seed);
+unsigned long long xxhash64(const unsigned char* key, unsigned int len, unsigned long long seed);
+
+/*
+Select algorithm for CHECKSUM_SELECTED checksums. NIFAT32 select algorithm from bootsector at init.
+
+Params:
+- algorithm - One of CHECKSUM_* algorithms.
+
+Return -1 if algorithm unknown.
+Return selected algorithm.
+*/
+int checksum_select(int algorithm);
+
+/*
+Hash data with provided algorithm.
+Note: xxHash64 folded to 32 bits.
+
+Params:
+- algorithm - One of CHECKSUM_* algorithms, or CHECKSUM_SELECTED for selected algorithm (Check checksum_select).
+              Unknown algorithm fall back to murmur3.
+- key - Data for hashing.
+- len - Data size.
+- seed - Seed.
+
+Return checksum.
+*/
+checksum_t checksum_memory(int algorithm, const unsigned char* key, unsigned int len, unsigned int seed);
+
 #ifdef __cplusplus
 }
 #endif
-#endif
\ No newline at end of file
+#endif
@@ -19,6 +19,7 @@ typedef struct {
     unsigned int  sectors_padd;
     unsigned char journals_count;
     unsigned char errors_count;
+    unsigned char checksum_type;
 } fat_data_t;
 
 #ifdef __cplusplus
@@ -12,6 +12,13 @@ typedef unsigned char byte_t;
 typedef unsigned short encoded_t;
 typedef unsigned short decoded_t;
 
+// Bulk codec paths for pack_memory / unpack_memory.
+// Note: SIMD paths available only on x86 (Disable them with NO_HAMMING_SIMD flag).
+#define HAMMING_PATH_AUTO   -1
+#define HAMMING_PATH_SCALAR 0
+#define HAMMING_PATH_SSE2   1
+#define HAMMING_PATH_AVX2   2
+
 /*
 Unpack memory function should decode src pointed data from hamming 15,11 (With error correction).
 P.S. Before usage, allocate dst memory with size, same as count of elements in src.
@@ -38,6 +45,18 @@ Return pointer to dst.
 */
 void* pack_memory(const byte_t* src, decoded_t* dst, int l);
 
+/*
+Select codec path for pack_memory and unpack_memory. By default path selected
+with runtime CPU check at first pack / unpack call. All paths have same output.
+
+Params:
+- path - HAMMING_PATH_AUTO for CPU check, or one of HAMMING_PATH_* paths.
+         If CPU don't support provided path, function will choose best supported.
+
+Return selected path.
+*/
+int hamming_select_path(int path);
+
 #ifdef __cplusplus
 }
 #endif
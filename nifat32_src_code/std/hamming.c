@@ -1,69 +1,334 @@
 #include <hamming.h>
 
+/*
+Hamming(15,11) is linear over GF(2), that's why encoding of 11 data bits equals XOR
+of encodings of it's low byte and high 3 bits. Same for decoding, where every table entry
+stores extracted data bits (0-10) and syndrome part (11-14) of one half of encoded word.
+Tables generated from bitwise reference codec (check test/old/test_hamming_benchmark.c).
+*/
+static const encoded_t _encode_low[256] = {
+    0x0000, 0x0007, 0x0019, 0x001E, 0x002A, 0x002D, 0x0033, 0x0034,
+    0x004B, 0x004C, 0x0052, 0x0055, 0x0061, 0x0066, 0x0078, 0x007F,
+    0x0181, 0x0186, 0x0198, 0x019F, 0x01AB, 0x01AC, 0x01B2, 0x01B5,
+    0x01CA, 0x01CD, 0x01D3, 0x01D4, 0x01E0, 0x01E7, 0x01F9, 0x01FE,
+    0x0282, 0x0285, 0x029B, 0x029C, 0x02A8, 0x02AF, 0x02B1, 0x02B6,
+    0x02C9, 0x02CE, 0x02D0, 0x02D7, 0x02E3, 0x02E4, 0x02FA, 0x02FD,
+    0x0303, 0x0304, 0x031A, 0x031D, 0x0329, 0x032E, 0x0330, 0x0337,
+    0x0348, 0x034F, 0x0351, 0x0356, 0x0362, 0x0365, 0x037B, 0x037C,
+    0x0483, 0x0484, 0x049A, 0x049D, 0x04A9, 0x04AE, 0x04B0, 0x04B7,
+    0x04C8, 0x04CF, 0x04D1, 0x04D6, 0x04E2, 0x04E5, 0x04FB, 0x04FC,
+    0x0502, 0x0505, 0x051B, 0x051C, 0x0528, 0x052F, 0x0531, 0x0536,
+    0x0549, 0x054E, 0x0550, 0x0557, 0x0563, 0x0564, 0x057A, 0x057D,
+    0x0601, 0x0606, 0x0618, 0x061F, 0x062B, 0x062C, 0x0632, 0x0635,
+    0x064A, 0x064D, 0x0653, 0x0654, 0x0660, 0x0667, 0x0679, 0x067E,
+    0x0780, 0x0787, 0x0799, 0x079E, 0x07AA, 0x07AD, 0x07B3, 0x07B4,
+    0x07CB, 0x07CC, 0x07D2, 0x07D5, 0x07E1, 0x07E6, 0x07F8, 0x07FF,
+    0x0888, 0x088F, 0x0891, 0x0896, 0x08A2, 0x08A5, 0x08BB, 0x08BC,
+    0x08C3, 0x08C4, 0x08DA, 0x08DD, 0x08E9, 0x08EE, 0x08F0, 0x08F7,
+    0x0909, 0x090E, 0x0910, 0x0917, 0x0923, 0x0924, 0x093A, 0x093D,
+    0x0942, 0x0945, 0x095B, 0x095C, 0x0968, 0x096F, 0x0971, 0x0976,
+    0x0A0A, 0x0A0D, 0x0A13, 0x0A14, 0x0A20, 0x0A27, 0x0A39, 0x0A3E,
+    0x0A41, 0x0A46, 0x0A58, 0x0A5F, 0x0A6B, 0x0A6C, 0x0A72, 0x0A75,
+    0x0B8B, 0x0B8C, 0x0B92, 0x0B95, 0x0BA1, 0x0BA6, 0x0BB8, 0x0BBF,
+    0x0BC0, 0x0BC7, 0x0BD9, 0x0BDE, 0x0BEA, 0x0BED, 0x0BF3, 0x0BF4,
+    0x0C0B, 0x0C0C, 0x0C12, 0x0C15, 0x0C21, 0x0C26, 0x0C38, 0x0C3F,
+    0x0C40, 0x0C47, 0x0C59, 0x0C5E, 0x0C6A, 0x0C6D, 0x0C73, 0x0C74,
+    0x0D8A, 0x0D8D, 0x0D93, 0x0D94, 0x0DA0, 0x0DA7, 0x0DB9, 0x0DBE,
+    0x0DC1, 0x0DC6, 0x0DD8, 0x0DDF, 0x0DEB, 0x0DEC, 0x0DF2, 0x0DF5,
+    0x0E89, 0x0E8E, 0x0E90, 0x0E97, 0x0EA3, 0x0EA4, 0x0EBA, 0x0EBD,
+    0x0EC2, 0x0EC5, 0x0EDB, 0x0EDC, 0x0EE8, 0x0EEF, 0x0EF1, 0x0EF6,
+    0x0F08, 0x0F0F, 0x0F11, 0x0F16, 0x0F22, 0x0F25, 0x0F3B, 0x0F3C,
+    0x0F43, 0x0F44, 0x0F5A, 0x0F5D, 0x0F69, 0x0F6E, 0x0F70, 0x0F77
+};
+
+static const encoded_t _encode_high[8] = {
+    0x0000, 0x1089, 0x208A, 0x3003, 0x408B, 0x5002, 0x6001, 0x7088
+};
+
+static const decoded_t _decode_low[256] = {
+    0x0000, 0x0800, 0x1000, 0x1800, 0x1801, 0x1001, 0x0801, 0x0001,
+    0x2000, 0x2800, 0x3000, 0x3800, 0x3801, 0x3001, 0x2801, 0x2001,
+    0x2802, 0x2002, 0x3802, 0x3002, 0x3003, 0x3803, 0x2003, 0x2803,
+    0x0802, 0x0002, 0x1802, 0x1002, 0x1003, 0x1803, 0x0003, 0x0803,
+    0x3004, 0x3804, 0x2004, 0x2804, 0x2805, 0x2005, 0x3805, 0x3005,
+    0x1004, 0x1804, 0x0004, 0x0804, 0x0805, 0x0005, 0x1805, 0x1005,
+    0x1806, 0x1006, 0x0806, 0x0006, 0x0007, 0x0807, 0x1007, 0x1807,
+    0x3806, 0x3006, 0x2806, 0x2006, 0x2007, 0x2807, 0x3007, 0x3807,
+    0x3808, 0x3008, 0x2808, 0x2008, 0x2009, 0x2809, 0x3009, 0x3809,
+    0x1808, 0x1008, 0x0808, 0x0008, 0x0009, 0x0809, 0x1009, 0x1809,
+    0x100A, 0x180A, 0x000A, 0x080A, 0x080B, 0x000B, 0x180B, 0x100B,
+    0x300A, 0x380A, 0x200A, 0x280A, 0x280B, 0x200B, 0x380B, 0x300B,
+    0x080C, 0x000C, 0x180C, 0x100C, 0x100D, 0x180D, 0x000D, 0x080D,
+    0x280C, 0x200C, 0x380C, 0x300C, 0x300D, 0x380D, 0x200D, 0x280D,
+    0x200E, 0x280E, 0x300E, 0x380E, 0x380F, 0x300F, 0x280F, 0x200F,
+    0x000E, 0x080E, 0x100E, 0x180E, 0x180F, 0x100F, 0x080F, 0x000F,
+    0x4000, 0x4800, 0x5000, 0x5800, 0x5801, 0x5001, 0x4801, 0x4001,
+    0x6000, 0x6800, 0x7000, 0x7800, 0x7801, 0x7001, 0x6801, 0x6001,
+    0x6802, 0x6002, 0x7802, 0x7002, 0x7003, 0x7803, 0x6003, 0x6803,
+    0x4802, 0x4002, 0x5802, 0x5002, 0x5003, 0x5803, 0x4003, 0x4803,
+    0x7004, 0x7804, 0x6004, 0x6804, 0x6805, 0x6005, 0x7805, 0x7005,
+    0x5004, 0x5804, 0x4004, 0x4804, 0x4805, 0x4005, 0x5805, 0x5005,
+    0x5806, 0x5006, 0x4806, 0x4006, 0x4007, 0x4807, 0x5007, 0x5807,
+    0x7806, 0x7006, 0x6806, 0x6006, 0x6007, 0x6807, 0x7007, 0x7807,
+    0x7808, 0x7008, 0x6808, 0x6008, 0x6009, 0x6809, 0x7009, 0x7809,
+    0x5808, 0x5008, 0x4808, 0x4008, 0x4009, 0x4809, 0x5009, 0x5809,
+    0x500A, 0x580A, 0x400A, 0x480A, 0x480B, 0x400B, 0x580B, 0x500B,
+    0x700A, 0x780A, 0x600A, 0x680A, 0x680B, 0x600B, 0x780B, 0x700B,
+    0x480C, 0x400C, 0x580C, 0x500C, 0x500D, 0x580D, 0x400D, 0x480D,
+    0x680C, 0x600C, 0x780C, 0x700C, 0x700D, 0x780D, 0x600D, 0x680D,
+    0x600E, 0x680E, 0x700E, 0x780E, 0x780F, 0x700F, 0x680F, 0x600F,
+    0x400E, 0x480E, 0x500E, 0x580E, 0x580F, 0x500F, 0x480F, 0x400F
+};
+
+static const decoded_t _decode_high[128] = {
+    0x0000, 0x4810, 0x5020, 0x1830, 0x5840, 0x1050, 0x0860, 0x4070,
+    0x6080, 0x2890, 0x30A0, 0x78B0, 0x38C0, 0x70D0, 0x68E0, 0x20F0,
+    0x6900, 0x2110, 0x3920, 0x7130, 0x3140, 0x7950, 0x6160, 0x2970,
+    0x0980, 0x4190, 0x59A0, 0x11B0, 0x51C0, 0x19D0, 0x01E0, 0x49F0,
+    0x7200, 0x3A10, 0x2220, 0x6A30, 0x2A40, 0x6250, 0x7A60, 0x3270,
+    0x1280, 0x5A90, 0x42A0, 0x0AB0, 0x4AC0, 0x02D0, 0x1AE0, 0x52F0,
+    0x1B00, 0x5310, 0x4B20, 0x0330, 0x4340, 0x0B50, 0x1360, 0x5B70,
+    0x7B80, 0x3390, 0x2BA0, 0x63B0, 0x23C0, 0x6BD0, 0x73E0, 0x3BF0,
+    0x7C00, 0x3410, 0x2C20, 0x6430, 0x2440, 0x6C50, 0x7460, 0x3C70,
+    0x1C80, 0x5490, 0x4CA0, 0x04B0, 0x44C0, 0x0CD0, 0x14E0, 0x5CF0,
+    0x1500, 0x5D10, 0x4520, 0x0D30, 0x4D40, 0x0550, 0x1D60, 0x5570,
+    0x7580, 0x3D90, 0x25A0, 0x6DB0, 0x2DC0, 0x65D0, 0x7DE0, 0x35F0,
+    0x0E00, 0x4610, 0x5E20, 0x1630, 0x5640, 0x1E50, 0x0660, 0x4E70,
+    0x6E80, 0x2690, 0x3EA0, 0x76B0, 0x36C0, 0x7ED0, 0x66E0, 0x2EF0,
+    0x6700, 0x2F10, 0x3720, 0x7F30, 0x3F40, 0x7750, 0x6F60, 0x2770,
+    0x0780, 0x4F90, 0x57A0, 0x1FB0, 0x5FC0, 0x17D0, 0x0FE0, 0x47F0
+};
+
+static const decoded_t _correction[16] = {
+    0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0002, 0x0004, 0x0008,
+    0x0000, 0x0010, 0x0020, 0x0040, 0x0080, 0x0100, 0x0200, 0x0400
+};
+
+#define DECODE_DATA_MASK    0x07FF
+#define DECODE_SYNDROME(x)  ((x) >> 11)
+
+#if !defined(NO_HAMMING_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define HAMMING_X86_SIMD
+    #include <cpuid.h>
+    #include <immintrin.h>
+#endif
+
 static encoded_t _encode_hamming_15_11(decoded_t data) {
-    encoded_t encoded = 0;
-    encoded = SET_BIT(encoded, 2, GET_BIT(data, 0));
-    encoded = SET_BIT(encoded, 4, GET_BIT(data, 1));
-    encoded = SET_BIT(encoded, 5, GET_BIT(data, 2));
-    encoded = SET_BIT(encoded, 6, GET_BIT(data, 3));
-    encoded = SET_BIT(encoded, 8, GET_BIT(data, 4));
-    encoded = SET_BIT(encoded, 9, GET_BIT(data, 5));
-    encoded = SET_BIT(encoded, 10, GET_BIT(data, 6));
-    encoded = SET_BIT(encoded, 11, GET_BIT(data, 7));
-    encoded = SET_BIT(encoded, 12, GET_BIT(data, 8));
-    encoded = SET_BIT(encoded, 13, GET_BIT(data, 9));
-    encoded = SET_BIT(encoded, 14, GET_BIT(data, 10));
-
-    byte_t p1 = GET_BIT(encoded, 2) ^ GET_BIT(encoded, 4) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 8) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 14);
-    byte_t p2 = GET_BIT(encoded, 2) ^ GET_BIT(encoded, 5) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 9) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
-    byte_t p4 = GET_BIT(encoded, 4) ^ GET_BIT(encoded, 5) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 11) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
-    byte_t p8 = GET_BIT(encoded, 8) ^ GET_BIT(encoded, 9) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 11) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
-
-    encoded = SET_BIT(encoded, 0, p1);
-    encoded = SET_BIT(encoded, 1, p2);
-    encoded = SET_BIT(encoded, 3, p4);
-    encoded = SET_BIT(encoded, 7, p8);
-    return encoded;
+    return _encode_low[data & 0xFF] ^ _encode_high[(data >> 8) & 0x07];
 }
 
 static decoded_t _decode_hamming_15_11(encoded_t encoded) {
-    byte_t s1 = GET_BIT(encoded, 0) ^ GET_BIT(encoded, 2) ^ GET_BIT(encoded, 4) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 8) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 14);
-    byte_t s2 = GET_BIT(encoded, 1) ^ GET_BIT(encoded, 2) ^ GET_BIT(encoded, 5) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 9) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
-    byte_t s4 = GET_BIT(encoded, 3) ^ GET_BIT(encoded, 4) ^ GET_BIT(encoded, 5) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 11) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
-    byte_t s8 = GET_BIT(encoded, 7) ^ GET_BIT(encoded, 8) ^ GET_BIT(encoded, 9) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 11) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
-    byte_t error_pos = s1 + (s2 << 1) + (s4 << 2) + (s8 << 3);
-    if (error_pos) encoded = TOGGLE_BIT(encoded, (error_pos - 1));
-    
-    decoded_t data = 0;
-    data = SET_BIT(data, 0, GET_BIT(encoded, 2));
-    data = SET_BIT(data, 1, GET_BIT(encoded, 4));
-    data = SET_BIT(data, 2, GET_BIT(encoded, 5));
-    data = SET_BIT(data, 3, GET_BIT(encoded, 6));
-    data = SET_BIT(data, 4, GET_BIT(encoded, 8));
-    data = SET_BIT(data, 5, GET_BIT(encoded, 9));
-    data = SET_BIT(data, 6, GET_BIT(encoded, 10));
-    data = SET_BIT(data, 7, GET_BIT(encoded, 11));
-    data = SET_BIT(data, 8, GET_BIT(encoded, 12));
-    data = SET_BIT(data, 9, GET_BIT(encoded, 13));
-    data = SET_BIT(data, 10, GET_BIT(encoded, 14));
-    return data;
-}
-
-static byte_t _get_byte(const decoded_t* ptr, int offset) {
-    return (byte_t)_decode_hamming_15_11(ptr[offset]);
-}
-
-static int _set_byte(encoded_t* ptr, int offset, byte_t byte) {
-    ptr[offset] = _encode_hamming_15_11((encoded_t)byte);
-    return 1;
+    decoded_t x = _decode_low[encoded & 0xFF] ^ _decode_high[(encoded >> 8) & 0x7F];
+    return (x & DECODE_DATA_MASK) ^ _correction[DECODE_SYNDROME(x)];
+}
+
+static void _pack_scalar(const byte_t* src, encoded_t* dst, int l) {
+    for (int i = 0; i < l; i++) dst[i] = _encode_hamming_15_11((decoded_t)src[i]);
+}
+
+static void _unpack_scalar(const encoded_t* src, byte_t* dst, int l) {
+    for (int i = 0; i < l; i++) dst[i] = (byte_t)_decode_hamming_15_11(src[i]);
+}
+
+#ifdef HAMMING_X86_SIMD
+
+/*
+SIMD kernels work with 16-bit lanes, where every lane is one encoded word.
+SSE2 decoder check syndrome of every lane with parity folding and extract data bits (2, 4-6, 8-11)
+with shifts. Encoding with SSE2 bit arithmetic slower than tables, that's why SSE2 path packs with tables.
+AVX2 encoder use nibble tables with vpshufb: low nibble gives low byte of word, high nibble gives
+low byte part and whole high byte (High byte equals high nibble). AVX2 decoder extract data, encode
+it back and compare with source words. If any word in block is not valid codeword, we pass this
+block to scalar decoder with correction.
+*/
+#define SYNDROME_MASK_1 0x5555
+#define SYNDROME_MASK_2 0x6666
+#define SYNDROME_MASK_4 0x7878
+#define SYNDROME_MASK_8 0x7F80
+
+#define SSE2_PARITY(x) ({                          \
+    __m128i _p = (x);                              \
+    _p = _mm_xor_si128(_p, _mm_srli_epi16(_p, 8)); \
+    _p = _mm_xor_si128(_p, _mm_srli_epi16(_p, 4)); \
+    _p = _mm_xor_si128(_p, _mm_srli_epi16(_p, 2)); \
+    _p = _mm_xor_si128(_p, _mm_srli_epi16(_p, 1)); \
+    _mm_and_si128(_p, _mm_set1_epi16(1));          \
+})
+
+static const byte_t _nibble_low[16] = {
+    0x00, 0x07, 0x19, 0x1E, 0x2A, 0x2D, 0x33, 0x34, 0x4B, 0x4C, 0x52, 0x55, 0x61, 0x66, 0x78, 0x7F
+};
+
+static const byte_t _nibble_high[16] = {
+    0x00, 0x81, 0x82, 0x03, 0x83, 0x02, 0x01, 0x80, 0x88, 0x09, 0x0A, 0x8B, 0x0B, 0x8A, 0x89, 0x08
+};
+
+__attribute__((target("sse2")))
+static inline int _sse2_is_clean(__m128i w) {
+    __m128i s = _mm_or_si128(
+        _mm_or_si128(
+            SSE2_PARITY(_mm_and_si128(w, _mm_set1_epi16(SYNDROME_MASK_1))),
+            SSE2_PARITY(_mm_and_si128(w, _mm_set1_epi16(SYNDROME_MASK_2)))
+        ),
+        _mm_or_si128(
+            SSE2_PARITY(_mm_and_si128(w, _mm_set1_epi16(SYNDROME_MASK_4))),
+            SSE2_PARITY(_mm_and_si128(w, _mm_set1_epi16(SYNDROME_MASK_8)))
+        )
+    );
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi16(s, _mm_setzero_si128())) == 0xFFFF;
+}
+
+__attribute__((target("sse2")))
+static inline __m128i _sse2_extract(__m128i w) {
+    return _mm_or_si128(
+        _mm_and_si128(_mm_srli_epi16(w, 2), _mm_set1_epi16(0x01)),
+        _mm_or_si128(
+            _mm_and_si128(_mm_srli_epi16(w, 3), _mm_set1_epi16(0x0E)),
+            _mm_and_si128(_mm_srli_epi16(w, 4), _mm_set1_epi16(0xF0))
+        )
+    );
+}
+
+__attribute__((target("sse2")))
+static int _unpack_sse2(const encoded_t* src, byte_t* dst, int l) {
+    int i = 0;
+    for (; i + 16 <= l; i += 16) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 8));
+        if (!_sse2_is_clean(lo) || !_sse2_is_clean(hi)) {
+            _unpack_scalar(src + i, dst + i, 16);
+            continue;
+        }
+
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_sse2_extract(lo), _sse2_extract(hi)));
+    }
+
+    return i;
+}
+
+/*
+Encode 32 bytes to 32 words.
+Note: Words placed in output vectors in source order.
+*/
+__attribute__((target("avx2")))
+static inline void _avx2_encode(__m256i b, __m256i* first, __m256i* second) {
+    __m256i low_table  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)_nibble_low));
+    __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)_nibble_high));
+    __m256i low  = _mm256_and_si256(b, _mm256_set1_epi8(0x0F));
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(b, 4), _mm256_set1_epi8(0x0F));
+
+    __m256i words_low  = _mm256_xor_si256(_mm256_shuffle_epi8(low_table, low), _mm256_shuffle_epi8(high_table, high));
+    __m256i first_half = _mm256_unpacklo_epi8(words_low, high);
+    __m256i last_half  = _mm256_unpackhi_epi8(words_low, high);
+    *first  = _mm256_permute2x128_si256(first_half, last_half, 0x20);
+    *second = _mm256_permute2x128_si256(first_half, last_half, 0x31);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i _avx2_extract(__m256i w) {
+    return _mm256_or_si256(
+        _mm256_and_si256(_mm256_srli_epi16(w, 2), _mm256_set1_epi16(0x01)),
+        _mm256_or_si256(
+            _mm256_and_si256(_mm256_srli_epi16(w, 3), _mm256_set1_epi16(0x0E)),
+            _mm256_and_si256(_mm256_srli_epi16(w, 4), _mm256_set1_epi16(0xF0))
+        )
+    );
+}
+
+__attribute__((target("avx2")))
+static int _pack_avx2(const byte_t* src, encoded_t* dst, int l) {
+    int i = 0;
+    for (; i + 32 <= l; i += 32) {
+        __m256i first, second;
+        _avx2_encode(_mm256_loadu_si256((const __m256i*)(src + i)), &first, &second);
+        _mm256_storeu_si256((__m256i*)(dst + i), first);
+        _mm256_storeu_si256((__m256i*)(dst + i + 16), second);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+static int _unpack_avx2(const encoded_t* src, byte_t* dst, int l) {
+    int i = 0;
+    for (; i + 32 <= l; i += 32) {
+        __m256i first  = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i second = _mm256_loadu_si256((const __m256i*)(src + i + 16));
+
+        // packus works inside 128-bit lanes, that's why we restore order with permute.
+        __m256i b = _mm256_permute4x64_epi64(
+            _mm256_packus_epi16(_avx2_extract(first), _avx2_extract(second)), 0xD8
+        );
+
+        __m256i check_first, check_second;
+        _avx2_encode(b, &check_first, &check_second);
+        __m256i diff = _mm256_or_si256(_mm256_xor_si256(first, check_first), _mm256_xor_si256(second, check_second));
+        if (!_mm256_testz_si256(diff, diff)) {
+            _unpack_scalar(src + i, dst + i, 32);
+            continue;
+        }
+
+        _mm256_storeu_si256((__m256i*)(dst + i), b);
+    }
+
+    return i;
+}
+
+static int _detect_path() {
+    unsigned int a = 0, b = 0, c = 0, d = 0;
+    if (!__get_cpuid(1, &a, &b, &c, &d)) return HAMMING_PATH_SCALAR;
+
+    int path = (d & bit_SSE2) ? HAMMING_PATH_SSE2 : HAMMING_PATH_SCALAR;
+    if ((c & bit_OSXSAVE) && (c & bit_AVX)) {
+        unsigned int xcr0_lo = 0, xcr0_hi = 0;
+        __asm__ volatile ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        if ((xcr0_lo & 0x06) == 0x06 && __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & bit_AVX2)) {
+            path = HAMMING_PATH_AVX2;
+        }
+    }
+
+    return path;
+}
+
+#else
+
+static int _detect_path() {
+    return HAMMING_PATH_SCALAR;
+}
+
+#endif
+
+static int _path = HAMMING_PATH_AUTO;
+
+int hamming_select_path(int path) {
+    int supported = _detect_path();
+    if (path == HAMMING_PATH_AUTO || path > supported) path = supported;
+    _path = path;
+    return _path;
 }
 
 void* unpack_memory(const encoded_t* src, byte_t* dst, int l) {
-    for (int i = 0; i < l; i++) dst[i] = _get_byte(src, i);
+    if (_path == HAMMING_PATH_AUTO) hamming_select_path(HAMMING_PATH_AUTO);
+
+    int processed = 0;
+#ifdef HAMMING_X86_SIMD
+    if (_path == HAMMING_PATH_AVX2) processed = _unpack_avx2(src, dst, l);
+    else if (_path == HAMMING_PATH_SSE2) processed = _unpack_sse2(src, dst, l);
+#endif
+
+    _unpack_scalar(src + processed, dst + processed, l - processed);
     return (void*)dst;
 }
 
 void* pack_memory(const byte_t* src, encoded_t* dst, int l) {
-    for (int i = 0; i < l; i++) _set_byte(dst, i, src[i]);
+    if (_path == HAMMING_PATH_AUTO) hamming_select_path(HAMMING_PATH_AUTO);
+
+    int processed = 0;
+#ifdef HAMMING_X86_SIMD
+    if (_path == HAMMING_PATH_AVX2) processed = _pack_avx2(src, dst, l);
+#endif
+
+    _pack_scalar(src + processed, dst + processed, l - processed);
     return (void*)dst;
 }
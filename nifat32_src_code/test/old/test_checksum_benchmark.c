@@ -0,0 +1,109 @@
+#include "nifat32_test.h"
+#include "../../include/checksum.h"
+
+#define BENCHMARK_PAGE_SIZE 8192
+
+/*
+Reference bitwise CRC32C. Table-driven and SSE4.2 paths should give same output.
+*/
+static checksum_t _reference_crc32c(const unsigned char* key, unsigned int len, unsigned int seed) {
+    checksum_t crc = ~seed;
+    for (unsigned int i = 0; i < len; i++) {
+        crc ^= key[i];
+        for (int b = 0; b < 8; b++) crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    }
+
+    return ~crc;
+}
+
+static const char* _algorithm_name(int algorithm) {
+    switch (algorithm) {
+        case CHECKSUM_CRC32C:   return "crc32c";
+        case CHECKSUM_XXHASH32: return "xxhash32";
+        case CHECKSUM_XXHASH64: return "xxhash64";
+        default: return "murmur3";
+    }
+}
+
+/*
+Check known vectors and compare CRC32C with reference on every length and alignment.
+*/
+static int _check_algorithms() {
+    const unsigned char* fox = (const unsigned char*)"The quick brown fox jumps over the lazy dog";
+    if (crc32c((const unsigned char*)"123456789", 9, 0) != 0xE3069283) {
+        fprintf(stderr, "ERROR! crc32c check value mismatch\n");
+        return 0;
+    }
+
+    if (xxhash32(fox, 43, 0) != 0xE85EA4DE || xxhash64(fox, 43, 0) != 0x0B242D361FDA71BCULL) {
+        fprintf(stderr, "ERROR! xxhash check value mismatch\n");
+        return 0;
+    }
+
+    static unsigned char buffer[BENCHMARK_PAGE_SIZE + 8];
+    for (int i = 0; i < BENCHMARK_PAGE_SIZE + 8; i++) buffer[i] = (unsigned char)(i * 31 + (i >> 7));
+    for (int offset = 0; offset < 8; offset++) {
+        for (unsigned int len = 0; len < 300; len++) {
+            if (crc32c(buffer + offset, len, 0) != _reference_crc32c(buffer + offset, len, 0)) {
+                fprintf(stderr, "ERROR! crc32c mismatch [offset=%i, len=%u]\n", offset, len);
+                return 0;
+            }
+        }
+    }
+
+    if (crc32c(buffer + 3, BENCHMARK_PAGE_SIZE, 0) != _reference_crc32c(buffer + 3, BENCHMARK_PAGE_SIZE, 0)) {
+        fprintf(stderr, "ERROR! crc32c page mismatch\n");
+        return 0;
+    }
+
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Test count requiered!\nUsage:%s <count>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!_check_algorithms()) return EXIT_FAILURE;
+
+    int count = atoi(argv[1]);
+    static unsigned char data[BENCHMARK_PAGE_SIZE];
+    for (int i = 0; i < BENCHMARK_PAGE_SIZE; i++) data[i] = (unsigned char)(i % 2 ? ' ' : 'A' + i % 26);
+
+    /* Typical NIFAT32 / CDBMS checksum inputs */
+    struct {
+        const char*  name;
+        unsigned int size;
+    } sizes[] = {
+        { "name",       11                                },
+        { "entry",      sizeof(directory_entry_t)         },
+        { "bootsector", sizeof(nifat32_bootsector_t)      },
+        { "page",       BENCHMARK_PAGE_SIZE               }
+    };
+
+    fprintf(stdout, "\n==== Checksum throughput (x %i) ====\n", count);
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int iterations = count * (BENCHMARK_PAGE_SIZE / sizes[s].size);
+        fprintf(stdout, "[%s, %u bytes]\n", sizes[s].name, sizes[s].size);
+
+        long reference = 0;
+        for (int algorithm = CHECKSUM_MURMUR3; algorithm < CHECKSUM_COUNT; algorithm++) {
+            volatile checksum_t sink = 0;
+            long time = MEASURE_TIME_US({
+                for (int n = 0; n < iterations; n++) sink ^= checksum_memory(algorithm, data, sizes[s].size, n);
+            });
+
+            (void)sink;
+            if (algorithm == CHECKSUM_MURMUR3) reference = time;
+            fprintf(
+                stdout, "\t%-8s: %.2f MB/s (x%.1f)\n", _algorithm_name(algorithm),
+                time > 0 ? ((double)iterations * sizes[s].size) / (double)time : 0,
+                time > 0 ? reference / (double)time : 0
+            );
+        }
+    }
+
+    fprintf(stdout, "=============================\n\n\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+#include "nifat32_test.h"
+#include "../../include/hamming.h"
+
+#define BENCHMARK_BUFFER_SIZE 4096
+
+/*
+Reference bitwise codec. Table-driven and SIMD paths should give same output.
+*/
+static encoded_t _reference_encode(decoded_t data) {
+    encoded_t encoded = 0;
+    encoded = SET_BIT(encoded, 2, GET_BIT(data, 0));
+    encoded = SET_BIT(encoded, 4, GET_BIT(data, 1));
+    encoded = SET_BIT(encoded, 5, GET_BIT(data, 2));
+    encoded = SET_BIT(encoded, 6, GET_BIT(data, 3));
+    encoded = SET_BIT(encoded, 8, GET_BIT(data, 4));
+    encoded = SET_BIT(encoded, 9, GET_BIT(data, 5));
+    encoded = SET_BIT(encoded, 10, GET_BIT(data, 6));
+    encoded = SET_BIT(encoded, 11, GET_BIT(data, 7));
+    encoded = SET_BIT(encoded, 12, GET_BIT(data, 8));
+    encoded = SET_BIT(encoded, 13, GET_BIT(data, 9));
+    encoded = SET_BIT(encoded, 14, GET_BIT(data, 10));
+
+    byte_t p1 = GET_BIT(encoded, 2) ^ GET_BIT(encoded, 4) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 8) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 14);
+    byte_t p2 = GET_BIT(encoded, 2) ^ GET_BIT(encoded, 5) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 9) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
+    byte_t p4 = GET_BIT(encoded, 4) ^ GET_BIT(encoded, 5) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 11) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
+    byte_t p8 = GET_BIT(encoded, 8) ^ GET_BIT(encoded, 9) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 11) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
+
+    encoded = SET_BIT(encoded, 0, p1);
+    encoded = SET_BIT(encoded, 1, p2);
+    encoded = SET_BIT(encoded, 3, p4);
+    encoded = SET_BIT(encoded, 7, p8);
+    return encoded;
+}
+
+static decoded_t _reference_decode(encoded_t encoded) {
+    byte_t s1 = GET_BIT(encoded, 0) ^ GET_BIT(encoded, 2) ^ GET_BIT(encoded, 4) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 8) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 14);
+    byte_t s2 = GET_BIT(encoded, 1) ^ GET_BIT(encoded, 2) ^ GET_BIT(encoded, 5) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 9) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
+    byte_t s4 = GET_BIT(encoded, 3) ^ GET_BIT(encoded, 4) ^ GET_BIT(encoded, 5) ^ GET_BIT(encoded, 6) ^ GET_BIT(encoded, 11) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
+    byte_t s8 = GET_BIT(encoded, 7) ^ GET_BIT(encoded, 8) ^ GET_BIT(encoded, 9) ^ GET_BIT(encoded, 10) ^ GET_BIT(encoded, 11) ^ GET_BIT(encoded, 12) ^ GET_BIT(encoded, 13) ^ GET_BIT(encoded, 14);
+    byte_t error_pos = s1 + (s2 << 1) + (s4 << 2) + (s8 << 3);
+    if (error_pos) encoded = TOGGLE_BIT(encoded, (error_pos - 1));
+
+    decoded_t data = 0;
+    data = SET_BIT(data, 0, GET_BIT(encoded, 2));
+    data = SET_BIT(data, 1, GET_BIT(encoded, 4));
+    data = SET_BIT(data, 2, GET_BIT(encoded, 5));
+    data = SET_BIT(data, 3, GET_BIT(encoded, 6));
+    data = SET_BIT(data, 4, GET_BIT(encoded, 8));
+    data = SET_BIT(data, 5, GET_BIT(encoded, 9));
+    data = SET_BIT(data, 6, GET_BIT(encoded, 10));
+    data = SET_BIT(data, 7, GET_BIT(encoded, 11));
+    data = SET_BIT(data, 8, GET_BIT(encoded, 12));
+    data = SET_BIT(data, 9, GET_BIT(encoded, 13));
+    data = SET_BIT(data, 10, GET_BIT(encoded, 14));
+    return data;
+}
+
+static double _throughput(int count, long time) {
+    if (time <= 0) return 0;
+    return ((double)count * BENCHMARK_BUFFER_SIZE) / (double)time;
+}
+
+static const char* _path_name(int path) {
+    switch (path) {
+        case HAMMING_PATH_AVX2: return "avx2";
+        case HAMMING_PATH_SSE2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+/*
+Compare selected path with reference codec. We check all bytes, all single bit flips
+and all 2^16 words (Double flips and garbage) in non-aligned buffers.
+*/
+static int _check_path(int path) {
+    static byte_t src[BENCHMARK_BUFFER_SIZE + 1];
+    static byte_t dst[BENCHMARK_BUFFER_SIZE + 1];
+    static encoded_t encoded[BENCHMARK_BUFFER_SIZE + 1];
+
+    for (int i = 0; i < BENCHMARK_BUFFER_SIZE + 1; i++) src[i] = (byte_t)(i * 7 + (i >> 8));
+    pack_memory(src + 1, encoded + 1, BENCHMARK_BUFFER_SIZE);
+    for (int i = 1; i < BENCHMARK_BUFFER_SIZE + 1; i++) {
+        if (encoded[i] != _reference_encode(src[i])) {
+            fprintf(stderr, "ERROR! [%s] pack_memory mismatch at %i\n", _path_name(path), i);
+            return 0;
+        }
+    }
+
+    for (int bit = 0; bit < 16; bit++) {
+        for (int i = 1; i < BENCHMARK_BUFFER_SIZE + 1; i++) {
+            if (!((i + bit) % 5)) encoded[i] = TOGGLE_BIT(encoded[i], bit);
+        }
+
+        unpack_memory(encoded + 1, dst + 1, BENCHMARK_BUFFER_SIZE);
+        pack_memory(src + 1, encoded + 1, BENCHMARK_BUFFER_SIZE);
+        if (memcmp(src + 1, dst + 1, BENCHMARK_BUFFER_SIZE)) {
+            fprintf(stderr, "ERROR! [%s] unpack_memory can't correct bit %i\n", _path_name(path), bit);
+            return 0;
+        }
+    }
+
+    for (int base = 0; base < 0x10000; base += BENCHMARK_BUFFER_SIZE) {
+        for (int i = 0; i < BENCHMARK_BUFFER_SIZE; i++) encoded[i + 1] = (encoded_t)(base + i);
+        unpack_memory(encoded + 1, dst + 1, BENCHMARK_BUFFER_SIZE);
+        for (int i = 0; i < BENCHMARK_BUFFER_SIZE; i++) {
+            if (dst[i + 1] != (byte_t)_reference_decode((encoded_t)(base + i))) {
+                fprintf(stderr, "ERROR! [%s] unpack_memory mismatch for word 0x%x\n", _path_name(path), base + i);
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Test count requiered!\nUsage:%s <count>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int count = atoi(argv[1]);
+    static byte_t src[BENCHMARK_BUFFER_SIZE];
+    static byte_t dst[BENCHMARK_BUFFER_SIZE];
+    static encoded_t encoded[BENCHMARK_BUFFER_SIZE];
+    for (int i = 0; i < BENCHMARK_BUFFER_SIZE; i++) src[i] = (byte_t)(i % 2 ? ' ' : 'A' + i % 26);
+
+    /* Reference bitwise codec */
+    long reference_pack = MEASURE_TIME_US({
+        for (int n = 0; n < count; n++) {
+            for (int i = 0; i < BENCHMARK_BUFFER_SIZE; i++) encoded[i] = _reference_encode(src[i]);
+        }
+    });
+
+    long reference_unpack = MEASURE_TIME_US({
+        for (int n = 0; n < count; n++) {
+            for (int i = 0; i < BENCHMARK_BUFFER_SIZE; i++) dst[i] = (byte_t)_reference_decode(encoded[i]);
+        }
+    });
+
+    fprintf(stdout, "\n==== Hamming(15,11) throughput (%i bytes x %i) ====\n", BENCHMARK_BUFFER_SIZE, count);
+    fprintf(
+        stdout, "[reference] pack: %.2f MB/s\tunpack: %.2f MB/s\n", 
+        _throughput(count, reference_pack), _throughput(count, reference_unpack)
+    );
+
+    int paths[] = { HAMMING_PATH_SCALAR, HAMMING_PATH_SSE2, HAMMING_PATH_AVX2 };
+    for (int p = 0; p < (int)(sizeof(paths) / sizeof(paths[0])); p++) {
+        if (hamming_select_path(paths[p]) != paths[p]) {
+            fprintf(stdout, "[%s] not supported by CPU, skip\n", _path_name(paths[p]));
+            continue;
+        }
+
+        if (!_check_path(paths[p])) return EXIT_FAILURE;
+
+        long pack = MEASURE_TIME_US({
+            for (int n = 0; n < count; n++) pack_memory(src, encoded, BENCHMARK_BUFFER_SIZE);
+        });
+
+        long unpack = MEASURE_TIME_US({
+            for (int n = 0; n < count; n++) unpack_memory(encoded, dst, BENCHMARK_BUFFER_SIZE);
+        });
+
+        if (memcmp(src, dst, BENCHMARK_BUFFER_SIZE)) {
+            fprintf(stderr, "ERROR! [%s] round trip failed!\n", _path_name(paths[p]));
+            return EXIT_FAILURE;
+        }
+
+        fprintf(
+            stdout, "[%s] pack: %.2f MB/s (x%.1f)\tunpack: %.2f MB/s (x%.1f)\n", _path_name(paths[p]),
+            _throughput(count, pack), pack > 0 ? reference_pack / (double)pack : 0,
+            _throughput(count, unpack), unpack > 0 ? reference_unpack / (double)unpack : 0
+        );
+    }
+
+    fprintf(stdout, "=============================\n\n\n");
+    hamming_select_path(HAMMING_PATH_AUTO);
+    return EXIT_SUCCESS;
+}